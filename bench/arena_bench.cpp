@@ -0,0 +1,72 @@
+// Per-timestep scratch buffers from dd::span_arena against std::vector temporaries. Each step allocates a few
+// temporaries of n floats, chains element-wise operations through them and reduces the last one, so that small
+// sizes are dominated by allocation and zero-initialization and large sizes by the arithmetic.
+#include "bench.hpp"
+
+#include "dd/span_arena.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t temporaries = 4;
+
+BENCH_NOINLINE float step(dd::span<const float> x, dd::span<float> t0, dd::span<float> t1, dd::span<float> t2,
+                          dd::span<float> t3) {
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    t0[i] = x[i] * 2.0f;
+  }
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    t1[i] = t0[i] + x[i];
+  }
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    t2[i] = t1[i] * t0[i];
+  }
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    t3[i] = t2[i] - t1[i];
+  }
+  float acc = 0;
+  for (float v : t3) {
+    acc += v;
+  }
+  return acc;
+}
+
+BENCH_NOINLINE float step_vector(dd::span<const float> x) {
+  std::vector<float> t0(x.size()), t1(x.size()), t2(x.size()), t3(x.size());
+  return step(x, t0, t1, t2, t3);
+}
+
+BENCH_NOINLINE float step_arena(dd::span_arena &arena, dd::span<const float> x) {
+  dd::arena_scope scope(arena);
+  const dd::span<float> t0 = arena.allocate<float>(x.size(), 64);
+  const dd::span<float> t1 = arena.allocate<float>(x.size(), 64);
+  const dd::span<float> t2 = arena.allocate<float>(x.size(), 64);
+  const dd::span<float> t3 = arena.allocate<float>(x.size(), 64);
+  return step(x, t0, t1, t2, t3);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("arena", argc, argv);
+  dd::span_arena arena(temporaries * ((std::size_t(1) << 16) * sizeof(float) + 64));
+  for (std::size_t n : {std::size_t(16), std::size_t(256), std::size_t(4096), std::size_t(1) << 16}) {
+    const std::vector<float> x(n, 1.5f);
+    const dd::span<const float> xs(x);
+    const std::size_t bytes = (temporaries + 1) * n * sizeof(float);
+    const auto params = [&](const char *impl) {
+      return std::vector<std::pair<std::string, std::string>>{{"n", std::to_string(n)}, {"impl", impl}};
+    };
+    suite.run("step", params("vector"), n, bytes, [&] { bench::do_not_optimize(step_vector(xs)); });
+    suite.run("step", params("arena"), n, bytes, [&] { bench::do_not_optimize(step_arena(arena, xs)); });
+    if (temporaries * (n * sizeof(float) + 64) <= DD_SPAN_THREAD_ARENA_BYTES) {
+      suite.run("step", params("thread_arena"), n, bytes,
+                [&] { bench::do_not_optimize(step_arena(dd::thread_span_arena(), xs)); });
+    }
+  }
+  return suite.print_json() ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+// Minimal benchmark harness shared by the benchmark executables. Results are printed as a JSON document on stdout
+// so that runs can be compared and gated by scripts; human-readable progress goes to stderr.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Keeps a kernel out of line so that each benchmark times the same code regardless of the call site
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace bench {
+
+// Keeps the compiler from discarding a computed value
+template <typename T> inline void do_not_optimize(T const &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : : "memory");
+#endif
+}
+
+struct result {
+  std::string name;
+  std::vector<std::pair<std::string, std::string>> params;
+  std::size_t iterations;
+  double ns_per_iter;
+  double items_per_second;
+  double bytes_per_second;
+};
+
+class suite {
+public:
+  // Options: --filter=<substring> runs matching benchmarks only, --min-time=<seconds> sets the sampling time,
+  // --out=<file> writes the JSON report to a file instead of stdout
+  suite(std::string name, int argc, char **argv) : name_(std::move(name)) {
+    for (int i = 1; i < argc; ++i) {
+      if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+        filter_ = argv[i] + 9;
+      } else if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+        min_time_ = std::atof(argv[i] + 11);
+      } else if (std::strncmp(argv[i], "--out=", 6) == 0) {
+        out_ = argv[i] + 6;
+      }
+    }
+  }
+
+  // Times f() and records the best of several samples. items and bytes are per call of f, used for throughput.
+  template <typename F>
+  void run(const std::string &name, std::vector<std::pair<std::string, std::string>> params, std::size_t items,
+           std::size_t bytes, F &&f) {
+    std::string full = name;
+    for (const auto &p : params) {
+      full += "/" + p.first + ":" + p.second;
+    }
+    if (!filter_.empty() && full.find(filter_) == std::string::npos) {
+      return;
+    }
+    using clock = std::chrono::steady_clock;
+    f(); // warm-up
+    std::size_t iters = 1;
+    double best = 0;
+    for (;;) {
+      const auto t0 = clock::now();
+      for (std::size_t i = 0; i < iters; ++i) {
+        f();
+      }
+      const double elapsed = std::chrono::duration<double>(clock::now() - t0).count();
+      if (elapsed >= min_time_ / samples || iters >= (std::size_t(1) << 30)) {
+        best = elapsed / static_cast<double>(iters);
+        break;
+      }
+      const double target = min_time_ / samples;
+      iters = elapsed <= 0 ? iters * 10 : std::max(iters * 2, static_cast<std::size_t>(iters * target / elapsed));
+    }
+    for (int s = 1; s < samples; ++s) {
+      const auto t0 = clock::now();
+      for (std::size_t i = 0; i < iters; ++i) {
+        f();
+      }
+      best = std::min(best, std::chrono::duration<double>(clock::now() - t0).count() / static_cast<double>(iters));
+    }
+    results_.push_back(result{name, std::move(params), iters, best * 1e9, best > 0 ? items / best : 0,
+                              best > 0 ? bytes / best : 0});
+    std::fprintf(stderr, "%-60s %12.1f ns %10.3f GB/s\n", full.c_str(), best * 1e9,
+                 best > 0 ? bytes / best * 1e-9 : 0);
+  }
+
+  const std::vector<result> &results() const noexcept { return results_; }
+
+  // Writes the report to --out, or to stdout without it; returns false if the file cannot be written
+  bool print_json() const {
+    if (out_.empty()) {
+      print_json(stdout);
+      return true;
+    }
+    std::FILE *out = std::fopen(out_.c_str(), "w");
+    if (out == nullptr) {
+      std::fprintf(stderr, "cannot open %s\n", out_.c_str());
+      return false;
+    }
+    print_json(out);
+    return std::fclose(out) == 0;
+  }
+
+  void print_json(std::FILE *out) const {
+    std::fprintf(out, "{\n  \"suite\": \"%s\",\n  \"benchmarks\": [", name_.c_str());
+    for (std::size_t i = 0; i < results_.size(); ++i) {
+      const result &r = results_[i];
+      std::fprintf(out, "%s\n    {\"name\": \"%s\"", i == 0 ? "" : ",", r.name.c_str());
+      for (const auto &p : r.params) {
+        std::fprintf(out, ", \"%s\": \"%s\"", p.first.c_str(), p.second.c_str());
+      }
+      std::fprintf(out,
+                   ", \"iterations\": %zu, \"ns_per_iter\": %.3f, \"items_per_second\": %.6g, "
+                   "\"bytes_per_second\": %.6g}",
+                   r.iterations, r.ns_per_iter, r.items_per_second, r.bytes_per_second);
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+  }
+
+private:
+  static constexpr int samples = 5;
+  std::string name_;
+  std::string filter_;
+  std::string out_;
+  double min_time_ = 0.5;
+  std::vector<result> results_;
+};
+
+} // namespace bench
@@ -0,0 +1,103 @@
+// Mask filters on packed bits (dd::bit_span) against one bool per element. "count" counts the set flags,
+// "and_count" combines two masks into a third and counts the result, "find" locates the only set flag at the end
+// of the mask. The bit_span rows run once per instruction set.
+#include "bench.hpp"
+
+#include "dd/bit_span.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+BENCH_NOINLINE std::size_t count_bools(dd::span<const bool> s) {
+  std::size_t n = 0;
+  for (bool b : s) {
+    n += b ? 1 : 0;
+  }
+  return n;
+}
+
+BENCH_NOINLINE std::size_t and_count_bools(dd::span<bool> dst, dd::span<const bool> a, dd::span<const bool> b) {
+  for (std::size_t i = 0; i < dst.size(); ++i) {
+    dst[i] = a[i] && b[i];
+  }
+  return count_bools(dst);
+}
+
+BENCH_NOINLINE std::size_t find_bools(dd::span<const bool> s) {
+  for (std::size_t i = 0; i < s.size(); ++i) {
+    if (s[i]) {
+      return i;
+    }
+  }
+  return s.size();
+}
+
+BENCH_NOINLINE std::size_t and_count_bits(dd::bit_span<> dst, dd::bit_span<const std::uint64_t> a,
+                                          dd::bit_span<const std::uint64_t> b, dd::simd_isa isa) {
+  dd::bit_and(dst, a, b, isa);
+  return dst.count(isa);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("bit_span", argc, argv);
+  std::mt19937_64 rng(42);
+  for (std::size_t n : {std::size_t(1) << 12, std::size_t(1) << 20}) {
+    std::vector<std::uint64_t> wa(n / 64), wb(n / 64), wd(n / 64), wsparse(n / 64, 0);
+    for (std::size_t i = 0; i < wa.size(); ++i) {
+      wa[i] = rng();
+      wb[i] = rng();
+    }
+    wsparse.back() = std::uint64_t(1) << 63;
+    const dd::bit_span<const std::uint64_t> a{dd::span<const std::uint64_t>(wa)};
+    const dd::bit_span<const std::uint64_t> b{dd::span<const std::uint64_t>(wb)};
+    const dd::bit_span<const std::uint64_t> sparse{dd::span<const std::uint64_t>(wsparse)};
+    const dd::bit_span<> d{dd::span<std::uint64_t>(wd)};
+
+    std::vector<char> storage(3 * n);
+    bool *ba = reinterpret_cast<bool *>(storage.data());
+    bool *bb = ba + n;
+    bool *bd = bb + n;
+    for (std::size_t i = 0; i < n; ++i) {
+      ba[i] = a.test(i);
+      bb[i] = b.test(i);
+    }
+    const dd::span<const bool> sa(ba, n), sb(bb, n);
+    const dd::span<bool> sd(bd, n);
+
+    const auto params = [&](const std::string &impl) {
+      return std::vector<std::pair<std::string, std::string>>{{"bits", std::to_string(n)}, {"impl", impl}};
+    };
+    suite.run("count", params("bools"), n, n, [&] { bench::do_not_optimize(count_bools(sa)); });
+    suite.run("and_count", params("bools"), n, 3 * n, [&] {
+      bench::do_not_optimize(and_count_bools(sd, sa, sb));
+      bench::clobber_memory();
+    });
+    std::fill(bd, bd + n, false);
+    bd[n - 1] = true;
+    suite.run("find", params("bools"), n, n, [&] { bench::do_not_optimize(find_bools(sd)); });
+
+    for (dd::simd_isa isa : {dd::simd_isa::scalar, dd::simd_isa::sse2, dd::simd_isa::avx2, dd::simd_isa::avx512,
+                             dd::simd_isa::neon}) {
+      if (!dd::simd_supported(isa)) {
+        continue;
+      }
+      const std::string impl = std::string("bit_span/") + dd::simd_isa_name(isa);
+      suite.run("count", params(impl), n, n / 8, [&] { bench::do_not_optimize(a.count(isa)); });
+      suite.run("and_count", params(impl), n, 3 * n / 8, [&] {
+        bench::do_not_optimize(and_count_bits(d, a, b, isa));
+        bench::clobber_memory();
+      });
+      suite.run("find", params(impl), n, n / 8, [&] { bench::do_not_optimize(sparse.find_first_set(isa)); });
+    }
+  }
+  return suite.print_json() ? 0 : 1;
+}
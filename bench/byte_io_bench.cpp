@@ -0,0 +1,141 @@
+// Decoding throughput of dd::byte_reader: fixed-size big-endian records against hand-written memcpy decoding, and
+// batched LEB128 varints against a byte-at-a-time loop for every instruction set the CPU supports. Throughput is
+// reported over the encoded input bytes.
+#include "bench.hpp"
+
+#include "dd/byte_io.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct record {
+  std::uint32_t id;
+  std::uint16_t kind;
+  double value;
+};
+constexpr std::size_t record_bytes = 4 + 2 + 8;
+
+BENCH_NOINLINE double decode_records_memcpy(const unsigned char *p, std::size_t n) {
+  double acc = 0;
+  for (std::size_t i = 0; i < n; ++i, p += record_bytes) {
+    record r;
+    std::uint32_t id;
+    std::uint16_t kind;
+    std::uint64_t bits;
+    std::memcpy(&id, p, 4);
+    std::memcpy(&kind, p + 4, 2);
+    std::memcpy(&bits, p + 6, 8);
+    r.id = dd::detail::byteswap(id);
+    r.kind = dd::detail::byteswap(kind);
+    bits = dd::detail::byteswap(bits);
+    std::memcpy(&r.value, &bits, 8);
+    acc += r.value + r.id + r.kind;
+  }
+  return acc;
+}
+
+BENCH_NOINLINE double decode_records_reader(dd::span<const dd::byte> bytes) {
+  dd::byte_reader r(bytes);
+  double acc = 0;
+  while (r.remaining() >= record_bytes) {
+    record rec;
+    rec.id = r.read<std::uint32_t, dd::endian::big>();
+    rec.kind = r.read<std::uint16_t, dd::endian::big>();
+    rec.value = r.read<double, dd::endian::big>();
+    acc += rec.value + rec.id + rec.kind;
+  }
+  return acc;
+}
+
+// One varint at a time with a bounds check on every byte, the way call sites decode them by hand
+BENCH_NOINLINE std::size_t decode_varints_loop(const unsigned char *p, std::size_t size, std::uint64_t *out) {
+  std::size_t pos = 0, count = 0;
+  while (pos < size) {
+    std::uint64_t v = 0;
+    unsigned shift = 0;
+    for (;;) {
+      if (pos >= size || shift > 63) {
+        return count;
+      }
+      const unsigned char b = p[pos++];
+      v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+      shift += 7;
+      if ((b & 0x80) == 0) {
+        break;
+      }
+    }
+    out[count++] = v;
+  }
+  return count;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("byte_io", argc, argv);
+  std::mt19937_64 rng(7);
+
+  {
+    const std::size_t n = std::size_t(1) << 16;
+    std::vector<dd::byte> buf(n * record_bytes);
+    dd::byte_writer w{dd::span<dd::byte>(buf)};
+    for (std::size_t i = 0; i < n; ++i) {
+      w.write<dd::endian::big>(static_cast<std::uint32_t>(rng()));
+      w.write<dd::endian::big>(static_cast<std::uint16_t>(rng()));
+      w.write<dd::endian::big>(static_cast<double>(rng() % 1000) * 0.5);
+    }
+    const auto params = [&](const char *impl) {
+      return std::vector<std::pair<std::string, std::string>>{{"n", std::to_string(n)}, {"impl", impl}};
+    };
+    const auto *raw = reinterpret_cast<const unsigned char *>(buf.data());
+    suite.run("records", params("memcpy"), n, buf.size(),
+              [&] { bench::do_not_optimize(decode_records_memcpy(raw, n)); });
+    suite.run("records", params("byte_reader"), n, buf.size(),
+              [&] { bench::do_not_optimize(decode_records_reader(dd::span<const dd::byte>(buf))); });
+  }
+
+  std::vector<dd::simd_isa> isas;
+  for (dd::simd_isa isa : {dd::simd_isa::scalar, dd::simd_isa::sse2, dd::simd_isa::avx2, dd::simd_isa::avx512,
+                           dd::simd_isa::neon}) {
+    if (dd::simd_supported(isa)) {
+      isas.push_back(isa);
+    }
+  }
+  // Value distributions: all single-byte, mostly short, a mix of every length, and full 64-bit values
+  const char *shapes[] = {"1byte", "short", "mixed", "u64"};
+  for (int shape = 0; shape < 4; ++shape) {
+    const std::size_t n = std::size_t(1) << 18;
+    std::vector<dd::byte> buf(n * 10);
+    dd::byte_writer w{dd::span<dd::byte>(buf)};
+    for (std::size_t i = 0; i < n; ++i) {
+      const std::uint64_t bits = rng();
+      w.write_varint(shape == 0   ? bits % 128
+                     : shape == 1 ? (bits % 8 == 0 ? bits % 16384 : bits % 128)
+                     : shape == 2 ? bits >> (bits % 64)
+                                  : bits);
+    }
+    const dd::span<const dd::byte> encoded = w.written();
+    std::vector<std::uint64_t> out(n);
+    const auto params = [&](const char *impl) {
+      return std::vector<std::pair<std::string, std::string>>{{"shape", shapes[shape]}, {"impl", impl}};
+    };
+    suite.run("varint", params("loop"), n, encoded.size(), [&] {
+      bench::do_not_optimize(
+          decode_varints_loop(reinterpret_cast<const unsigned char *>(encoded.data()), encoded.size(), out.data()));
+      bench::clobber_memory();
+    });
+    for (dd::simd_isa isa : isas) {
+      suite.run("varint", params(dd::simd_isa_name(isa)), n, encoded.size(), [&] {
+        bench::do_not_optimize(dd::decode_varints(encoded, dd::span<std::uint64_t>(out), isa).count);
+        bench::clobber_memory();
+      });
+    }
+  }
+  return suite.print_json() ? 0 : 1;
+}
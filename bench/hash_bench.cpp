@@ -0,0 +1,60 @@
+// Hashing throughput from 8 B to 1 MiB. "std_hash" is std::hash<std::string> of the same bytes, "hash_bytes" the
+// one-shot dd::hash_bytes and "hasher" a dd::hasher fed 4 KiB at a time; the dd rows run once per instruction set.
+#include "bench.hpp"
+
+#include "dd/hash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+BENCH_NOINLINE std::size_t std_hash(const std::string &s) { return std::hash<std::string>()(s); }
+
+BENCH_NOINLINE std::uint64_t one_shot(dd::span<const dd::byte> s, dd::simd_isa isa) {
+  return dd::hash_bytes(s, 0, isa);
+}
+
+BENCH_NOINLINE std::uint64_t streamed(dd::span<const dd::byte> s, dd::simd_isa isa) {
+  dd::hasher h(0, isa);
+  for (std::size_t pos = 0; pos < s.size(); pos += 4096) {
+    h.update(s.subspan(pos, s.size() - pos < 4096 ? s.size() - pos : 4096));
+  }
+  return h.digest();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("hash", argc, argv);
+  std::mt19937 rng(42);
+  for (std::size_t n : {std::size_t(8), std::size_t(16), std::size_t(32), std::size_t(64), std::size_t(128),
+                        std::size_t(256), std::size_t(1024), std::size_t(4096), std::size_t(64) << 10,
+                        std::size_t(1) << 20}) {
+    std::string text(n, '\0');
+    for (char &c : text) {
+      c = static_cast<char>(rng());
+    }
+    const dd::span<const dd::byte> bytes = dd::as_bytes(dd::span<const char>(text.data(), text.size()));
+
+    const auto params = [&](const std::string &impl) {
+      return std::vector<std::pair<std::string, std::string>>{{"bytes", std::to_string(n)}, {"impl", impl}};
+    };
+    suite.run("hash", params("std_hash"), n, n, [&] { bench::do_not_optimize(std_hash(text)); });
+    for (dd::simd_isa isa : {dd::simd_isa::scalar, dd::simd_isa::sse2, dd::simd_isa::avx2, dd::simd_isa::avx512,
+                             dd::simd_isa::neon}) {
+      if (!dd::simd_supported(isa)) {
+        continue;
+      }
+      const std::string name = dd::simd_isa_name(isa);
+      suite.run("hash", params("hash_bytes/" + name), n, n, [&] { bench::do_not_optimize(one_shot(bytes, isa)); });
+      suite.run("hash", params("hasher/" + name), n, n, [&] { bench::do_not_optimize(streamed(bytes, isa)); });
+    }
+  }
+  return suite.print_json() ? 0 : 1;
+}
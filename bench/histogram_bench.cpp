@@ -0,0 +1,95 @@
+// dd::histogram and dd::scatter_add against every thread adding to the shared bins with relaxed atomics, over bin
+// counts from 16 to 2^20 and from one thread to every hardware thread. Few bins are where shared atomics contend;
+// private copies avoid that until the copies outgrow the input.
+#include "bench.hpp"
+
+#include "dd/atomic_span.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+BENCH_NOINLINE void shared_histogram(dd::thread_pool &pool, dd::span<const std::uint32_t> keys,
+                                     dd::span<std::uint64_t> bins) {
+  const auto counts = dd::as_atomic(bins);
+  const auto parts = dd::tiles(keys, pool.concurrency());
+  pool.run(parts.size(), [&](std::size_t t) {
+    for (std::uint32_t k : parts[t]) {
+      counts[k].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+}
+
+BENCH_NOINLINE void shared_scatter_add(dd::thread_pool &pool, dd::span<const std::uint32_t> idx,
+                                       dd::span<const double> values, dd::span<double> out) {
+  const auto sums = dd::as_atomic(out);
+  const auto parts = dd::tiles(idx, pool.concurrency());
+  pool.run(parts.size(), [&](std::size_t t) {
+    const std::size_t first = static_cast<std::size_t>(parts[t].data() - idx.data());
+    for (std::size_t i = first; i < first + parts[t].size(); ++i) {
+      sums[idx[i]].fetch_add(values[i], std::memory_order_relaxed);
+    }
+  });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("histogram", argc, argv);
+  const std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::size_t> thread_counts;
+  for (std::size_t t = 1; t < hw; t *= 2) {
+    thread_counts.push_back(t);
+  }
+  thread_counts.push_back(hw);
+
+  constexpr std::size_t n = std::size_t(1) << 24;
+  std::mt19937_64 rng(42);
+  std::vector<std::uint32_t> random(n);
+  for (auto &x : random) {
+    x = static_cast<std::uint32_t>(rng());
+  }
+  std::vector<double> values(n, 0.5);
+
+  for (std::size_t bins : {std::size_t(16), std::size_t(256), std::size_t(4096), std::size_t(1) << 16,
+                           std::size_t(1) << 20}) {
+    std::vector<std::uint32_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      keys[i] = random[i] % static_cast<std::uint32_t>(bins);
+    }
+    std::vector<std::uint64_t> counts(bins);
+    std::vector<double> sums(bins);
+    for (std::size_t threads : thread_counts) {
+      dd::thread_pool pool(threads - 1);
+      auto params = [&](const char *variant) {
+        return std::vector<std::pair<std::string, std::string>>{
+            {"variant", variant}, {"bins", std::to_string(bins)}, {"threads", std::to_string(threads)}};
+      };
+      suite.run("histogram", params("shared_atomic"), n, n * sizeof(std::uint32_t), [&] {
+        shared_histogram(pool, keys, counts);
+        bench::clobber_memory();
+      });
+      suite.run("histogram", params("dd"), n, n * sizeof(std::uint32_t), [&] {
+        dd::histogram(pool, dd::span<const std::uint32_t>(keys), dd::span<std::uint64_t>(counts));
+        bench::clobber_memory();
+      });
+      const std::size_t bytes = n * (sizeof(std::uint32_t) + sizeof(double));
+      suite.run("scatter_add", params("shared_atomic"), n, bytes, [&] {
+        shared_scatter_add(pool, keys, values, sums);
+        bench::clobber_memory();
+      });
+      suite.run("scatter_add", params("dd"), n, bytes, [&] {
+        dd::scatter_add(pool, dd::span<const std::uint32_t>(keys), dd::span<const double>(values),
+                        dd::span<double>(sums));
+        bench::clobber_memory();
+      });
+    }
+  }
+  return suite.print_json() ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+// Load-and-scan time of a binary file through dd::mapped_span against reading it into a std::vector, with the page
+// cache dropped before every load (cold) or kept (warm). Cold runs evict the file with posix_fadvise, which only
+// works for clean pages, so the file is synced once after writing it. --size-mb=<n> sets the file size.
+#include "bench.hpp"
+
+#include "dd/mapped_span.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+using element = std::uint32_t;
+
+std::uint64_t checksum(dd::span<const element> s) {
+  std::uint64_t acc = 0;
+  for (element x : s) {
+    acc += x;
+  }
+  return acc;
+}
+
+void drop_cache(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+#ifdef POSIX_FADV_DONTNEED
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    ::close(fd);
+  }
+}
+
+BENCH_NOINLINE std::uint64_t load_vector(const std::string &path) {
+  std::FILE *f = std::fopen(path.c_str(), "rb");
+  if (f == nullptr) {
+    std::abort();
+  }
+  std::fseek(f, 0, SEEK_END);
+  const std::size_t bytes = static_cast<std::size_t>(std::ftell(f));
+  std::fseek(f, 0, SEEK_SET);
+  std::vector<element> v(bytes / sizeof(element));
+  if (std::fread(v.data(), sizeof(element), v.size(), f) != v.size()) {
+    std::abort();
+  }
+  std::fclose(f);
+  return checksum(v);
+}
+
+BENCH_NOINLINE std::uint64_t load_mapped(const std::string &path, const dd::map_advice *advice) {
+  dd::mapped_span<const element> m(path);
+  if (advice != nullptr) {
+    m.advise(*advice);
+  }
+  return checksum(m);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("mapped", argc, argv);
+  std::size_t size_mb = 256;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--size-mb=", 10) == 0) {
+      size_mb = static_cast<std::size_t>(std::atol(argv[i] + 10));
+    }
+  }
+  const std::size_t n = size_mb * (std::size_t(1) << 20) / sizeof(element);
+  const std::size_t bytes = n * sizeof(element);
+
+  char name[] = "/tmp/dd_mapped_bench_XXXXXX";
+  const int fd = ::mkstemp(name);
+  if (fd < 0) {
+    std::perror("mkstemp");
+    return 1;
+  }
+  const std::string path = name;
+  {
+    std::vector<element> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      v[i] = static_cast<element>(i * 2654435761u);
+    }
+    if (::write(fd, v.data(), bytes) != static_cast<ssize_t>(bytes) || ::fsync(fd) != 0) {
+      std::perror("write");
+      ::close(fd);
+      std::remove(name);
+      return 1;
+    }
+    ::close(fd);
+  }
+
+  const std::pair<const char *, dd::map_advice> advices[] = {{"mapped_sequential", dd::map_advice::sequential},
+                                                            {"mapped_willneed", dd::map_advice::willneed},
+                                                            {"mapped_hugepage", dd::map_advice::hugepage}};
+  for (const bool cold : {true, false}) {
+    const auto params = [&](const char *impl) {
+      return std::vector<std::pair<std::string, std::string>>{
+          {"mb", std::to_string(size_mb)}, {"cache", cold ? "cold" : "warm"}, {"impl", impl}};
+    };
+    suite.run("load_sum", params("read_vector"), n, bytes, [&] {
+      if (cold) {
+        drop_cache(path);
+      }
+      bench::do_not_optimize(load_vector(path));
+    });
+    suite.run("load_sum", params("mapped"), n, bytes, [&] {
+      if (cold) {
+        drop_cache(path);
+      }
+      bench::do_not_optimize(load_mapped(path, nullptr));
+    });
+    for (const auto &a : advices) {
+      suite.run("load_sum", params(a.first), n, bytes, [&] {
+        if (cold) {
+          drop_cache(path);
+        }
+        bench::do_not_optimize(load_mapped(path, &a.second));
+      });
+    }
+  }
+
+  std::remove(name);
+  return suite.print_json() ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+// Scaling of the parallel span algorithms from one thread to every hardware thread.
+#include "bench.hpp"
+
+#include "dd/parallel.hpp"
+
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char **argv) {
+  bench::suite suite("parallel", argc, argv);
+
+  const std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::size_t> thread_counts;
+  for (std::size_t t = 1; t < hw; t *= 2) {
+    thread_counts.push_back(t);
+  }
+  thread_counts.push_back(hw);
+
+  for (std::size_t n : {std::size_t(1) << 16, std::size_t(1) << 22, std::size_t(1) << 26}) {
+    std::vector<float> in(n), out(n);
+    std::iota(in.begin(), in.end(), 0.0f);
+    const dd::span<const float> src(in);
+    const dd::span<float> dst(out);
+
+    for (std::size_t threads : thread_counts) {
+      dd::thread_pool pool(threads - 1);
+      const std::vector<std::pair<std::string, std::string>> params = {{"n", std::to_string(n)},
+                                                                        {"threads", std::to_string(threads)}};
+      suite.run("parallel_for", params, n, n * sizeof(float), [&] {
+        dd::parallel_for(pool, dst, [](float &x) { x = std::sqrt(x) * 0.5f + 1.0f; });
+        bench::clobber_memory();
+      });
+      suite.run("parallel_transform", params, n, 2 * n * sizeof(float), [&] {
+        dd::parallel_transform(pool, src, dst, [](float x) { return std::sqrt(x) * 0.5f; });
+        bench::clobber_memory();
+      });
+      suite.run("parallel_reduce", params, n, n * sizeof(float), [&] {
+        bench::do_not_optimize(dd::parallel_reduce(pool, src, 0.0, std::plus<double>()));
+      });
+      suite.run("parallel_inclusive_scan", params, n, 2 * n * sizeof(float), [&] {
+        dd::parallel_inclusive_scan(pool, src, dst, std::plus<float>());
+        bench::clobber_memory();
+      });
+    }
+  }
+
+  return suite.print_json() ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+// Sweep of prefetch distances over working-set sizes, to pick distances per machine. "scan" sums a span in order
+// through dd::prefetched (distance in bytes) and dd::streaming; "gather" sums values[indices[i]] for random indices
+// through dd::gathered (distance in indices). Distance 0 is the plain loop.
+#include "bench.hpp"
+
+#include "dd/prefetch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+BENCH_NOINLINE std::uint64_t scan_plain(dd::span<const std::uint64_t> s) {
+  std::uint64_t acc = 0;
+  for (std::uint64_t x : s) {
+    acc += x;
+  }
+  return acc;
+}
+
+template <typename View> BENCH_NOINLINE std::uint64_t scan_view(const View &view) {
+  std::uint64_t acc = 0;
+  for (std::uint64_t x : view) {
+    acc += x;
+  }
+  return acc;
+}
+
+BENCH_NOINLINE std::uint64_t gather_plain(dd::span<const std::uint64_t> values, dd::span<const std::uint32_t> idx) {
+  std::uint64_t acc = 0;
+  for (std::uint32_t i : idx) {
+    acc += values[i];
+  }
+  return acc;
+}
+
+template <typename View> BENCH_NOINLINE std::uint64_t scan_for_each(const View &view) {
+  std::uint64_t acc = 0;
+  dd::for_each(view, [&](std::uint64_t x) { acc += x; });
+  return acc;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("prefetch", argc, argv);
+  std::mt19937 rng(7);
+  for (std::size_t bytes : {std::size_t(256) << 10, std::size_t(8) << 20, std::size_t(128) << 20}) {
+    const std::size_t n = bytes / sizeof(std::uint64_t);
+    std::vector<std::uint64_t> values(n, 1);
+    const dd::span<const std::uint64_t> s(values);
+    const auto params = [&](const char *impl, std::size_t distance) {
+      return std::vector<std::pair<std::string, std::string>>{
+          {"working_set", std::to_string(bytes)}, {"impl", impl}, {"distance", std::to_string(distance)}};
+    };
+
+    suite.run("scan", params("loop", 0), n, bytes, [&] { bench::do_not_optimize(scan_plain(s)); });
+    for (std::size_t distance : {256, 1024, 4096}) {
+      const std::size_t elements = distance / sizeof(std::uint64_t);
+      suite.run("scan", params("prefetched", distance), n, bytes,
+                [&] { bench::do_not_optimize(scan_view(dd::prefetched(s, elements))); });
+      suite.run("scan", params("streaming", distance), n, bytes,
+                [&] { bench::do_not_optimize(scan_view(dd::streaming(s, elements))); });
+      suite.run("scan", params("prefetched_for_each", distance), n, bytes,
+                [&] { bench::do_not_optimize(scan_for_each(dd::prefetched(s, elements))); });
+      suite.run("scan", params("streaming_for_each", distance), n, bytes,
+                [&] { bench::do_not_optimize(scan_for_each(dd::streaming(s, elements))); });
+    }
+
+    const std::size_t lookups = std::size_t(1) << 20;
+    std::vector<std::uint32_t> idx(lookups);
+    std::uniform_int_distribution<std::uint32_t> pick(0, static_cast<std::uint32_t>(n - 1));
+    for (std::uint32_t &i : idx) {
+      i = pick(rng);
+    }
+    const dd::span<const std::uint32_t> is(idx);
+    const std::size_t gather_bytes = lookups * (sizeof(std::uint32_t) + sizeof(std::uint64_t));
+    suite.run("gather", params("loop", 0), lookups, gather_bytes, [&] { bench::do_not_optimize(gather_plain(s, is)); });
+    for (std::size_t distance : {4, 8, 16, 32, 64}) {
+      suite.run("gather", params("gathered", distance), lookups, gather_bytes,
+                [&] { bench::do_not_optimize(scan_view(dd::gathered(s, is, distance))); });
+    }
+  }
+  return suite.print_json() ? 0 : 1;
+}
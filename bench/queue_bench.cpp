@@ -0,0 +1,134 @@
+// Moving 32-bit messages between threads through dd::spsc_queue and dd::mpmc_queue. "throughput" pushes a fixed
+// number of messages from P producers to C consumers, one element at a time (batch 1: try_push/try_pop) or in
+// reservations of up to 64. "latency" bounces one message between two threads over a pair of queues; the time per
+// item is one round trip. Waiting threads yield, so the numbers stay meaningful with fewer cores than threads.
+#include "bench.hpp"
+
+#include "dd/queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Producers write their share of total messages, consumers drain until all have arrived; returns a checksum
+template <typename Queue>
+BENCH_NOINLINE std::uint64_t transfer(Queue &q, std::size_t producers, std::size_t consumers, std::size_t batch,
+                                      std::size_t total) {
+  std::atomic<std::size_t> remaining{total};
+  std::atomic<std::uint64_t> checksum{0};
+  std::vector<std::thread> threads;
+  for (std::size_t p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      const std::size_t share = total / producers + (p < total % producers ? 1 : 0);
+      std::uint32_t value = 0;
+      for (std::size_t sent = 0; sent < share;) {
+        const auto w = q.reserve(std::min(batch, share - sent));
+        if (w.empty()) {
+          std::this_thread::yield();
+          continue;
+        }
+        for (std::uint32_t &x : w.first) {
+          x = value++;
+        }
+        for (std::uint32_t &x : w.second) {
+          x = value++;
+        }
+        q.commit(w);
+        sent += w.size();
+      }
+    });
+  }
+  for (std::size_t c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      std::uint64_t sum = 0;
+      while (remaining.load(std::memory_order_relaxed) != 0) {
+        const auto r = q.peek(batch);
+        if (r.empty()) {
+          std::this_thread::yield();
+          continue;
+        }
+        for (std::uint32_t x : r.first) {
+          sum += x;
+        }
+        for (std::uint32_t x : r.second) {
+          sum += x;
+        }
+        q.release(r);
+        remaining.fetch_sub(r.size(), std::memory_order_relaxed);
+      }
+      checksum.fetch_add(sum);
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  return checksum.load();
+}
+
+template <typename Queue> BENCH_NOINLINE void ping_pong(Queue &there, Queue &back, std::size_t round_trips) {
+  std::thread echo([&] {
+    std::uint32_t x = 0;
+    for (std::size_t i = 0; i < round_trips; ++i) {
+      while (!there.try_pop(x)) {
+        std::this_thread::yield();
+      }
+      while (!back.try_push(x + 1)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::uint32_t x = 0;
+  for (std::size_t i = 0; i < round_trips; ++i) {
+    while (!there.try_push(x)) {
+      std::this_thread::yield();
+    }
+    while (!back.try_pop(x)) {
+      std::this_thread::yield();
+    }
+  }
+  echo.join();
+  bench::do_not_optimize(x);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("queue", argc, argv);
+  constexpr std::size_t capacity = 4096;
+  constexpr std::size_t messages = std::size_t(1) << 20;
+  const auto params = [](const std::string &impl, std::size_t producers, std::size_t consumers, std::size_t batch) {
+    return std::vector<std::pair<std::string, std::string>>{{"impl", impl},
+                                                            {"producers", std::to_string(producers)},
+                                                            {"consumers", std::to_string(consumers)},
+                                                            {"batch", std::to_string(batch)}};
+  };
+
+  for (std::size_t batch : {std::size_t(1), std::size_t(64)}) {
+    dd::spsc_queue<std::uint32_t> spsc(capacity);
+    suite.run("throughput", params("spsc", 1, 1, batch), messages, messages * 4,
+              [&] { bench::do_not_optimize(transfer(spsc, 1, 1, batch, messages)); });
+    for (std::size_t threads : {std::size_t(1), std::size_t(2), std::size_t(4)}) {
+      dd::mpmc_queue<std::uint32_t> mpmc(capacity);
+      suite.run("throughput", params("mpmc", threads, threads, batch), messages, messages * 4,
+                [&] { bench::do_not_optimize(transfer(mpmc, threads, threads, batch, messages)); });
+    }
+  }
+
+  constexpr std::size_t round_trips = 10000;
+  {
+    dd::spsc_queue<std::uint32_t> there(capacity), back(capacity);
+    suite.run("latency", params("spsc", 1, 1, 1), round_trips, 0, [&] { ping_pong(there, back, round_trips); });
+  }
+  {
+    dd::mpmc_queue<std::uint32_t> there(capacity), back(capacity);
+    suite.run("latency", params("mpmc", 1, 1, 1), round_trips, 0, [&] { ping_pong(there, back, round_trips); });
+  }
+  return suite.print_json() ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+// Streaming blocks of samples through a ring buffer: each step appends one block and removes one block. "modulo"
+// is a hand-written ring that wraps every index with %, "push_pop" moves one element at a time through
+// dd::ring_span, and "segments" uses ring_span::write/read, which copy whole segments. Capacities are a power of
+// two (masking) and one less (compare-and-subtract).
+#include "bench.hpp"
+
+#include "dd/ring_span.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct modulo_ring {
+  float *data;
+  std::size_t capacity;
+  std::size_t head = 0;
+  std::size_t size = 0;
+};
+
+BENCH_NOINLINE void modulo_step(modulo_ring &r, const float *in, float *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    r.data[(r.head + r.size + i) % r.capacity] = in[i];
+  }
+  r.size += n;
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = r.data[(r.head + i) % r.capacity];
+  }
+  r.head = (r.head + n) % r.capacity;
+  r.size -= n;
+}
+
+BENCH_NOINLINE void push_pop_step(dd::ring_span<float> &r, const float *in, float *out, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    r.push_back(in[i]);
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    out[i] = r.front();
+    r.pop_front();
+  }
+}
+
+BENCH_NOINLINE void segments_step(dd::ring_span<float> &r, const float *in, float *out, std::size_t n) {
+  r.write(dd::span<const float>(in, n));
+  r.read(dd::span<float>(out, n));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("ring_span", argc, argv);
+  for (std::size_t capacity : {std::size_t(4096), std::size_t(4095)}) {
+    for (std::size_t block : {std::size_t(64), std::size_t(1000)}) {
+      std::vector<float> storage(capacity), in(block, 1.0f), out(block);
+      const auto params = [&](const std::string &impl) {
+        return std::vector<std::pair<std::string, std::string>>{
+            {"capacity", std::to_string(capacity)}, {"block", std::to_string(block)}, {"impl", impl}};
+      };
+      // Start half full so that blocks regularly straddle the wrap point
+      modulo_ring m{storage.data(), capacity, 0, capacity / 2};
+      suite.run("stream", params("modulo"), block, 2 * block * sizeof(float), [&] {
+        modulo_step(m, in.data(), out.data(), block);
+        bench::clobber_memory();
+      });
+      dd::ring_span<float> r(dd::span<float>(storage), 0, capacity / 2);
+      suite.run("stream", params("push_pop"), block, 2 * block * sizeof(float), [&] {
+        push_pop_step(r, in.data(), out.data(), block);
+        bench::clobber_memory();
+      });
+      suite.run("stream", params("segments"), block, 2 * block * sizeof(float), [&] {
+        segments_step(r, in.data(), out.data(), block);
+        bench::clobber_memory();
+      });
+    }
+  }
+  return suite.print_json() ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+// Vector reductions and searches against the plain loops they replace, for every instruction set the CPU supports.
+#include "bench.hpp"
+
+#include "dd/simd.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+template <typename T> void run_type(bench::suite &suite, const char *type, std::size_t n) {
+  std::vector<T> a(n), b(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    a[i] = static_cast<T>(i % 97);
+    b[i] = static_cast<T>(i % 89);
+  }
+  const dd::span<const T> x(a), y(b);
+  const T absent = static_cast<T>(1000);
+  const std::size_t bytes = n * sizeof(T);
+
+  std::vector<dd::simd_isa> isas;
+  for (dd::simd_isa isa : {dd::simd_isa::scalar, dd::simd_isa::sse2, dd::simd_isa::avx2, dd::simd_isa::avx512,
+                           dd::simd_isa::neon}) {
+    if (dd::simd_supported(isa)) {
+      isas.push_back(isa);
+    }
+  }
+
+  const auto params = [&](const char *impl) {
+    return std::vector<std::pair<std::string, std::string>>{{"type", type}, {"n", std::to_string(n)}, {"impl", impl}};
+  };
+
+  // The loops the kernels replace
+  suite.run("sum", params("loop"), n, bytes, [&] {
+    T acc = T();
+    for (std::size_t i = 0; i < n; ++i) {
+      acc += x[i];
+    }
+    bench::do_not_optimize(acc);
+  });
+  suite.run("dot", params("loop"), n, 2 * bytes, [&] {
+    T acc = T();
+    for (std::size_t i = 0; i < n; ++i) {
+      acc += x[i] * y[i];
+    }
+    bench::do_not_optimize(acc);
+  });
+  suite.run("minmax", params("loop"), n, bytes, [&] {
+    T lo = x[0], hi = x[0];
+    for (std::size_t i = 1; i < n; ++i) {
+      lo = x[i] < lo ? x[i] : lo;
+      hi = hi < x[i] ? x[i] : hi;
+    }
+    bench::do_not_optimize(lo);
+    bench::do_not_optimize(hi);
+  });
+  suite.run("count_if", params("loop"), n, bytes, [&] {
+    std::size_t c = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+      if (x[i] > T(50)) {
+        ++c;
+      }
+    }
+    bench::do_not_optimize(c);
+  });
+  suite.run("find", params("loop"), n, bytes, [&] {
+    std::size_t i = 0;
+    while (i < n && x[i] != absent) {
+      ++i;
+    }
+    bench::do_not_optimize(i);
+  });
+
+  for (dd::simd_isa isa : isas) {
+    const char *name = dd::simd_isa_name(isa);
+    suite.run("sum", params(name), n, bytes, [&] { bench::do_not_optimize(dd::sum(x, isa)); });
+    suite.run("dot", params(name), n, 2 * bytes, [&] { bench::do_not_optimize(dd::dot(x, y, isa)); });
+    suite.run("minmax", params(name), n, bytes, [&] { bench::do_not_optimize(dd::minmax(x, isa)); });
+    suite.run("count_if", params(name), n, bytes,
+              [&] { bench::do_not_optimize(dd::count_if(x, [](T v) { return v > T(50); }, isa)); });
+    suite.run("find", params(name), n, bytes, [&] { bench::do_not_optimize(dd::find(x, absent, isa)); });
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("simd", argc, argv);
+  for (std::size_t n : {std::size_t(1) << 12, std::size_t(1) << 16, std::size_t(1) << 22}) {
+    run_type<float>(suite, "float", n);
+    run_type<double>(suite, "double", n);
+    run_type<std::int32_t>(suite, "int32", n);
+  }
+  return suite.print_json() ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// dd::radix_sort against std::sort for uint32_t, uint64_t and float keys, and dd::radix_sort_by_key against
+// std::sort of key/value pairs, from 1e3 elements up to --max-elements=<n> (default 1e7; 1e9 needs about 24 GB for
+// uint64_t keys, scratch and the pristine input). Every call restores the unsorted input first, so all variants
+// include the same copy. The radix sort runs serially and on the default thread pool.
+#include "bench.hpp"
+
+#include "dd/sort.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+template <typename K> std::vector<K> random_keys(std::size_t n) {
+  std::mt19937_64 rng(42);
+  std::vector<K> v(n);
+  for (auto &x : v) {
+    x = static_cast<K>(rng());
+  }
+  return v;
+}
+template <> std::vector<float> random_keys<float>(std::size_t n) {
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<float> dist(-1e6f, 1e6f);
+  std::vector<float> v(n);
+  for (auto &x : v) {
+    x = dist(rng);
+  }
+  return v;
+}
+
+template <typename K> BENCH_NOINLINE void std_sort(const std::vector<K> &input, std::vector<K> &work) {
+  std::copy(input.begin(), input.end(), work.begin());
+  std::sort(work.begin(), work.end());
+}
+
+template <typename K>
+BENCH_NOINLINE void radix(dd::thread_pool &pool, const std::vector<K> &input, std::vector<K> &work,
+                          std::vector<K> &scratch) {
+  std::copy(input.begin(), input.end(), work.begin());
+  dd::radix_sort(pool, dd::span<K>(work), dd::span<K>(scratch));
+}
+
+BENCH_NOINLINE void std_sort_pairs(const std::vector<std::uint32_t> &input,
+                                   std::vector<std::pair<std::uint32_t, std::uint32_t>> &work) {
+  for (std::size_t i = 0; i < input.size(); ++i) {
+    work[i] = std::make_pair(input[i], static_cast<std::uint32_t>(i));
+  }
+  std::stable_sort(work.begin(), work.end(),
+                   [](const std::pair<std::uint32_t, std::uint32_t> &a,
+                      const std::pair<std::uint32_t, std::uint32_t> &b) { return a.first < b.first; });
+}
+
+BENCH_NOINLINE void radix_by_key(dd::thread_pool &pool, const std::vector<std::uint32_t> &input,
+                                 std::vector<std::uint32_t> &keys, std::vector<std::uint32_t> &values,
+                                 std::vector<std::uint32_t> &key_scratch, std::vector<std::uint32_t> &value_scratch) {
+  std::copy(input.begin(), input.end(), keys.begin());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<std::uint32_t>(i);
+  }
+  dd::radix_sort_by_key(pool, dd::span<std::uint32_t>(keys), dd::span<std::uint32_t>(values),
+                        dd::span<std::uint32_t>(key_scratch), dd::span<std::uint32_t>(value_scratch));
+}
+
+std::vector<std::pair<std::string, std::string>> params(const char *type, const char *algo, std::size_t n) {
+  return {{"type", type}, {"algo", algo}, {"n", std::to_string(n)}};
+}
+
+template <typename K>
+void run_keys(bench::suite &suite, const char *type, std::size_t n, dd::thread_pool &serial,
+              dd::thread_pool &parallel) {
+  const std::vector<K> input = random_keys<K>(n);
+  std::vector<K> work(n), scratch(n);
+  const std::size_t bytes = n * sizeof(K);
+  suite.run("sort", params(type, "std_sort", n), n, bytes, [&] {
+    std_sort(input, work);
+    bench::do_not_optimize(work.data());
+  });
+  suite.run("sort", params(type, "radix", n), n, bytes, [&] {
+    radix(serial, input, work, scratch);
+    bench::do_not_optimize(work.data());
+  });
+  suite.run("sort", params(type, "radix_parallel", n), n, bytes, [&] {
+    radix(parallel, input, work, scratch);
+    bench::do_not_optimize(work.data());
+  });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("sort", argc, argv);
+  std::size_t max_elements = 10000000;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strncmp(argv[i], "--max-elements=", 15) == 0) {
+      max_elements = static_cast<std::size_t>(std::atof(argv[i] + 15));
+    }
+  }
+  dd::thread_pool serial(0);
+  dd::thread_pool &parallel = dd::default_thread_pool();
+
+  for (std::size_t n = 1000; n <= max_elements; n *= 10) {
+    run_keys<std::uint32_t>(suite, "u32", n, serial, parallel);
+    run_keys<std::uint64_t>(suite, "u64", n, serial, parallel);
+    run_keys<float>(suite, "f32", n, serial, parallel);
+
+    const std::vector<std::uint32_t> input = random_keys<std::uint32_t>(n);
+    const std::size_t bytes = n * 2 * sizeof(std::uint32_t);
+    {
+      std::vector<std::pair<std::uint32_t, std::uint32_t>> work(n);
+      suite.run("sort_by_key", params("u32", "std_stable_sort", n), n, bytes, [&] {
+        std_sort_pairs(input, work);
+        bench::do_not_optimize(work.data());
+      });
+    }
+    std::vector<std::uint32_t> keys(n), values(n), key_scratch(n), value_scratch(n);
+    suite.run("sort_by_key", params("u32", "radix", n), n, bytes, [&] {
+      radix_by_key(serial, input, keys, values, key_scratch, value_scratch);
+      bench::do_not_optimize(values.data());
+    });
+    suite.run("sort_by_key", params("u32", "radix_parallel", n), n, bytes, [&] {
+      radix_by_key(parallel, input, keys, values, key_scratch, value_scratch);
+      bench::do_not_optimize(values.data());
+    });
+  }
+  return suite.print_json() ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+// What dd::span costs compared with a raw pointer and size and, under C++20, std::span. Built once per contract
+// mode (see CMakeLists.txt); the mode is reported as the "mode" parameter so that the JSON reports of the
+// different executables can be merged. Integer sums are used so that loops without checks can vectorize.
+#include "bench.hpp"
+
+#include "dd/span.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<span>) && __cplusplus >= 202002L
+#include <span>
+#endif
+#endif
+
+#ifndef DD_SPAN_BENCH_CONTRACT_MODE
+#error "DD_SPAN_BENCH_CONTRACT_MODE must name the contract mode"
+#endif
+
+namespace {
+
+using u32 = std::uint32_t;
+
+// Raw pointer and size
+
+BENCH_NOINLINE u32 iterate_sum(const u32 *p, std::size_t n) {
+  u32 acc = 0;
+  for (const u32 *it = p; it != p + n; ++it) {
+    acc += *it;
+  }
+  return acc;
+}
+
+BENCH_NOINLINE u32 index_sum(const u32 *p, std::size_t /*size*/, std::size_t n) {
+  u32 acc = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    acc += p[i];
+  }
+  return acc;
+}
+
+BENCH_NOINLINE u32 window_sum(const u32 *p, std::size_t n, std::size_t width) {
+  u32 acc = 0;
+  for (std::size_t off = 0; off + width <= n; off += width) {
+    for (const u32 *it = p + off; it != p + off + width; ++it) {
+      acc += *it;
+    }
+  }
+  return acc;
+}
+
+BENCH_NOINLINE u32 callee(const u32 *p, std::size_t n) {
+  u32 acc = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    acc += p[i];
+  }
+  return acc;
+}
+
+BENCH_NOINLINE u32 call_sum(const u32 *p, std::size_t n, std::size_t width) {
+  u32 acc = 0;
+  for (std::size_t off = 0; off + width <= n; off += width) {
+    acc += callee(p + off, width);
+  }
+  return acc;
+}
+
+BENCH_NOINLINE u32 checked_gather(const u32 *p, std::size_t n, const u32 *idx, std::size_t count) {
+  u32 acc = 0;
+  for (std::size_t k = 0; k < count; ++k) {
+    const u32 i = idx[k];
+    acc += i < n ? p[i] : 0;
+  }
+  return acc;
+}
+
+// dd::span and std::span share one implementation; the loop bound of index_sum is not derived from the span, so
+// a checked operator[] cannot be hoisted out of the loop
+
+template <typename Span> BENCH_NOINLINE u32 iterate_sum(Span s) {
+  u32 acc = 0;
+  for (u32 v : s) {
+    acc += v;
+  }
+  return acc;
+}
+
+template <typename Span> BENCH_NOINLINE u32 index_sum(Span s, std::size_t n) {
+  u32 acc = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    acc += s[i];
+  }
+  return acc;
+}
+
+template <typename Span> BENCH_NOINLINE u32 window_sum(Span s, std::size_t width) {
+  u32 acc = 0;
+  for (std::size_t off = 0; off + width <= s.size(); off += width) {
+    for (u32 v : s.subspan(off, width)) {
+      acc += v;
+    }
+  }
+  return acc;
+}
+
+template <typename Span> BENCH_NOINLINE u32 callee(Span s) {
+  u32 acc = 0;
+  for (std::size_t i = 0; i < s.size(); ++i) {
+    acc += s[i];
+  }
+  return acc;
+}
+
+template <typename Span> BENCH_NOINLINE u32 call_sum(Span s, std::size_t width) {
+  u32 acc = 0;
+  for (std::size_t off = 0; off + width <= s.size(); off += width) {
+    acc += callee(s.subspan(off, width));
+  }
+  return acc;
+}
+
+// The explicit bounds test repeats the contract of operator[]
+template <typename Span, typename Index> BENCH_NOINLINE u32 checked_gather(Span s, Index idx) {
+  u32 acc = 0;
+  for (u32 i : idx) {
+    const u32 v = s[i];
+    acc += i < s.size() ? v : 0;
+  }
+  return acc;
+}
+
+using params_t = std::vector<std::pair<std::string, std::string>>;
+
+template <typename Span, typename IndexSpan>
+void run_span(bench::suite &suite, const char *impl, std::size_t n, Span s, IndexSpan idx) {
+  const auto params = [&](params_t extra) {
+    extra.insert(extra.begin(), {{"impl", impl}, {"mode", DD_SPAN_BENCH_CONTRACT_MODE}, {"n", std::to_string(n)}});
+    return extra;
+  };
+  const std::size_t bytes = n * sizeof(u32);
+  suite.run("iterate_sum", params({}), n, bytes, [&] { bench::do_not_optimize(iterate_sum(s)); });
+  suite.run("index_sum", params({}), n, bytes, [&] { bench::do_not_optimize(index_sum(s, n)); });
+  for (std::size_t width : {std::size_t(4), std::size_t(64)}) {
+    suite.run("window_sum", params({{"width", std::to_string(width)}}), n, bytes,
+              [&] { bench::do_not_optimize(window_sum(s, width)); });
+    suite.run("call_sum", params({{"width", std::to_string(width)}}), n, bytes,
+              [&] { bench::do_not_optimize(call_sum(s, width)); });
+  }
+  suite.run("checked_gather", params({}), n, 2 * bytes, [&] { bench::do_not_optimize(checked_gather(s, idx)); });
+}
+
+void run_raw(bench::suite &suite, std::size_t n, const u32 *p, const u32 *idx) {
+  const auto params = [&](params_t extra) {
+    extra.insert(extra.begin(), {{"impl", "raw"}, {"mode", DD_SPAN_BENCH_CONTRACT_MODE}, {"n", std::to_string(n)}});
+    return extra;
+  };
+  const std::size_t bytes = n * sizeof(u32);
+  suite.run("iterate_sum", params({}), n, bytes, [&] { bench::do_not_optimize(iterate_sum(p, n)); });
+  suite.run("index_sum", params({}), n, bytes, [&] { bench::do_not_optimize(index_sum(p, n, n)); });
+  for (std::size_t width : {std::size_t(4), std::size_t(64)}) {
+    suite.run("window_sum", params({{"width", std::to_string(width)}}), n, bytes,
+              [&] { bench::do_not_optimize(window_sum(p, n, width)); });
+    suite.run("call_sum", params({{"width", std::to_string(width)}}), n, bytes,
+              [&] { bench::do_not_optimize(call_sum(p, n, width)); });
+  }
+  suite.run("checked_gather", params({}), n, 2 * bytes,
+            [&] { bench::do_not_optimize(checked_gather(p, n, idx, n)); });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("span", argc, argv);
+  for (std::size_t n : {std::size_t(1) << 12, std::size_t(1) << 20}) {
+    std::vector<u32> data(n, 1);
+    std::vector<u32> idx(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      idx[i] = static_cast<u32>((i * 2654435761u) % n);
+    }
+    run_raw(suite, n, data.data(), idx.data());
+    run_span(suite, "dd::span", n, dd::span<const u32>(data), dd::span<const u32>(idx));
+#if defined(__cpp_lib_span)
+    run_span(suite, "std::span", n, std::span<const u32>(data), std::span<const u32>(idx));
+#endif
+  }
+  return suite.print_json() ? 0 : 1;
+}
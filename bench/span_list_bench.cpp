@@ -0,0 +1,81 @@
+// Sending a message made of many separate pieces to a file on tmpfs (/dev/shm, else /tmp), rewritten from offset 0
+// on every iteration. "concat" copies the pieces into one reused buffer and calls write once, "writev" passes a
+// dd::span_list to dd::writev_all, and "write_each" calls write once per piece.
+#include "bench.hpp"
+
+#include "dd/span_list.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+BENCH_NOINLINE std::size_t concat_write(int fd, const std::vector<std::vector<unsigned char>> &pieces,
+                                        std::vector<unsigned char> &scratch) {
+  scratch.clear();
+  for (const auto &p : pieces) {
+    scratch.insert(scratch.end(), p.begin(), p.end());
+  }
+  ::lseek(fd, 0, SEEK_SET);
+  return static_cast<std::size_t>(::write(fd, scratch.data(), scratch.size()));
+}
+
+BENCH_NOINLINE std::size_t vectored_write(int fd, const dd::span_list<> &message) {
+  ::lseek(fd, 0, SEEK_SET);
+  return dd::writev_all(fd, message);
+}
+
+BENCH_NOINLINE std::size_t write_each(int fd, const std::vector<std::vector<unsigned char>> &pieces) {
+  ::lseek(fd, 0, SEEK_SET);
+  std::size_t done = 0;
+  for (const auto &p : pieces) {
+    done += static_cast<std::size_t>(::write(fd, p.data(), p.size()));
+  }
+  return done;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("span_list", argc, argv);
+  const std::string dir = ::access("/dev/shm", W_OK) == 0 ? "/dev/shm" : "/tmp";
+  std::string path = dir + "/dd_span_list_bench_XXXXXX";
+  const int fd = ::mkstemp(&path[0]);
+  if (fd < 0) {
+    std::perror("mkstemp");
+    return 1;
+  }
+
+  const std::pair<std::size_t, std::size_t> shapes[] = {{16, 64}, {16, 4096}, {256, 256}, {64, 65536}};
+  for (const auto &shape : shapes) {
+    const std::size_t count = shape.first, piece = shape.second, total = count * piece;
+    std::vector<std::vector<unsigned char>> pieces(count, std::vector<unsigned char>(piece, 0x5a));
+    dd::span_list<> message;
+    for (const auto &p : pieces) {
+      message.push_back(dd::as_bytes(dd::span<const unsigned char>(p)));
+    }
+    std::vector<unsigned char> scratch;
+    scratch.reserve(total);
+
+    const auto params = [&](const std::string &impl) {
+      return std::vector<std::pair<std::string, std::string>>{
+          {"pieces", std::to_string(count)}, {"piece_bytes", std::to_string(piece)}, {"impl", impl}};
+    };
+    suite.run("send", params("concat"), 1, total,
+              [&] { bench::do_not_optimize(concat_write(fd, pieces, scratch)); });
+    suite.run("send", params("writev"), 1, total, [&] { bench::do_not_optimize(vectored_write(fd, message)); });
+    suite.run("send", params("write_each"), 1, total, [&] { bench::do_not_optimize(write_each(fd, pieces)); });
+  }
+
+  ::close(fd);
+  std::remove(path.c_str());
+  return suite.print_json() ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+// CSR sparse matrix-vector and matrix-matrix products from one thread to every hardware thread. dd::spmv splits the
+// rows by non-zeros; the "rows" variant splits them into equal row counts, as a hand-written parallel loop would.
+// The skewed matrix puts half of its non-zeros in 1% of the rows, where equal row counts leave threads idle.
+#include "bench.hpp"
+
+#include "dd/sparse.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct matrix {
+  std::size_t rows = 0, cols = 0;
+  std::vector<std::int32_t> row_ptr, col_idx;
+  std::vector<double> values;
+
+  dd::csr_view<const double> view() const { return dd::csr_view<const double>(rows, cols, row_ptr, col_idx, values); }
+};
+
+// avg non-zeros per row; with skew, every 100th row is 50x longer
+matrix make_matrix(std::size_t rows, std::size_t avg, bool skewed) {
+  std::mt19937_64 rng(42);
+  matrix m;
+  m.rows = m.cols = rows;
+  m.row_ptr.push_back(0);
+  for (std::size_t r = 0; r < rows; ++r) {
+    const std::size_t len = !skewed ? avg : r % 100 == 0 ? avg * 50 : avg / 2;
+    for (std::size_t n = 0; n < len; ++n) {
+      m.col_idx.push_back(static_cast<std::int32_t>(rng() % rows));
+      m.values.push_back(static_cast<double>(rng() % 1000) * 1e-3);
+    }
+    m.row_ptr.push_back(static_cast<std::int32_t>(m.col_idx.size()));
+  }
+  return m;
+}
+
+BENCH_NOINLINE void spmv_rows(dd::thread_pool &pool, const dd::csr_view<const double> &a, const double *x,
+                              double *y) {
+  const std::size_t parts = dd::detail::parallel_tiles(pool, a.rows());
+  pool.run(parts, [&](std::size_t p) {
+    const std::size_t first = a.rows() * p / parts, last = a.rows() * (p + 1) / parts;
+    for (std::size_t r = first; r < last; ++r) {
+      double acc = 0;
+      for (auto k = a.row_ptr()[r]; k < a.row_ptr()[r + 1]; ++k) {
+        acc += a.values()[k] * x[a.col_idx()[k]];
+      }
+      y[r] = acc;
+    }
+  });
+}
+
+BENCH_NOINLINE void spmv_nnz(dd::thread_pool &pool, const dd::csr_view<const double> &a, dd::span<const double> x,
+                             dd::span<double> y) {
+  dd::spmv(pool, a, x, y);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::suite suite("sparse", argc, argv);
+  const std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::size_t> thread_counts;
+  for (std::size_t t = 1; t < hw; t *= 2) {
+    thread_counts.push_back(t);
+  }
+  thread_counts.push_back(hw);
+
+  constexpr std::size_t rows = std::size_t(1) << 19;
+  constexpr std::size_t avg = 16;
+  constexpr std::size_t k = 8;
+  for (bool skewed : {false, true}) {
+    const matrix m = make_matrix(rows, avg, skewed);
+    const auto a = m.view();
+    std::vector<double> x(rows, 1.0), y(rows);
+    std::vector<double> b(rows * k, 1.0), c(rows * k);
+    const std::size_t bytes = a.nnz() * (sizeof(double) + sizeof(std::int32_t)) + 2 * rows * sizeof(double);
+    for (std::size_t threads : thread_counts) {
+      dd::thread_pool pool(threads - 1);
+      auto params = [&](const char *split) {
+        return std::vector<std::pair<std::string, std::string>>{
+            {"matrix", skewed ? "skewed" : "uniform"}, {"split", split}, {"threads", std::to_string(threads)}};
+      };
+      suite.run("spmv", params("rows"), a.nnz(), bytes, [&] {
+        spmv_rows(pool, a, x.data(), y.data());
+        bench::clobber_memory();
+      });
+      suite.run("spmv", params("nnz"), a.nnz(), bytes, [&] {
+        spmv_nnz(pool, a, dd::span<const double>(x), dd::span<double>(y));
+        bench::clobber_memory();
+      });
+      suite.run("spmm", params("nnz"), a.nnz() * k, bytes + 2 * rows * (k - 1) * sizeof(double), [&] {
+        dd::spmm(pool, a, dd::mdspan<const double, dd::dextents<std::size_t, 2>>(b.data(), rows, k),
+                 dd::mdspan<double, dd::dextents<std::size_t, 2>>(c.data(), rows, k));
+        bench::clobber_memory();
+      });
+    }
+  }
+  return suite.print_json() ? 0 : 1;
+}
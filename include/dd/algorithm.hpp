@@ -0,0 +1,370 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// copy, fill, equal and lexicographical_compare over spans. Trivially copyable elements lower to memcpy, memset and
+// memcmp where that gives the same result; small static extents are unrolled. Sizes are checked once up front.
+// copy(src, dst, copy_hint::streaming) is a host-only copy with non-temporal stores for large buffers that are not
+// read again soon. static_for_each, static_transform and static_reduce expand over static-extent spans into
+// straight-line code, independent of the optimizer's unrolling heuristics.
+
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if !defined(__CUDA_ARCH__) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define DD_SPAN_HAVE_STREAMING_STORES
+#include <emmintrin.h>
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+enum class copy_hint {
+  none,
+  streaming, // non-temporal stores that bypass the caches; for copies much larger than the last-level cache
+};
+
+namespace detail {
+
+// Static extents up to this many elements are unrolled instead of looped over
+DD_SPAN_INLINE_VAR constexpr std::size_t unroll_limit = 16;
+
+template <typename T, typename U>
+struct same_value_type : std::is_same<typename std::remove_cv<T>::type, typename std::remove_cv<U>::type> {};
+
+// Element-wise assignment is a plain byte copy
+template <typename T, typename U>
+struct is_memcpy_copyable
+    : std::integral_constant<bool, same_value_type<T, U>::value && std::is_trivially_copyable<U>::value> {};
+
+// Equality is equality of the object representations: no padding, no NaN or signed zero
+template <typename T, typename U>
+struct is_memcmp_equal
+    : std::integral_constant<bool, same_value_type<T, U>::value &&
+                                       (std::is_integral<typename std::remove_cv<T>::type>::value ||
+                                        std::is_enum<typename std::remove_cv<T>::type>::value ||
+                                        std::is_pointer<typename std::remove_cv<T>::type>::value)> {};
+
+// operator< agrees with memcmp, which compares unsigned bytes
+template <typename T, typename U>
+struct is_memcmp_ordered
+    : std::integral_constant<bool, same_value_type<T, U>::value &&
+                                       (std::is_same<typename std::remove_cv<T>::type, unsigned char>::value ||
+                                        std::is_same<typename std::remove_cv<T>::type, byte>::value)> {};
+
+template <std::size_t E>
+struct is_unrolled : std::integral_constant<bool, E != dynamic_extent && E <= unroll_limit> {};
+
+template <std::size_t E> using unrolled_indices = std::make_index_sequence<is_unrolled<E>::value ? E : 0>;
+
+template <typename T, typename U, std::size_t... I>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 void copy_unrolled(const T *src, U *dst, std::index_sequence<I...>) {
+  (void)src; // unused when the sequence is empty
+  (void)dst;
+  using expand = int[];
+  (void)expand{0, (dst[I] = src[I], 0)...};
+}
+template <typename T, typename U, std::size_t... I>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 void fill_unrolled(T *dst, const U &value, std::index_sequence<I...>) {
+  (void)dst;
+  (void)value;
+  using expand = int[];
+  (void)expand{0, (dst[I] = value, 0)...};
+}
+template <typename T, typename U, std::size_t... I>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 bool equal_unrolled(const T *a, const U *b, std::index_sequence<I...>) {
+  (void)a;
+  (void)b;
+  bool result = true;
+  using expand = int[];
+  (void)expand{0, (result = result && a[I] == b[I], 0)...};
+  return result;
+}
+
+// memcpy for byte-copyable elements, unrolled assignments for small static extents, a loop otherwise
+template <std::size_t E, typename T, typename U>
+DD_SPAN_API void copy_n(const T *src, U *dst, std::size_t n, std::true_type /*memcpy*/) {
+  if (n != 0) {
+    std::memcpy(dst, src, (E == dynamic_extent ? n : E) * sizeof(U));
+  }
+}
+template <std::size_t E, typename T, typename U>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 void copy_n(const T *src, U *dst, std::size_t n, std::false_type) {
+  if (is_unrolled<E>::value) {
+    copy_unrolled(src, dst, unrolled_indices<E>());
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] = src[i];
+    }
+  }
+}
+
+// The byte every byte of value equals, or -1
+template <typename T> DD_SPAN_API int repeated_byte(const T &value) noexcept {
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  for (std::size_t i = 1; i < sizeof(T); ++i) {
+    if (bytes[i] != bytes[0]) {
+      return -1;
+    }
+  }
+  return bytes[0];
+}
+
+// memset when all bytes of the value are equal, e.g. zero
+template <typename T>
+DD_SPAN_API void fill_n(T *dst, std::size_t n, const typename std::remove_cv<T>::type &value, std::true_type) {
+  const int b = n == 0 ? -1 : repeated_byte(value);
+  if (b >= 0) {
+    std::memset(dst, b, n * sizeof(T));
+    return;
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = value;
+  }
+}
+template <typename T>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 void fill_n(T *dst, std::size_t n, const typename std::remove_cv<T>::type &value,
+                                            std::false_type) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = value;
+  }
+}
+
+template <typename T, typename U>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 bool equal_loop(const T *a, const U *b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    if (!(a[i] == b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if defined(DD_SPAN_HAVE_STREAMING_STORES)
+// Non-temporal 16-byte stores to an aligned destination, four per cache line, fenced at the end
+inline void stream_copy_bytes(const unsigned char *src, unsigned char *dst, std::size_t n) noexcept {
+  const std::size_t head = (16 - reinterpret_cast<std::uintptr_t>(dst) % 16) % 16;
+  if (n < head + 64) {
+    std::memcpy(dst, src, n);
+    return;
+  }
+  std::memcpy(dst, src, head);
+  std::size_t i = head;
+  for (; i + 64 <= n; i += 64) {
+    const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 16));
+    const __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 32));
+    const __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i), x0);
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i + 16), x1);
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i + 32), x2);
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i + 48), x3);
+  }
+  for (; i + 16 <= n; i += 16) {
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+  }
+  _mm_sfence();
+  std::memcpy(dst + i, src + i, n - i);
+}
+#endif
+
+} // namespace detail
+
+// Copies src to the front of dst and returns the rest of dst. The spans must not overlap.
+template <typename T, std::size_t E1, typename U, std::size_t E2>
+DD_SPAN_API span<U> copy(span<T, E1> src, span<U, E2> dst) {
+  static_assert(!std::is_const<U>::value, "cannot copy into a span of const elements");
+  static_assert(E1 == dynamic_extent || E2 == dynamic_extent || E1 <= E2, "destination is smaller than the source");
+  DD_SPAN_EXPECT(src.size() <= dst.size());
+  detail::copy_n<E1>(src.data(), dst.data(), src.size(), detail::is_memcpy_copyable<T, U>());
+  return span<U>(dst.data() + src.size(), dst.size() - src.size());
+}
+
+// Host-only. With copy_hint::streaming, byte-copyable elements are written with non-temporal stores where the
+// target has them (SSE2 on x86), so a large copy does not evict the working set; other elements and targets use
+// the plain copy.
+template <typename T, std::size_t E1, typename U, std::size_t E2>
+span<U> copy(span<T, E1> src, span<U, E2> dst, copy_hint hint) {
+#if defined(DD_SPAN_HAVE_STREAMING_STORES)
+  if (hint == copy_hint::streaming && detail::is_memcpy_copyable<T, U>::value) {
+    static_assert(E1 == dynamic_extent || E2 == dynamic_extent || E1 <= E2, "destination is smaller than the source");
+    DD_SPAN_EXPECT(src.size() <= dst.size());
+    detail::stream_copy_bytes(reinterpret_cast<const unsigned char *>(src.data()),
+                              reinterpret_cast<unsigned char *>(dst.data()), src.size_bytes());
+    return span<U>(dst.data() + src.size(), dst.size() - src.size());
+  }
+#else
+  (void)hint;
+#endif
+  return copy(src, dst);
+}
+
+// Assigns value to every element
+template <typename T, std::size_t E>
+DD_SPAN_API void fill(span<T, E> dst, const typename std::remove_cv<T>::type &value) {
+  static_assert(!std::is_const<T>::value, "cannot fill a span of const elements");
+  if (detail::is_unrolled<E>::value) {
+    detail::fill_unrolled(dst.data(), value, detail::unrolled_indices<E>());
+  } else {
+    detail::fill_n(dst.data(), dst.size(), value, std::is_trivially_copyable<T>());
+  }
+}
+
+// Same size and element-wise equal
+template <typename T, std::size_t E1, typename U, std::size_t E2>
+DD_SPAN_API bool equal(span<T, E1> a, span<U, E2> b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  if (detail::is_unrolled<E1>::value) {
+    return detail::equal_unrolled(a.data(), b.data(), detail::unrolled_indices<E1>());
+  }
+#if !defined(__CUDA_ARCH__)
+  if (detail::is_memcmp_equal<T, U>::value) {
+    return a.empty() || std::memcmp(a.data(), b.data(), a.size_bytes()) == 0;
+  }
+#endif
+  return detail::equal_loop(a.data(), b.data(), a.size());
+}
+
+// Whether a orders before b: the first differing element decides, otherwise the shorter span is less
+template <typename T, std::size_t E1, typename U, std::size_t E2>
+DD_SPAN_API bool lexicographical_compare(span<T, E1> a, span<U, E2> b) {
+  const std::size_t n = a.size() < b.size() ? a.size() : b.size();
+#if !defined(__CUDA_ARCH__)
+  if (detail::is_memcmp_ordered<T, U>::value) {
+    const int c = n == 0 ? 0 : std::memcmp(a.data(), b.data(), n);
+    return c < 0 || (c == 0 && a.size() < b.size());
+  }
+#endif
+  for (std::size_t i = 0; i < n; ++i) {
+    if (a[i] < b[i]) {
+      return true;
+    }
+    if (b[i] < a[i]) {
+      return false;
+    }
+  }
+  return a.size() < b.size();
+}
+
+// Straight-line algorithms for static extents
+
+namespace detail {
+
+template <typename T, std::size_t N, typename F, std::size_t... I>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 void static_for_each_impl(span<T, N> s, F &f, std::index_sequence<I...>) {
+  (void)s;
+  (void)f;
+  using expand = int[];
+  (void)expand{0, ((void)f(get<I>(s)), 0)...};
+}
+
+template <typename T, std::size_t N, typename U, typename F, std::size_t... I>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 void static_transform_impl(span<T, N> in, span<U, N> out, F &f,
+                                                           std::index_sequence<I...>) {
+  (void)in;
+  (void)out;
+  (void)f;
+  using expand = int[];
+  (void)expand{0, (get<I>(out) = f(get<I>(in)), 0)...};
+}
+
+template <typename T1, typename T2, std::size_t N, typename U, typename F, std::size_t... I>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 void static_transform_impl(span<T1, N> a, span<T2, N> b, span<U, N> out, F &f,
+                                                           std::index_sequence<I...>) {
+  (void)a;
+  (void)b;
+  (void)out;
+  (void)f;
+  using expand = int[];
+  (void)expand{0, (get<I>(out) = f(get<I>(a), get<I>(b)), 0)...};
+}
+
+// Pairwise fold of the Count elements starting at First: both halves are independent, so the tree has depth
+// log2(Count) instead of a chain of Count dependent operations
+template <std::size_t First, std::size_t Count> struct static_tree {
+  template <typename R, typename T, std::size_t N, typename Op>
+  DD_SPAN_API static DD_SPAN_CONSTEXPR14 R fold(span<T, N> s, Op &op) {
+    return op(static_tree<First, Count / 2>::template fold<R>(s, op),
+              static_tree<First + Count / 2, Count - Count / 2>::template fold<R>(s, op));
+  }
+};
+template <std::size_t First> struct static_tree<First, 1> {
+  template <typename R, typename T, std::size_t N, typename Op>
+  DD_SPAN_API static constexpr R fold(span<T, N> s, Op &) {
+    return static_cast<R>(get<First>(s));
+  }
+};
+
+template <typename R, typename T, typename Op>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 R static_reduce_impl(span<T, 0>, R init, Op &) {
+  return init;
+}
+template <typename R, typename T, std::size_t N, typename Op>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 R static_reduce_impl(span<T, N> s, R init, Op &op) {
+  return op(init, static_tree<0, N>::template fold<R>(s, op));
+}
+
+} // namespace detail
+
+// f(s[0]), ..., f(s[N-1]) in order; returns f like std::for_each
+template <typename T, std::size_t N, typename F>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 F static_for_each(span<T, N> s, F f) {
+  static_assert(N != dynamic_extent, "static_for_each needs a static extent");
+  detail::static_for_each_impl(s, f, std::make_index_sequence<N>());
+  return f;
+}
+
+// out[i] = f(in[i]), or out[i] = f(a[i], b[i])
+template <typename T, std::size_t N, typename U, typename F>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 void static_transform(span<T, N> in, span<U, N> out, F f) {
+  static_assert(N != dynamic_extent, "static_transform needs a static extent");
+  detail::static_transform_impl(in, out, f, std::make_index_sequence<N>());
+}
+template <typename T1, typename T2, std::size_t N, typename U, typename F>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 void static_transform(span<T1, N> a, span<T2, N> b, span<U, N> out, F f) {
+  static_assert(N != dynamic_extent, "static_transform needs a static extent");
+  detail::static_transform_impl(a, b, out, f, std::make_index_sequence<N>());
+}
+
+// init op (the elements combined pairwise). Like std::reduce, op must be associative; the pairwise order gives
+// independent operations for the processor to overlap and is fixed, so results are reproducible.
+template <typename T, std::size_t N, typename R, typename Op>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 R static_reduce(span<T, N> s, R init, Op op) {
+  static_assert(N != dynamic_extent, "static_reduce needs a static extent");
+  return detail::static_reduce_impl(s, init, op);
+}
+template <typename T, std::size_t N, typename R> DD_SPAN_API DD_SPAN_CONSTEXPR14 R static_reduce(span<T, N> s, R init) {
+  return static_reduce(s, init, [](const R &a, const R &b) { return a + b; });
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__cpp_lib_assume_aligned)
+#include <memory>
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+template <typename ElementType, std::size_t Extent = dynamic_extent,
+          std::size_t Align = alignof(typename std::remove_cv<ElementType>::type)>
+class aligned_span;
+
+namespace detail {
+
+template <std::size_t Align, typename T> DD_SPAN_API inline T *assume_aligned(T *ptr) noexcept {
+#if defined(__CUDACC__) || defined(__GNUC__) || defined(__clang__)
+  return static_cast<T *>(__builtin_assume_aligned(ptr, Align));
+#elif defined(__cpp_lib_assume_aligned)
+  return std::assume_aligned<Align>(ptr);
+#else
+  return ptr;
+#endif
+}
+
+template <std::size_t Align, typename T> DD_SPAN_API inline bool is_aligned(T *ptr) noexcept {
+  return reinterpret_cast<std::uintptr_t>(ptr) % Align == 0;
+}
+
+// Tag for building an aligned_span whose alignment is already known to hold
+struct aligned_unchecked_t {};
+
+DD_SPAN_API constexpr bool is_pow2(std::size_t n) noexcept { return n != 0 && (n & (n - 1)) == 0; }
+
+// Alignment left after advancing an Align-aligned pointer by Bytes
+DD_SPAN_API constexpr std::size_t offset_alignment(std::size_t Align, std::size_t Bytes) noexcept {
+  return Bytes == 0 ? Align : ((Bytes & (~Bytes + 1)) < Align ? (Bytes & (~Bytes + 1)) : Align);
+}
+
+} // namespace detail
+
+// aligned_span class: a span whose data pointer is known to be Align-byte aligned
+
+template <typename ElementType, std::size_t Extent, std::size_t Align> class aligned_span {
+  static_assert(detail::is_pow2(Align), "Align must be a power of two");
+  static_assert(Align >= alignof(typename std::remove_cv<ElementType>::type),
+                "Align must be at least the alignment of ElementType");
+  using span_type = span<ElementType, Extent>;
+
+public:
+  using element_type = typename span_type::element_type;
+  using value_type = typename span_type::value_type;
+  using size_type = typename span_type::size_type;
+  using difference_type = typename span_type::difference_type;
+  using pointer = typename span_type::pointer;
+  using const_pointer = typename span_type::const_pointer;
+  using reference = typename span_type::reference;
+  using const_reference = typename span_type::const_reference;
+  using iterator = typename span_type::iterator;
+  using reverse_iterator = typename span_type::reverse_iterator;
+  static constexpr size_type extent = Extent;
+  static constexpr size_type alignment = Align;
+
+  // constructors
+  template <std::size_t E = Extent, typename std::enable_if<(E == dynamic_extent || E <= 0), int>::type = 0>
+  DD_SPAN_API constexpr aligned_span() noexcept {}
+
+  DD_SPAN_API aligned_span(pointer ptr, size_type count) : span_(ptr, count) {
+    DD_SPAN_EXPECT(detail::is_aligned<Align>(ptr));
+  }
+  DD_SPAN_API explicit aligned_span(span_type s) : span_(s) { DD_SPAN_EXPECT(detail::is_aligned<Align>(s.data())); }
+  DD_SPAN_API constexpr aligned_span(span_type s, detail::aligned_unchecked_t) noexcept : span_(s) {}
+  template <typename U, std::size_t N, std::size_t A,
+            typename std::enable_if<std::is_convertible<U (*)[], ElementType (*)[]>::value &&
+                                        (Extent == dynamic_extent || Extent == N) && A >= Align,
+                                    int>::type = 0>
+  DD_SPAN_API constexpr aligned_span(const aligned_span<U, N, A> &other) noexcept
+      : span_(other.as_span()) {}
+
+  DD_SPAN_API constexpr aligned_span(const aligned_span &other) noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR_ASSIGN aligned_span &operator=(const aligned_span &other) noexcept = default;
+  DD_SPAN_API ~aligned_span() noexcept = default;
+
+  // Decays to a plain span, dropping the alignment guarantee
+  template <typename U, std::size_t N,
+            typename std::enable_if<std::is_convertible<ElementType (*)[], U (*)[]>::value &&
+                                        (N == dynamic_extent || N == Extent),
+                                    int>::type = 0>
+  DD_SPAN_API constexpr operator span<U, N>() const noexcept {
+    return span<U, N>(span_);
+  }
+  DD_SPAN_API constexpr span_type as_span() const noexcept { return span_; }
+
+  // subviews: the result keeps whatever alignment the offset preserves
+  template <std::size_t Count> DD_SPAN_API aligned_span<element_type, Count, Align> first() const {
+    return aligned_span<element_type, Count, Align>(span_.template first<Count>(), detail::aligned_unchecked_t{});
+  }
+  template <std::size_t Count,
+            std::size_t A = (Extent == dynamic_extent
+                                 ? alignof(value_type)
+                                 : detail::offset_alignment(Align, (Extent - Count) * sizeof(element_type)))>
+  DD_SPAN_API aligned_span<element_type, Count, A> last() const {
+    return aligned_span<element_type, Count, A>(span_.template last<Count>(), detail::aligned_unchecked_t{});
+  }
+  template <std::size_t Offset, std::size_t Count = dynamic_extent>
+  DD_SPAN_API aligned_span<element_type,
+                           Count != dynamic_extent ? Count
+                                                   : (Extent != dynamic_extent ? Extent - Offset : dynamic_extent),
+                           detail::offset_alignment(Align, Offset * sizeof(element_type))>
+  subspan() const {
+    return {span_.template subspan<Offset, Count>(), detail::aligned_unchecked_t{}};
+  }
+  DD_SPAN_API aligned_span<element_type, dynamic_extent, Align> first(size_type count) const {
+    return {span_.first(count), detail::aligned_unchecked_t{}};
+  }
+  DD_SPAN_API span<element_type, dynamic_extent> last(size_type count) const { return span_.last(count); }
+  DD_SPAN_API span<element_type, dynamic_extent> subspan(size_type off, size_type cnt = dynamic_extent) const {
+    return span_.subspan(off, cnt);
+  }
+
+  // observers
+  DD_SPAN_API constexpr size_type size() const noexcept { return span_.size(); }
+  DD_SPAN_API constexpr size_type size_bytes() const noexcept { return span_.size_bytes(); }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return span_.empty(); }
+
+  // element access
+  DD_SPAN_API reference operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return *(data() + idx);
+  }
+  DD_SPAN_API reference front() const {
+    DD_SPAN_EXPECT(!empty());
+    return *data();
+  }
+  DD_SPAN_API reference back() const {
+    DD_SPAN_EXPECT(!empty());
+    return *(data() + size() - 1);
+  }
+  DD_SPAN_API pointer data() const noexcept { return detail::assume_aligned<Align>(span_.data()); }
+
+  // iterators
+  DD_SPAN_API iterator begin() const noexcept { return data(); }
+  DD_SPAN_API iterator end() const noexcept { return data() + size(); }
+  DD_SPAN_API reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  DD_SPAN_API reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+private:
+  span_type span_;
+};
+
+// free makers
+
+template <std::size_t Align, typename ET, std::size_t E>
+DD_SPAN_API aligned_span<ET, E, Align> make_aligned_span(span<ET, E> s) {
+  return aligned_span<ET, E, Align>(s);
+}
+
+template <std::size_t Align, typename ET, std::size_t E>
+DD_SPAN_API aligned_span<const byte, ((E == dynamic_extent) ? dynamic_extent : sizeof(ET) * E), Align>
+as_bytes(aligned_span<ET, E, Align> s) noexcept {
+  return {as_bytes(s.as_span()), detail::aligned_unchecked_t{}};
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,473 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Atomic access to span elements, and parallel accumulation into spans.
+//
+// atomic_ref<T> performs atomic operations on an ordinary, suitably aligned T, like C++20 std::atomic_ref, and
+// atomic_span<T> hands out one per element. Both work on the host and in device code. MSVC uses the interlocked
+// intrinsics, which are full barriers whatever the memory order. On the device, atomics are device-scoped and relaxed;
+// a __threadfence before the access provides release ordering and one after it acquire ordering, so acq_rel and
+// seq_cst read-modify-write operations are fenced on both sides.
+//
+// histogram and scatter_add (host-only) add many values into a span from a thread_pool without sharing cache lines
+// between threads: while threads x bins is at most the input size, every task counts into a private copy of the
+// bins, and the copies are added to the output at the end. With more bins than that, threads rarely meet on the
+// same bin, so they add to the output directly with relaxed atomics instead of paying for copies they barely use.
+// Output types atomic_ref does not support, such as 16-bit counts, are split into shards of bins instead, one per
+// task, each of which reads the whole input.
+
+#include "aligned_span.hpp"
+#include "chunks.hpp"
+#include "parallel.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if !defined(__CUDA_ARCH__) && !defined(__GNUC__) && !defined(__clang__) && !defined(_MSC_VER)
+#error "dd::atomic_ref needs the GCC/Clang __atomic builtins, the MSVC interlocked intrinsics or CUDA"
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+namespace detail {
+
+// Types atomic_ref supports: arithmetic, 4 or 8 bytes
+template <typename T>
+struct is_atomic_ref_type : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_const<T>::value &&
+                                                             (sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+// Integer of the same size, which compare-and-swap operates on where there is no typed one
+#if defined(__CUDA_ARCH__) || defined(__GNUC__) || defined(__clang__)
+template <typename T>
+using atomic_word = typename std::conditional<sizeof(T) == 4, unsigned int, unsigned long long>::type;
+#else
+template <typename T> using atomic_word = typename std::conditional<sizeof(T) == 4, long, __int64>::type;
+#endif
+
+template <typename To, typename From> DD_SPAN_API inline To atomic_bit_cast(const From &from) noexcept {
+  To to;
+  std::memcpy(&to, &from, sizeof(To));
+  return to;
+}
+
+// A compare-exchange may not fail with release semantics
+DD_SPAN_API constexpr std::memory_order atomic_failure_order(std::memory_order order) noexcept {
+  return order == std::memory_order_acq_rel ? std::memory_order_acquire
+         : order == std::memory_order_release ? std::memory_order_relaxed
+                                              : order;
+}
+
+#if defined(__CUDA_ARCH__)
+// Native device additions return true; other types fall back to compare-and-swap
+__device__ inline bool atomic_device_add(int *p, int v, int &old) { return old = atomicAdd(p, v), true; }
+__device__ inline bool atomic_device_add(unsigned int *p, unsigned int v, unsigned int &old) {
+  return old = atomicAdd(p, v), true;
+}
+__device__ inline bool atomic_device_add(unsigned long long *p, unsigned long long v, unsigned long long &old) {
+  return old = atomicAdd(p, v), true;
+}
+__device__ inline bool atomic_device_add(float *p, float v, float &old) { return old = atomicAdd(p, v), true; }
+#if __CUDA_ARCH__ >= 600
+__device__ inline bool atomic_device_add(double *p, double v, double &old) { return old = atomicAdd(p, v), true; }
+#endif
+template <typename T> __device__ inline bool atomic_device_add(T *, T, T &) { return false; }
+
+// Device atomics are relaxed; a fence before the access makes it a release and a fence after it an acquire
+__device__ inline void atomic_device_fence_before(std::memory_order order) {
+  if (order == std::memory_order_release || order == std::memory_order_acq_rel ||
+      order == std::memory_order_seq_cst) {
+    __threadfence();
+  }
+}
+__device__ inline void atomic_device_fence_after(std::memory_order order) {
+  if (order == std::memory_order_consume || order == std::memory_order_acquire ||
+      order == std::memory_order_acq_rel || order == std::memory_order_seq_cst) {
+    __threadfence();
+  }
+}
+
+__device__ inline unsigned int atomic_word_cas(unsigned int *p, unsigned int expected, unsigned int desired) {
+  return atomicCAS(p, expected, desired);
+}
+__device__ inline unsigned long long atomic_word_cas(unsigned long long *p, unsigned long long expected,
+                                                     unsigned long long desired) {
+  return atomicCAS(p, expected, desired);
+}
+#elif defined(_MSC_VER) && !defined(__clang__)
+// The interlocked intrinsics are full barriers, at least as strong as any memory order
+inline long atomic_word_cas(long *p, long expected, long desired) {
+  return _InterlockedCompareExchange(p, desired, expected);
+}
+inline __int64 atomic_word_cas(__int64 *p, __int64 expected, __int64 desired) {
+  return _InterlockedCompareExchange64(p, desired, expected);
+}
+
+// Native additions return true; other types fall back to compare-and-swap
+inline bool atomic_msvc_add(long *p, long v, long &old) { return old = _InterlockedExchangeAdd(p, v), true; }
+#if defined(_M_X64) || defined(_M_ARM64)
+inline bool atomic_msvc_add(__int64 *p, __int64 v, __int64 &old) {
+  return old = _InterlockedExchangeAdd64(p, v), true;
+}
+#endif
+template <typename W> inline bool atomic_msvc_add(W *, W, W &) { return false; }
+#endif
+
+} // namespace detail
+
+// Atomic operations on an object that is not itself a std::atomic. T is an arithmetic type of 4 or 8 bytes, aligned
+// to its size; fetch_add and fetch_sub on floating-point types use compare-and-swap loops where the hardware has no
+// atomic addition.
+template <typename T> class atomic_ref {
+  static_assert(detail::is_atomic_ref_type<T>::value, "atomic_ref needs a mutable 4- or 8-byte arithmetic type");
+
+public:
+  using value_type = T;
+  static constexpr std::size_t required_alignment = sizeof(T);
+
+  DD_SPAN_API explicit atomic_ref(T &obj) : ptr_(&obj) {
+    DD_SPAN_EXPECT(detail::is_aligned<required_alignment>(ptr_));
+  }
+  DD_SPAN_API atomic_ref(const atomic_ref &) noexcept = default;
+  atomic_ref &operator=(const atomic_ref &) = delete;
+
+  DD_SPAN_API T load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+#if defined(__CUDA_ARCH__)
+    const T v = *static_cast<volatile const T *>(ptr_);
+    detail::atomic_device_fence_after(order);
+    return v;
+#elif defined(__GNUC__) || defined(__clang__)
+    T v;
+    __atomic_load(ptr_, &v, static_cast<int>(order));
+    return v;
+#else
+    // Exchanging zero for zero reads the value with a full barrier and leaves it unchanged
+    (void)order;
+    return cas(T(0), T(0));
+#endif
+  }
+
+  DD_SPAN_API void store(T desired, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+#if defined(__CUDA_ARCH__)
+    detail::atomic_device_fence_before(order);
+    *static_cast<volatile T *>(ptr_) = desired;
+#elif defined(__GNUC__) || defined(__clang__)
+    __atomic_store(ptr_, &desired, static_cast<int>(order));
+#else
+    exchange(desired, order);
+#endif
+  }
+
+  DD_SPAN_API T exchange(T desired, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+#if defined(__CUDA_ARCH__)
+    using word = detail::atomic_word<T>;
+    detail::atomic_device_fence_before(order);
+    const T old = detail::atomic_bit_cast<T>(
+        atomicExch(reinterpret_cast<word *>(ptr_), detail::atomic_bit_cast<word>(desired)));
+    detail::atomic_device_fence_after(order);
+    return old;
+#elif defined(__GNUC__) || defined(__clang__)
+    T old;
+    __atomic_exchange(ptr_, &desired, &old, static_cast<int>(order));
+    return old;
+#else
+    (void)order;
+    T expected = load();
+    for (;;) {
+      const T seen = cas(expected, desired);
+      if (same_bits(seen, expected)) {
+        return seen;
+      }
+      expected = seen;
+    }
+#endif
+  }
+
+  // Compares bit patterns, so it also succeeds on a NaN that equals expected bit for bit
+  DD_SPAN_API bool compare_exchange_strong(T &expected, T desired,
+                                           std::memory_order order = std::memory_order_seq_cst) const noexcept {
+#if !defined(__CUDA_ARCH__) && (defined(__GNUC__) || defined(__clang__))
+    return __atomic_compare_exchange(ptr_, &expected, &desired, false, static_cast<int>(order),
+                                     static_cast<int>(detail::atomic_failure_order(order)));
+#else
+#if defined(__CUDA_ARCH__)
+    detail::atomic_device_fence_before(order);
+    const T seen = cas(expected, desired);
+    detail::atomic_device_fence_after(order);
+#else
+    (void)order;
+    const T seen = cas(expected, desired);
+#endif
+    const bool success = same_bits(seen, expected);
+    expected = seen;
+    return success;
+#endif
+  }
+  DD_SPAN_API bool compare_exchange_weak(T &expected, T desired,
+                                         std::memory_order order = std::memory_order_seq_cst) const noexcept {
+#if !defined(__CUDA_ARCH__) && (defined(__GNUC__) || defined(__clang__))
+    return __atomic_compare_exchange(ptr_, &expected, &desired, true, static_cast<int>(order),
+                                     static_cast<int>(detail::atomic_failure_order(order)));
+#else
+    return compare_exchange_strong(expected, desired, order);
+#endif
+  }
+
+  DD_SPAN_API T fetch_add(T arg, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    return add(arg, order);
+  }
+  DD_SPAN_API T fetch_sub(T arg, std::memory_order order = std::memory_order_seq_cst) const noexcept {
+    return add(negate(arg, std::is_integral<T>()), order);
+  }
+
+  DD_SPAN_API operator T() const noexcept { return load(); }
+  DD_SPAN_API T operator=(T desired) const noexcept {
+    store(desired);
+    return desired;
+  }
+  DD_SPAN_API T operator+=(T arg) const noexcept { return static_cast<T>(fetch_add(arg) + arg); }
+  DD_SPAN_API T operator-=(T arg) const noexcept { return static_cast<T>(fetch_sub(arg) - arg); }
+
+  DD_SPAN_API T *address() const noexcept { return ptr_; }
+
+private:
+  // Integers negate through their unsigned type, which wraps instead of overflowing
+  DD_SPAN_API static T negate(T arg, std::true_type /*integral*/) noexcept {
+    using unsigned_type = typename std::make_unsigned<T>::type;
+    return static_cast<T>(unsigned_type(0) - static_cast<unsigned_type>(arg));
+  }
+  DD_SPAN_API static T negate(T arg, std::false_type) noexcept { return -arg; }
+
+  DD_SPAN_API T add(T arg, std::memory_order order) const noexcept {
+#if defined(__CUDA_ARCH__)
+    detail::atomic_device_fence_before(order);
+    T old;
+    if (!detail::atomic_device_add(ptr_, arg, old)) {
+      old = add_cas(arg, std::memory_order_relaxed);
+    }
+    detail::atomic_device_fence_after(order);
+    return old;
+#elif defined(__GNUC__) || defined(__clang__)
+    return add_native(arg, order, std::is_integral<T>());
+#else
+    (void)order;
+    return add_native(arg, std::is_integral<T>());
+#endif
+  }
+#if !defined(__CUDA_ARCH__) && (defined(__GNUC__) || defined(__clang__))
+  T add_native(T arg, std::memory_order order, std::true_type /*integral*/) const noexcept {
+    return __atomic_fetch_add(ptr_, arg, static_cast<int>(order));
+  }
+  T add_native(T arg, std::memory_order order, std::false_type) const noexcept { return add_cas(arg, order); }
+#elif !defined(__CUDA_ARCH__)
+  T add_native(T arg, std::true_type /*integral*/) const noexcept {
+    using word = detail::atomic_word<T>;
+    word old;
+    if (detail::atomic_msvc_add(reinterpret_cast<word *>(ptr_), detail::atomic_bit_cast<word>(arg), old)) {
+      return detail::atomic_bit_cast<T>(old);
+    }
+    return add_cas(arg, std::memory_order_seq_cst);
+  }
+  T add_native(T arg, std::false_type) const noexcept { return add_cas(arg, std::memory_order_seq_cst); }
+#endif
+#if defined(__CUDA_ARCH__) || !(defined(__GNUC__) || defined(__clang__))
+  // Replaces the value with desired if its bits equal expected's; returns the previous value either way
+  DD_SPAN_API T cas(T expected, T desired) const noexcept {
+    using word = detail::atomic_word<T>;
+    return detail::atomic_bit_cast<T>(detail::atomic_word_cas(reinterpret_cast<word *>(ptr_),
+                                                              detail::atomic_bit_cast<word>(expected),
+                                                              detail::atomic_bit_cast<word>(desired)));
+  }
+  DD_SPAN_API static bool same_bits(T a, T b) noexcept {
+    using word = detail::atomic_word<T>;
+    return detail::atomic_bit_cast<word>(a) == detail::atomic_bit_cast<word>(b);
+  }
+#endif
+  DD_SPAN_API T add_cas(T arg, std::memory_order order) const noexcept {
+    T expected = load(std::memory_order_relaxed);
+    while (!compare_exchange_weak(expected, static_cast<T>(expected + arg), order)) {
+    }
+    return expected;
+  }
+
+  T *ptr_;
+};
+
+// A span whose elements are accessed through atomic_ref
+template <typename T> class atomic_span {
+public:
+  using element_type = T;
+  using value_type = T;
+  using reference = atomic_ref<T>;
+  using size_type = std::size_t;
+
+  DD_SPAN_API constexpr atomic_span() noexcept = default;
+  DD_SPAN_API explicit atomic_span(span<T> s) : span_(s) {
+    DD_SPAN_EXPECT(detail::is_aligned<atomic_ref<T>::required_alignment>(s.data()));
+  }
+
+  DD_SPAN_API constexpr size_type size() const noexcept { return span_.size(); }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return span_.empty(); }
+  DD_SPAN_API constexpr T *data() const noexcept { return span_.data(); }
+  // Plain access, for phases in which no other thread touches the elements
+  DD_SPAN_API constexpr span<T> as_span() const noexcept { return span_; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return reference(span_.data()[idx]);
+  }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 atomic_span first(size_type count) const {
+    return atomic_span(span_.first(count));
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 atomic_span last(size_type count) const { return atomic_span(span_.last(count)); }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 atomic_span subspan(size_type offset, size_type count = dynamic_extent) const {
+    return atomic_span(span_.subspan(offset, count));
+  }
+
+private:
+  span<T> span_;
+};
+
+template <typename T, std::size_t E> DD_SPAN_API atomic_span<T> as_atomic(span<T, E> s) {
+  return atomic_span<T>(span<T>(s));
+}
+
+namespace detail {
+
+// Many bins, which atomic_ref supports: tasks take slices of the input and add to out with relaxed atomics
+template <typename T, typename Index, typename Value>
+void accumulate_shared(thread_pool &pool, std::size_t n, std::size_t parts, span<T> out, Index index, Value value,
+                       std::true_type /*atomic*/) {
+  pool.run(parts, [&](std::size_t p) {
+    const std::size_t first = n / parts * p + n % parts * p / parts;
+    const std::size_t last = n / parts * (p + 1) + n % parts * (p + 1) / parts;
+    for (std::size_t i = first; i < last; ++i) {
+      atomic_ref<T>(out[index(i)]).fetch_add(value(i), std::memory_order_relaxed);
+    }
+  });
+}
+// Many bins of a type without atomics: tasks own contiguous shards of the bins and each reads the whole input
+template <typename T, typename Index, typename Value>
+void accumulate_shared(thread_pool &pool, std::size_t n, std::size_t parts, span<T> out, Index index, Value value,
+                       std::false_type) {
+  const auto shards = tiles(out, parts);
+  pool.run(parts, [&](std::size_t p) {
+    const std::size_t first = static_cast<std::size_t>(shards[p].data() - out.data());
+    const std::size_t last = first + shards[p].size();
+    for (std::size_t i = 0; i < n; ++i) {
+      const std::size_t b = index(i);
+      DD_SPAN_EXPECT(b < out.size());
+      if (b >= first && b < last) {
+        out.data()[b] += value(i);
+      }
+    }
+  });
+}
+
+// out[index(i)] += value(i) for i in [0, n). Each task privatizes the output while tasks x out.size() <= n;
+// otherwise see accumulate_shared. Private copies are reduced in task order.
+template <typename T, typename Index, typename Value>
+void accumulate_into(thread_pool &pool, std::size_t n, span<T> out, Index index, Value value) {
+  const std::size_t bins = out.size();
+  std::size_t parts = parallel_tiles(pool, n);
+  parts = parts < pool.concurrency() ? parts : pool.concurrency();
+  if (parts <= 1) {
+    for (std::size_t i = 0; i < n; ++i) {
+      out[index(i)] += value(i);
+    }
+    return;
+  }
+  if (parts * bins > n) {
+    accumulate_shared(pool, n, parts, out, index, value, is_atomic_ref_type<T>());
+    return;
+  }
+  const auto slice = [n, parts](std::size_t p) { return n / parts * p + n % parts * p / parts; };
+  std::vector<T> local(parts * bins, T());
+  pool.run(parts, [&](std::size_t p) {
+    T *mine = local.data() + p * bins;
+    for (std::size_t i = slice(p), end = slice(p + 1); i < end; ++i) {
+      const std::size_t b = index(i);
+      DD_SPAN_EXPECT(b < bins);
+      mine[b] += value(i);
+    }
+  });
+  const auto ranges = tiles(out, parallel_tiles(pool, bins));
+  pool.run(ranges.size(), [&](std::size_t t) {
+    const std::size_t first = static_cast<std::size_t>(ranges[t].data() - out.data());
+    for (std::size_t b = first; b < first + ranges[t].size(); ++b) {
+      T sum = out[b];
+      for (std::size_t p = 0; p < parts; ++p) {
+        sum += local[p * bins + b];
+      }
+      out[b] = sum;
+    }
+  });
+}
+
+} // namespace detail
+
+// bins[keys[i]] += 1 for every key; keys are bin indices below bins.size(). Counts are added to what bins holds.
+template <typename K, std::size_t E1, typename Count, std::size_t E2>
+void histogram(thread_pool &pool, span<K, E1> keys, span<Count, E2> bins) {
+  static_assert(std::is_integral<typename std::remove_cv<K>::type>::value, "histogram keys are bin indices");
+  static_assert(!std::is_const<Count>::value, "cannot count into a span of const elements");
+  const K *k = keys.data();
+  detail::accumulate_into(
+      pool, keys.size(), span<Count>(bins), [k](std::size_t i) { return static_cast<std::size_t>(k[i]); },
+      [](std::size_t) { return Count(1); });
+}
+template <typename K, std::size_t E1, typename Count, std::size_t E2>
+void histogram(span<K, E1> keys, span<Count, E2> bins) {
+  histogram(default_thread_pool(), keys, bins);
+}
+
+// out[indices[i]] += values[i] for every i
+template <typename I, std::size_t E1, typename V, std::size_t E2, typename T, std::size_t E3>
+void scatter_add(thread_pool &pool, span<I, E1> indices, span<V, E2> values, span<T, E3> out) {
+  static_assert(std::is_integral<typename std::remove_cv<I>::type>::value, "scatter indices must be integers");
+  static_assert(!std::is_const<T>::value, "cannot add into a span of const elements");
+  DD_SPAN_EXPECT(indices.size() == values.size());
+  const I *idx = indices.data();
+  const V *val = values.data();
+  detail::accumulate_into(
+      pool, indices.size(), span<T>(out), [idx](std::size_t i) { return static_cast<std::size_t>(idx[i]); },
+      [val](std::size_t i) { return static_cast<T>(val[i]); });
+}
+template <typename I, std::size_t E1, typename V, std::size_t E2, typename T, std::size_t E3>
+void scatter_add(span<I, E1> indices, span<V, E2> values, span<T, E3> out) {
+  scatter_add(default_thread_pool(), indices, values, out);
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
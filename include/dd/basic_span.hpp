@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "span.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+template <typename ElementType, std::size_t Extent, typename IndexType> class basic_span;
+
+// A span whose size and indices use a narrower integer, e.g. 32 bits for device kernels
+template <typename ElementType, std::size_t Extent = dynamic_extent>
+using compact_span = basic_span<ElementType, Extent, std::uint32_t>;
+
+namespace detail {
+
+template <typename IndexType> DD_SPAN_API constexpr std::size_t index_max() noexcept {
+  return static_cast<std::size_t>(static_cast<typename std::make_unsigned<IndexType>::type>(-1) >>
+                                  (std::is_signed<IndexType>::value ? 1 : 0));
+}
+
+template <typename IndexType> DD_SPAN_API constexpr bool index_nonnegative(IndexType idx, std::true_type) noexcept {
+  return idx >= 0;
+}
+template <typename IndexType> DD_SPAN_API constexpr bool index_nonnegative(IndexType, std::false_type) noexcept {
+  return true;
+}
+template <typename IndexType> DD_SPAN_API constexpr bool index_nonnegative(IndexType idx) noexcept {
+  return index_nonnegative(idx, std::is_signed<IndexType>());
+}
+
+// Tag for building a basic_span from a size that is already known to fit
+struct basic_span_unchecked_t {};
+
+template <typename E, std::size_t S, typename IndexType> struct basic_span_storage {
+  DD_SPAN_API constexpr basic_span_storage() noexcept = default;
+  DD_SPAN_API constexpr basic_span_storage(E *p_ptr, IndexType /*unused*/) noexcept : ptr(p_ptr) {}
+  E *ptr = nullptr;
+  static constexpr IndexType size = static_cast<IndexType>(S);
+};
+
+template <typename E, typename IndexType> struct basic_span_storage<E, dynamic_extent, IndexType> {
+  DD_SPAN_API constexpr basic_span_storage() noexcept = default;
+  DD_SPAN_API constexpr basic_span_storage(E *p_ptr, IndexType p_size) noexcept : ptr(p_ptr), size(p_size) {}
+  E *ptr = nullptr;
+  IndexType size = 0;
+};
+
+} // namespace detail
+
+// basic_span class: a span with a configurable size_type. Building one from a wider size (a pointer and count,
+// a dd::span or a container) checks that the size fits; static extents are checked at compile time. Note that
+// a pointer and a 32-bit size still occupy 16 bytes on 64-bit targets because of padding; the gain is index
+// arithmetic in IndexType, which is cheaper on GPUs.
+
+template <typename ElementType, std::size_t Extent, typename IndexType> class basic_span {
+  static_assert(std::is_integral<IndexType>::value && !std::is_same<IndexType, bool>::value,
+                "IndexType must be an integer type");
+  static_assert(Extent == dynamic_extent || Extent <= detail::index_max<IndexType>(),
+                "Extent does not fit in IndexType");
+  using storage_type = detail::basic_span_storage<ElementType, Extent, IndexType>;
+  using span_type = span<ElementType, Extent>;
+  using dynamic_type = basic_span<ElementType, dynamic_extent, IndexType>;
+
+public:
+  using element_type = ElementType;
+  using value_type = typename std::remove_cv<ElementType>::type;
+  using index_type = IndexType;
+  using size_type = IndexType;
+  using difference_type = typename std::make_signed<IndexType>::type;
+  using pointer = element_type *;
+  using const_pointer = const element_type *;
+  using reference = element_type &;
+  using const_reference = const element_type &;
+  using iterator = pointer;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  static constexpr std::size_t extent = Extent;
+
+  // constructors
+  template <std::size_t E = Extent, typename std::enable_if<(E == dynamic_extent || E == 0), int>::type = 0>
+  DD_SPAN_API constexpr basic_span() noexcept {}
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 basic_span(pointer ptr, std::size_t count)
+      : storage_(ptr, static_cast<IndexType>(count)) {
+    DD_SPAN_EXPECT(count <= detail::index_max<IndexType>());
+    DD_SPAN_EXPECT(extent == dynamic_extent || count == extent);
+  }
+  template <typename U, std::size_t N,
+            typename std::enable_if<std::is_convertible<U (*)[], ElementType (*)[]>::value &&
+                                        (Extent == dynamic_extent || Extent == N),
+                                    int>::type = 0>
+  DD_SPAN_API constexpr basic_span(const basic_span<U, N, IndexType> &other) noexcept
+      : storage_(other.data(), other.size()) {}
+
+  // Narrowing from dd::span: checked at run time for dynamic extents, hence explicit
+  template <typename U, std::size_t N,
+            typename std::enable_if<std::is_convertible<U (*)[], ElementType (*)[]>::value &&
+                                        (Extent == dynamic_extent || Extent == N),
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit basic_span(const span<U, N> &other)
+      : basic_span(other.data(), other.size()) {}
+
+  template <std::size_t N, std::size_t E = Extent,
+            typename std::enable_if<(E == dynamic_extent || N == E) && N <= detail::index_max<IndexType>(),
+                                    int>::type = 0>
+  DD_SPAN_API constexpr basic_span(element_type (&arr)[N]) noexcept : storage_(arr, static_cast<IndexType>(N)) {}
+  template <typename T, std::size_t N, std::size_t E = Extent,
+            typename std::enable_if<(E == dynamic_extent || N == E) && N <= detail::index_max<IndexType>() &&
+                                        std::is_convertible<T (*)[], ElementType (*)[]>::value,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_ARRAY_CONSTEXPR basic_span(std::array<T, N> &arr) noexcept
+      : storage_(arr.data(), static_cast<IndexType>(N)) {}
+  template <typename T, std::size_t N, std::size_t E = Extent,
+            typename std::enable_if<(E == dynamic_extent || N == E) && N <= detail::index_max<IndexType>() &&
+                                        std::is_convertible<const T (*)[], ElementType (*)[]>::value,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_ARRAY_CONSTEXPR basic_span(const std::array<T, N> &arr) noexcept
+      : storage_(arr.data(), static_cast<IndexType>(N)) {}
+
+  template <typename Container, std::size_t E = Extent,
+            typename std::enable_if<E == dynamic_extent && detail::is_container<Container>::value &&
+                                        detail::is_container_element_type_compatible<Container &, ElementType>::value,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit basic_span(Container &cont)
+      : basic_span(detail::data(cont), detail::size(cont)) {}
+  template <
+      typename Container, std::size_t E = Extent,
+      typename std::enable_if<E == dynamic_extent && detail::is_container<Container>::value &&
+                                  detail::is_container_element_type_compatible<const Container &, ElementType>::value,
+                              int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit basic_span(const Container &cont)
+      : basic_span(detail::data(cont), detail::size(cont)) {}
+
+  // Widening back to dd::span never fails; dynamic-extent spans pick basic_span up through their container
+  // constructor, so only fixed-extent targets need a conversion of their own
+  template <typename U, std::size_t N,
+            typename std::enable_if<std::is_convertible<ElementType (*)[], U (*)[]>::value &&
+                                        N != dynamic_extent && N == Extent,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 operator span<U, N>() const {
+    return span<U, N>(data(), static_cast<std::size_t>(size()));
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 span_type as_span() const {
+    return span_type(data(), static_cast<std::size_t>(size()));
+  }
+
+  // subviews
+  template <std::size_t Count>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 basic_span<element_type, Count, IndexType> first() const {
+    DD_SPAN_EXPECT(Count <= static_cast<std::size_t>(size()));
+    return {data(), Count};
+  }
+  template <std::size_t Count>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 basic_span<element_type, Count, IndexType> last() const {
+    DD_SPAN_EXPECT(Count <= static_cast<std::size_t>(size()));
+    return {data() + (size() - static_cast<IndexType>(Count)), Count};
+  }
+  template <std::size_t Offset, std::size_t Count = dynamic_extent>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 basic_span<
+      element_type,
+      (Count != dynamic_extent ? Count : (Extent != dynamic_extent ? Extent - Offset : dynamic_extent)), IndexType>
+  subspan() const {
+    DD_SPAN_EXPECT(Offset <= static_cast<std::size_t>(size()) &&
+                   (Count == dynamic_extent || Offset + Count <= static_cast<std::size_t>(size())));
+    return {data() + Offset, Count != dynamic_extent ? Count : static_cast<std::size_t>(size()) - Offset};
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 dynamic_type first(size_type count) const {
+    DD_SPAN_EXPECT(detail::index_nonnegative(count) && count <= size());
+    return dynamic_type(data(), count, detail::basic_span_unchecked_t());
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 dynamic_type last(size_type count) const {
+    DD_SPAN_EXPECT(detail::index_nonnegative(count) && count <= size());
+    return dynamic_type(data() + (size() - count), count, detail::basic_span_unchecked_t());
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 dynamic_type subspan(size_type off) const {
+    DD_SPAN_EXPECT(detail::index_nonnegative(off) && off <= size());
+    return dynamic_type(data() + off, size() - off, detail::basic_span_unchecked_t());
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 dynamic_type subspan(size_type off, size_type cnt) const {
+    DD_SPAN_EXPECT(detail::index_nonnegative(off) && detail::index_nonnegative(cnt) && off <= size() &&
+                   cnt <= size() - off);
+    return dynamic_type(data() + off, cnt, detail::basic_span_unchecked_t());
+  }
+
+  // observers
+  DD_SPAN_API constexpr size_type size() const noexcept { return storage_.size; }
+  DD_SPAN_API constexpr std::size_t size_bytes() const noexcept {
+    return static_cast<std::size_t>(size()) * sizeof(element_type);
+  }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return size() == 0; }
+
+  // element access
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference operator[](size_type idx) const {
+    DD_SPAN_EXPECT(detail::index_nonnegative(idx) && idx < size());
+    return *(data() + idx);
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference front() const {
+    DD_SPAN_EXPECT(!empty());
+    return *data();
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference back() const {
+    DD_SPAN_EXPECT(!empty());
+    return *(data() + (size() - 1));
+  }
+  DD_SPAN_API constexpr pointer data() const noexcept { return storage_.ptr; }
+
+  // iterators
+  DD_SPAN_API constexpr iterator begin() const noexcept { return data(); }
+  DD_SPAN_API constexpr iterator end() const noexcept { return data() + size(); }
+  DD_SPAN_API DD_SPAN_ARRAY_CONSTEXPR reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  DD_SPAN_API DD_SPAN_ARRAY_CONSTEXPR reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+private:
+  template <typename, std::size_t, typename> friend class basic_span;
+
+  // Sizes taken from an existing basic_span with the same IndexType already fit
+  DD_SPAN_API constexpr basic_span(pointer ptr, size_type count, detail::basic_span_unchecked_t) noexcept
+      : storage_(ptr, count) {}
+
+  storage_type storage_;
+};
+
+// free makers
+
+template <typename IndexType, typename ET, std::size_t E>
+DD_SPAN_API DD_SPAN_CONSTEXPR11 basic_span<ET, E, IndexType> make_basic_span(span<ET, E> s) {
+  return basic_span<ET, E, IndexType>(s);
+}
+template <typename ET, std::size_t E>
+DD_SPAN_API DD_SPAN_CONSTEXPR11 compact_span<ET, E> make_compact_span(span<ET, E> s) {
+  return compact_span<ET, E>(s);
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
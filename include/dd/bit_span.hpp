@@ -0,0 +1,567 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// bit_span: a view of packed bits stored LSB-first in unsigned words, addressed at any bit offset. Access goes
+// through proxy references; count/any/all/find and the bitwise operations work a word (or a vector of words) at a
+// time through the kernels of simd.hpp, and are host-only.
+
+#include "simd.hpp"
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+template <typename Word = std::uint64_t> class bit_span;
+
+namespace detail {
+
+template <typename Word> struct word_bits : std::integral_constant<std::size_t, sizeof(Word) * 8> {};
+
+// Mask of the n lowest bits, n <= bits of Word
+template <typename Word> DD_SPAN_API constexpr Word low_bits(std::size_t n) noexcept {
+  return n >= word_bits<Word>::value ? static_cast<Word>(~Word(0)) : static_cast<Word>((Word(1) << n) - 1);
+}
+
+inline std::size_t popcount64(std::uint64_t v) noexcept {
+  v = v - ((v >> 1) & 0x5555555555555555ull);
+  v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+  v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0full;
+  return static_cast<std::size_t>((v * 0x0101010101010101ull) >> 56);
+}
+
+// Number of set bits in a run of bytes
+struct popcount_op {
+  std::size_t scalar(span<const unsigned char> s) const noexcept {
+    const unsigned char *p = s.data();
+    std::size_t total = 0, i = 0;
+    for (; i + 8 <= s.size(); i += 8) {
+      std::uint64_t w;
+      std::memcpy(&w, p + i, 8);
+      total += popcount64(w);
+    }
+    for (; i < s.size(); ++i) {
+      total += popcount64(p[i]);
+    }
+    return total;
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  // Per-byte counts from the nibble-wise bit trick, accumulated in byte lanes for up to 31 vectors (31 * 8 < 256)
+  // and then folded into the total, so no popcount instruction is needed
+  template <std::size_t Bytes> DD_SPAN_SIMD_KERNEL std::size_t vector(span<const unsigned char> s) const noexcept {
+    using V = typename simd_vector<unsigned char, Bytes>::type;
+    const unsigned char *p = s.data();
+    const std::size_t n = s.size();
+    std::size_t total = 0, i = 0;
+    while (i + Bytes <= n) {
+      V acc = {};
+      for (std::size_t k = 0; k < 31 && i + Bytes <= n; ++k, i += Bytes) {
+        V x;
+        std::memcpy(&x, p + i, Bytes);
+        x = x - ((x >> 1) & 0x55);
+        x = (x & 0x33) + ((x >> 2) & 0x33);
+        acc += (x + (x >> 4)) & 0x0f;
+      }
+      std::uint64_t words[Bytes / 8];
+      std::memcpy(words, &acc, Bytes);
+      for (std::size_t j = 0; j < Bytes / 8; ++j) {
+        const std::uint64_t w16 = (words[j] & 0x00ff00ff00ff00ffull) + ((words[j] >> 8) & 0x00ff00ff00ff00ffull);
+        total += static_cast<std::size_t>((w16 * 0x0001000100010001ull) >> 48);
+      }
+    }
+    return total + scalar(s.subspan(i));
+  }
+#endif
+};
+
+// Index of the first byte different from value, or the size
+struct find_other_byte_op {
+  unsigned char value;
+
+  std::size_t scalar(span<const unsigned char> s) const noexcept {
+    const unsigned char *p = s.data();
+    const std::uint64_t broadcast = 0x0101010101010101ull * value;
+    std::size_t i = 0;
+    for (; i + 8 <= s.size(); i += 8) {
+      std::uint64_t w;
+      std::memcpy(&w, p + i, 8);
+      if (w != broadcast) {
+        break;
+      }
+    }
+    while (i < s.size() && p[i] == value) {
+      ++i;
+    }
+    return i;
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  template <std::size_t Bytes> DD_SPAN_SIMD_KERNEL std::size_t vector(span<const unsigned char> s) const noexcept {
+    using V = typename simd_vector<unsigned char, Bytes>::type;
+    const unsigned char *p = s.data();
+    std::size_t i = 0;
+    for (; i + Bytes <= s.size(); i += Bytes) {
+      V x;
+      std::memcpy(&x, p + i, Bytes);
+      if (simd_any(x != value)) {
+        break;
+      }
+    }
+    return i + scalar(s.subspan(i));
+  }
+#endif
+};
+
+enum class bit_op { and_, or_, andnot, xor_ };
+
+template <bit_op Op, typename T> T apply_bit_op(T a, T b) noexcept {
+  return static_cast<T>(Op == bit_op::and_  ? (a & b)
+                        : Op == bit_op::or_ ? (a | b)
+                        : Op == bit_op::andnot ? (a & ~b)
+                                               : (a ^ b));
+}
+
+// dst[i] = a[i] op b[i] over equally long runs of bytes
+template <bit_op Op> struct bitwise_op {
+  void scalar(span<unsigned char> dst, span<const unsigned char> a, span<const unsigned char> b) const noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= dst.size(); i += 8) {
+      std::uint64_t x, y;
+      std::memcpy(&x, a.data() + i, 8);
+      std::memcpy(&y, b.data() + i, 8);
+      x = apply_bit_op<Op>(x, y);
+      std::memcpy(dst.data() + i, &x, 8);
+    }
+    for (; i < dst.size(); ++i) {
+      dst.data()[i] = apply_bit_op<Op>(a.data()[i], b.data()[i]);
+    }
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  template <std::size_t Bytes>
+  DD_SPAN_SIMD_KERNEL void vector(span<unsigned char> dst, span<const unsigned char> a,
+                                  span<const unsigned char> b) const noexcept {
+    using V = typename simd_vector<unsigned char, Bytes>::type;
+    std::size_t i = 0;
+    for (; i + Bytes <= dst.size(); i += Bytes) {
+      V x, y;
+      std::memcpy(&x, a.data() + i, Bytes);
+      std::memcpy(&y, b.data() + i, Bytes);
+      x = Op == bit_op::and_ ? (x & y) : Op == bit_op::or_ ? (x | y) : Op == bit_op::andnot ? (x & ~y) : (x ^ y);
+      std::memcpy(dst.data() + i, &x, Bytes);
+    }
+    scalar(dst.subspan(i), a.subspan(i), b.subspan(i));
+  }
+#endif
+};
+
+// Proxy for one bit of a mutable bit_span
+template <typename Word> class bit_reference {
+public:
+  DD_SPAN_API constexpr bit_reference(Word *word, Word mask) noexcept : word_(word), mask_(mask) {}
+  bit_reference(const bit_reference &) = default;
+
+  DD_SPAN_API constexpr operator bool() const noexcept { return (*word_ & mask_) != 0; }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 const bit_reference &operator=(bool value) const noexcept {
+    *word_ = value ? static_cast<Word>(*word_ | mask_) : static_cast<Word>(*word_ & ~mask_);
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 const bit_reference &operator=(const bit_reference &other) const noexcept {
+    return *this = static_cast<bool>(other);
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 void flip() const noexcept { *word_ ^= mask_; }
+
+private:
+  Word *word_;
+  Word mask_;
+};
+
+template <typename Word> class bit_iterator {
+  static constexpr std::size_t bits = word_bits<typename std::remove_const<Word>::type>::value;
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = bool;
+  using difference_type = std::ptrdiff_t;
+  using reference = typename std::conditional<std::is_const<Word>::value, bool, bit_reference<Word>>::type;
+  using pointer = void;
+
+  DD_SPAN_API constexpr bit_iterator() noexcept = default;
+  DD_SPAN_API constexpr bit_iterator(Word *words, difference_type pos) noexcept : words_(words), pos_(pos) {}
+
+  DD_SPAN_API constexpr reference operator*() const noexcept { return at(pos_); }
+  DD_SPAN_API constexpr reference operator[](difference_type n) const noexcept { return at(pos_ + n); }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 bit_iterator &operator++() noexcept {
+    ++pos_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 bit_iterator operator++(int) noexcept {
+    bit_iterator tmp = *this;
+    ++pos_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 bit_iterator &operator--() noexcept {
+    --pos_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 bit_iterator operator--(int) noexcept {
+    bit_iterator tmp = *this;
+    --pos_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 bit_iterator &operator+=(difference_type n) noexcept {
+    pos_ += n;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 bit_iterator &operator-=(difference_type n) noexcept {
+    pos_ -= n;
+    return *this;
+  }
+  DD_SPAN_API constexpr friend bit_iterator operator+(const bit_iterator &it, difference_type n) noexcept {
+    return bit_iterator(it.words_, it.pos_ + n);
+  }
+  DD_SPAN_API constexpr friend bit_iterator operator+(difference_type n, const bit_iterator &it) noexcept {
+    return it + n;
+  }
+  DD_SPAN_API constexpr friend bit_iterator operator-(const bit_iterator &it, difference_type n) noexcept {
+    return bit_iterator(it.words_, it.pos_ - n);
+  }
+  DD_SPAN_API constexpr friend difference_type operator-(const bit_iterator &lhs, const bit_iterator &rhs) noexcept {
+    return lhs.pos_ - rhs.pos_;
+  }
+
+  DD_SPAN_API constexpr friend bool operator==(const bit_iterator &lhs, const bit_iterator &rhs) noexcept {
+    return lhs.pos_ == rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator!=(const bit_iterator &lhs, const bit_iterator &rhs) noexcept {
+    return lhs.pos_ != rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator<(const bit_iterator &lhs, const bit_iterator &rhs) noexcept {
+    return lhs.pos_ < rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator>(const bit_iterator &lhs, const bit_iterator &rhs) noexcept {
+    return lhs.pos_ > rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator<=(const bit_iterator &lhs, const bit_iterator &rhs) noexcept {
+    return lhs.pos_ <= rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator>=(const bit_iterator &lhs, const bit_iterator &rhs) noexcept {
+    return lhs.pos_ >= rhs.pos_;
+  }
+
+private:
+  using word_value = typename std::remove_const<Word>::type;
+
+  DD_SPAN_API constexpr reference at(difference_type pos) const noexcept {
+    return make_reference(words_ + static_cast<std::size_t>(pos) / bits,
+                          static_cast<word_value>(word_value(1) << (static_cast<std::size_t>(pos) % bits)),
+                          std::is_const<Word>());
+  }
+  DD_SPAN_API static constexpr bool make_reference(Word *word, word_value mask, std::true_type) noexcept {
+    return (*word & mask) != 0;
+  }
+  DD_SPAN_API static constexpr bit_reference<Word> make_reference(Word *word, word_value mask,
+                                                                  std::false_type) noexcept {
+    return bit_reference<Word>(word, mask);
+  }
+
+  Word *words_ = nullptr;
+  difference_type pos_ = 0; // counted from bit 0 of words_
+};
+
+} // namespace detail
+
+// bit_span class: size() bits starting at bit offset() of *data(). Word is an unsigned integer type; a const Word
+// gives a read-only view.
+
+template <typename Word> class bit_span {
+  using word_value = typename std::remove_const<Word>::type;
+  static_assert(std::is_unsigned<word_value>::value && !std::is_same<word_value, bool>::value,
+                "bit_span words must be unsigned integers");
+  static_assert(!std::is_volatile<Word>::value, "bit_span words must not be volatile");
+
+public:
+  using word_type = Word;
+  using element_type = bool;
+  using value_type = bool;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = typename detail::bit_iterator<Word>::reference;
+  using iterator = detail::bit_iterator<Word>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  static constexpr size_type word_bits = detail::word_bits<word_value>::value;
+
+  // constructors
+  DD_SPAN_API constexpr bit_span() noexcept = default;
+  // bits bits starting at bit offset of words[0]
+  DD_SPAN_API constexpr bit_span(Word *words, size_type bits, size_type offset = 0) noexcept
+      : data_(words + offset / word_bits), offset_(offset % word_bits), size_(bits) {}
+  // Every bit of the words
+  template <std::size_t E>
+  DD_SPAN_API constexpr bit_span(span<Word, E> words) noexcept : data_(words.data()), size_(words.size() * word_bits) {}
+  template <typename U, typename std::enable_if<std::is_same<const U, Word>::value && !std::is_const<U>::value,
+                                                int>::type = 0>
+  DD_SPAN_API constexpr bit_span(const bit_span<U> &other) noexcept
+      : data_(other.data()), offset_(other.offset()), size_(other.size()) {}
+
+  // observers
+  DD_SPAN_API constexpr size_type size() const noexcept { return size_; }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return size_ == 0; }
+  // First word and the position of bit 0 in it
+  DD_SPAN_API constexpr Word *data() const noexcept { return data_; }
+  DD_SPAN_API constexpr size_type offset() const noexcept { return offset_; }
+  // The words the bits touch; bits outside the view in the first and last word are not part of it
+  DD_SPAN_API constexpr span<Word> words() const noexcept {
+    return span<Word>(data_, (offset_ + size_ + word_bits - 1) / word_bits);
+  }
+
+  // element access
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return begin()[static_cast<difference_type>(idx)];
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 bool test(size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return (data_[(offset_ + idx) / word_bits] >> ((offset_ + idx) % word_bits)) & 1u;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 void set(size_type idx, bool value = true) const {
+    static_assert(!std::is_const<Word>::value, "cannot modify a bit_span of const words");
+    DD_SPAN_EXPECT(idx < size());
+    (*this)[idx] = value;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 void reset(size_type idx) const { set(idx, false); }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 void flip(size_type idx) const {
+    static_assert(!std::is_const<Word>::value, "cannot modify a bit_span of const words");
+    DD_SPAN_EXPECT(idx < size());
+    (*this)[idx].flip();
+  }
+  // Sets every bit of the view to value, leaving neighbouring bits of the boundary words alone
+  void fill(bool value) const {
+    static_assert(!std::is_const<Word>::value, "cannot modify a bit_span of const words");
+    const word_value all = value ? static_cast<word_value>(~word_value(0)) : word_value(0);
+    for_each_segment([&](Word &w, word_value mask) { w = static_cast<word_value>((w & ~mask) | (all & mask)); },
+                     [&](span<Word> full) {
+                       if (!full.empty()) {
+                         std::memset(static_cast<void *>(full.data()), value ? 0xff : 0, full.size_bytes());
+                       }
+                     });
+  }
+
+  // subviews
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 bit_span first(size_type count) const {
+    DD_SPAN_EXPECT(count <= size());
+    return bit_span(data_, count, offset_);
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 bit_span last(size_type count) const {
+    DD_SPAN_EXPECT(count <= size());
+    return bit_span(data_, count, offset_ + (size_ - count));
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 bit_span subspan(size_type off, size_type count = dynamic_extent) const {
+    DD_SPAN_EXPECT(off <= size() && (count == dynamic_extent || count <= size() - off));
+    return bit_span(data_, count == dynamic_extent ? size_ - off : count, offset_ + off);
+  }
+
+  // iterators
+  DD_SPAN_API constexpr iterator begin() const noexcept {
+    return iterator(data_, static_cast<difference_type>(offset_));
+  }
+  DD_SPAN_API constexpr iterator end() const noexcept {
+    return iterator(data_, static_cast<difference_type>(offset_ + size_));
+  }
+  DD_SPAN_API constexpr reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  DD_SPAN_API constexpr reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+  // Word-parallel queries (host-only)
+  size_type count(simd_isa isa = best_simd_isa()) const {
+    size_type total = 0;
+    for_each_segment([&](const Word &w, word_value mask) { total += detail::popcount64(w & mask); },
+                     [&](span<Word> full) {
+                       total += detail::simd_dispatch(std::true_type(), isa, detail::popcount_op(), bytes_of(full));
+                     });
+    return total;
+  }
+  // Index of the first set (or clear) bit, or size() if there is none
+  size_type find_first_set(simd_isa isa = best_simd_isa()) const { return find_first(false, isa); }
+  size_type find_first_unset(simd_isa isa = best_simd_isa()) const { return find_first(true, isa); }
+  bool any(simd_isa isa = best_simd_isa()) const { return find_first_set(isa) != size_; }
+  bool none(simd_isa isa = best_simd_isa()) const { return !any(isa); }
+  bool all(simd_isa isa = best_simd_isa()) const { return find_first_unset(isa) == size_; }
+
+private:
+  template <typename> friend class bit_span;
+
+  static span<const unsigned char> bytes_of(span<Word> words) noexcept {
+    return span<const unsigned char>(reinterpret_cast<const unsigned char *>(words.data()), words.size_bytes());
+  }
+
+  // Calls partial(word, mask) for a first or last word the view covers only in part, and full(words) for the
+  // whole words in between, in order
+  template <typename Partial, typename Full> void for_each_segment(Partial partial, Full full) const {
+    if (size_ == 0) {
+      return;
+    }
+    Word *p = data_;
+    size_type left = size_;
+    if (offset_ != 0) {
+      const size_type n = left < word_bits - offset_ ? left : word_bits - offset_;
+      partial(*p, static_cast<word_value>(detail::low_bits<word_value>(n) << offset_));
+      ++p;
+      left -= n;
+    }
+    full(span<Word>(p, left / word_bits));
+    if (left % word_bits != 0) {
+      partial(p[left / word_bits], detail::low_bits<word_value>(left % word_bits));
+    }
+  }
+
+  size_type find_first(bool invert, simd_isa isa) const {
+    const word_value flip = invert ? static_cast<word_value>(~word_value(0)) : word_value(0);
+    size_type pos = 0;
+    size_type found = size_;
+    for_each_segment(
+        [&](const Word &w, word_value mask) {
+          if (found != size_) {
+            return;
+          }
+          const word_value hits = static_cast<word_value>((w ^ flip) & mask);
+          if (hits != 0) {
+            found = pos + detail::countr_zero(hits) - (pos == 0 ? offset_ : 0);
+          }
+          pos += pos == 0 ? word_bits - offset_ : word_bits;
+        },
+        [&](span<Word> full) {
+          if (found != size_ || full.empty()) {
+            return;
+          }
+          const std::size_t first_byte =
+              detail::simd_dispatch(std::true_type(), isa, detail::find_other_byte_op{static_cast<unsigned char>(flip)},
+                                    bytes_of(full));
+          if (first_byte != full.size_bytes()) {
+            const size_type word = first_byte / sizeof(Word);
+            found = pos + word * word_bits + detail::countr_zero(static_cast<word_value>(full[word] ^ flip));
+          }
+          pos += full.size() * word_bits;
+        });
+    return found;
+  }
+
+  Word *data_ = nullptr;
+  size_type offset_ = 0;
+  size_type size_ = 0;
+};
+
+namespace detail {
+
+// Sources are not deduced, so mutable views bind to them as well
+template <typename Word> using const_bits = bit_span<const typename std::remove_const<Word>::type>;
+
+} // namespace detail
+
+// dst = a op b bit by bit; all three views have the same size but may start at different bit offsets. When the
+// offsets agree the whole words in between run through the vector kernels, otherwise a word at a time.
+
+namespace detail {
+
+template <bit_op Op, typename Word>
+void bitwise(bit_span<Word> dst, bit_span<const Word> a, bit_span<const Word> b, simd_isa isa) {
+  static_assert(!std::is_const<Word>::value, "the destination of a bitwise operation must be mutable");
+  DD_SPAN_EXPECT(a.size() == dst.size() && b.size() == dst.size());
+  constexpr std::size_t bits = word_bits<Word>::value;
+  // The n <= bits bits at pos of a view, in the low bits of a word; never reads past the view's last word
+  const auto load = [](bit_span<const Word> s, std::size_t pos, std::size_t n) -> Word {
+    const std::size_t bit = s.offset() + pos;
+    const Word *p = s.data() + bit / bits;
+    const std::size_t shift = bit % bits;
+    Word v = static_cast<Word>(p[0] >> shift);
+    if (shift != 0 && shift + n > bits) {
+      v = static_cast<Word>(v | static_cast<Word>(p[1] << (bits - shift)));
+    }
+    return v;
+  };
+  const auto merge = [&](std::size_t pos, std::size_t n) {
+    const Word v = static_cast<Word>(apply_bit_op<Op>(load(a, pos, n), load(b, pos, n)) & low_bits<Word>(n));
+    const std::size_t bit = dst.offset() + pos;
+    Word *p = dst.data() + bit / bits;
+    const std::size_t shift = bit % bits;
+    p[0] = static_cast<Word>((p[0] & ~static_cast<Word>(low_bits<Word>(n) << shift)) | static_cast<Word>(v << shift));
+    if (shift != 0 && shift + n > bits) {
+      const Word hi = low_bits<Word>(shift + n - bits);
+      p[1] = static_cast<Word>((p[1] & ~hi) | (v >> (bits - shift)));
+    }
+  };
+
+  std::size_t done = 0;
+  if (a.offset() == dst.offset() && b.offset() == dst.offset()) {
+    // Leading partial word, then the whole words through the kernels
+    const std::size_t head = dst.offset() == 0 ? 0 : bits - dst.offset();
+    if (head != 0) {
+      done = head < dst.size() ? head : dst.size();
+      merge(0, done);
+    }
+    const std::size_t words = (dst.size() - done) / bits;
+    if (words != 0) {
+      const std::size_t first = done == 0 ? 0 : 1;
+      const std::size_t n = words * sizeof(Word);
+      simd_dispatch(std::true_type(), isa, bitwise_op<Op>(),
+                    span<unsigned char>(reinterpret_cast<unsigned char *>(dst.data() + first), n),
+                    span<const unsigned char>(reinterpret_cast<const unsigned char *>(a.data() + first), n),
+                    span<const unsigned char>(reinterpret_cast<const unsigned char *>(b.data() + first), n));
+    }
+    done += words * bits;
+  }
+  for (; done < dst.size(); done += bits) {
+    merge(done, dst.size() - done < bits ? dst.size() - done : bits);
+  }
+}
+
+} // namespace detail
+
+template <typename Word>
+void bit_and(bit_span<Word> dst, detail::const_bits<Word> a, detail::const_bits<Word> b,
+            simd_isa isa = best_simd_isa()) {
+  detail::bitwise<detail::bit_op::and_>(dst, a, b, isa);
+}
+template <typename Word>
+void bit_or(bit_span<Word> dst, detail::const_bits<Word> a, detail::const_bits<Word> b,
+           simd_isa isa = best_simd_isa()) {
+  detail::bitwise<detail::bit_op::or_>(dst, a, b, isa);
+}
+// dst = a & ~b
+template <typename Word>
+void bit_andnot(bit_span<Word> dst, detail::const_bits<Word> a, detail::const_bits<Word> b,
+               simd_isa isa = best_simd_isa()) {
+  detail::bitwise<detail::bit_op::andnot>(dst, a, b, isa);
+}
+template <typename Word>
+void bit_xor(bit_span<Word> dst, detail::const_bits<Word> a, detail::const_bits<Word> b,
+            simd_isa isa = best_simd_isa()) {
+  detail::bitwise<detail::bit_op::xor_>(dst, a, b, isa);
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
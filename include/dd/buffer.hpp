@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only: an owning, move-only array whose elements are default-initialized rather than value-initialized, so
+// trivial types are left untouched until written, with a compile-time alignment and an optional huge-page hint
+
+#include "aligned_span.hpp"
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+enum class buffer_hint {
+  none,
+  // Aligns and pads the allocation to 2 MiB and asks the kernel for transparent huge pages (Linux)
+  huge_pages,
+};
+
+namespace detail {
+
+DD_SPAN_INLINE_VAR constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+// Alignment the buffer type guarantees without any hint: a cache line, or more if the element needs it
+template <typename T> constexpr std::size_t buffer_alignment() noexcept { return alignof(T) > 64 ? alignof(T) : 64; }
+
+inline void *aligned_allocate(std::size_t bytes, std::size_t align, buffer_hint hint) {
+  if (hint == buffer_hint::huge_pages) {
+    align = align > huge_page_size ? align : huge_page_size;
+    bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+  }
+  align = align > sizeof(void *) ? align : sizeof(void *);
+#if defined(_WIN32)
+  void *p = ::_aligned_malloc(bytes, align);
+#else
+  void *p = nullptr;
+  if (::posix_memalign(&p, align, bytes) != 0) {
+    p = nullptr;
+  }
+#endif
+  if (p == nullptr) {
+#ifndef DD_SPAN_NO_EXCEPTIONS
+    throw std::bad_alloc();
+#else
+    std::abort();
+#endif
+  }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (hint == buffer_hint::huge_pages) {
+    ::madvise(p, bytes, MADV_HUGEPAGE); // a hint: failure leaves ordinary pages
+  }
+#endif
+  return p;
+}
+
+inline void aligned_free(void *p) noexcept {
+#if defined(_WIN32)
+  ::_aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+} // namespace detail
+
+// Move-only owner of size() contiguous T aligned to Align bytes. It models a container (data() and size()), so
+// dd::span's container constructors and make_span accept it, and it converts to aligned_span up to Align.
+template <typename T, std::size_t Align = detail::buffer_alignment<T>()> class buffer {
+  static_assert(detail::is_pow2(Align), "Align must be a power of two");
+  static_assert(Align >= alignof(T), "Align must be at least the alignment of T");
+  static_assert(!std::is_const<T>::value && !std::is_volatile<T>::value, "buffer elements must not be cv-qualified");
+
+public:
+  using element_type = T;
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
+  static constexpr size_type alignment = Align;
+
+  buffer() noexcept = default;
+  // n default-initialized elements: trivial types keep whatever the allocation holds. The constructors delegate to
+  // the default one so that the destructor cleans up if an element constructor throws.
+  explicit buffer(size_type n, buffer_hint hint = buffer_hint::none) : buffer() {
+    hint_ = hint;
+    allocate(n);
+    default_construct(n);
+  }
+  buffer(size_type n, const T &value, buffer_hint hint = buffer_hint::none) : buffer() {
+    hint_ = hint;
+    allocate(n);
+    fill_construct(n, value);
+  }
+
+  buffer(const buffer &) = delete;
+  buffer &operator=(const buffer &) = delete;
+  buffer(buffer &&other) noexcept { swap(other); }
+  buffer &operator=(buffer &&other) noexcept {
+    buffer(std::move(other)).swap(*this);
+    return *this;
+  }
+  ~buffer() { release(); }
+
+  void swap(buffer &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(hint_, other.hint_);
+  }
+
+  // Reallocates to exactly n elements, keeping the first min(n, size()) and default-initializing the rest
+  void resize(size_type n) {
+    if (n == size_) {
+      return;
+    }
+    buffer next;
+    next.hint_ = hint_;
+    next.allocate(n);
+    next.relocate_from(data_, n < size_ ? n : size_);
+    next.default_construct(n - next.size_);
+    swap(next);
+  }
+
+  // observers
+  size_type size() const noexcept { return size_; }
+  size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+  DD_SPAN_NODISCARD bool empty() const noexcept { return size_ == 0; }
+  buffer_hint hint() const noexcept { return hint_; }
+
+  // element access
+  pointer data() noexcept { return detail::assume_aligned<Align>(data_); }
+  const_pointer data() const noexcept { return detail::assume_aligned<Align>(static_cast<const T *>(data_)); }
+  reference operator[](size_type idx) {
+    DD_SPAN_EXPECT(idx < size());
+    return data()[idx];
+  }
+  const_reference operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return data()[idx];
+  }
+  reference front() {
+    DD_SPAN_EXPECT(!empty());
+    return data()[0];
+  }
+  const_reference front() const {
+    DD_SPAN_EXPECT(!empty());
+    return data()[0];
+  }
+  reference back() {
+    DD_SPAN_EXPECT(!empty());
+    return data()[size_ - 1];
+  }
+  const_reference back() const {
+    DD_SPAN_EXPECT(!empty());
+    return data()[size_ - 1];
+  }
+
+  // iterators
+  iterator begin() noexcept { return data(); }
+  iterator end() noexcept { return data() + size_; }
+  const_iterator begin() const noexcept { return data(); }
+  const_iterator end() const noexcept { return data() + size_; }
+
+  // views
+  span<T> as_span() noexcept { return span<T>(data(), size_); }
+  span<const T> as_span() const noexcept { return span<const T>(data(), size_); }
+  template <std::size_t N> span<T, N> as_span() {
+    DD_SPAN_EXPECT(N == size_);
+    return span<T, N>(data(), N);
+  }
+  template <std::size_t N> span<const T, N> as_span() const {
+    DD_SPAN_EXPECT(N == size_);
+    return span<const T, N>(data(), N);
+  }
+  aligned_span<T, dynamic_extent, Align> as_aligned_span() noexcept {
+    return aligned_span<T, dynamic_extent, Align>(as_span(), detail::aligned_unchecked_t{});
+  }
+  aligned_span<const T, dynamic_extent, Align> as_aligned_span() const noexcept {
+    return aligned_span<const T, dynamic_extent, Align>(as_span(), detail::aligned_unchecked_t{});
+  }
+
+  // Plain spans come from dd::span's container constructors; aligned spans need a conversion of their own
+  template <typename U, std::size_t A,
+            typename std::enable_if<std::is_convertible<T (*)[], U (*)[]>::value && A <= Align, int>::type = 0>
+  operator aligned_span<U, dynamic_extent, A>() noexcept {
+    return as_aligned_span();
+  }
+  template <typename U, std::size_t A,
+            typename std::enable_if<std::is_convertible<const T (*)[], U (*)[]>::value && A <= Align, int>::type = 0>
+  operator aligned_span<U, dynamic_extent, A>() const noexcept {
+    return as_aligned_span();
+  }
+
+private:
+  void allocate(size_type n) {
+    if (n == 0) {
+      return;
+    }
+    if (n > dynamic_extent / sizeof(T)) {
+#ifndef DD_SPAN_NO_EXCEPTIONS
+      throw std::bad_array_new_length();
+#else
+      std::abort();
+#endif
+    }
+    data_ = static_cast<T *>(detail::aligned_allocate(n * sizeof(T), Align, hint_));
+  }
+
+  // Each helper appends to [data_, data_ + size_) and counts every element it builds, so that a throwing element
+  // constructor leaves only fully built elements for release()
+  void default_construct(size_type n) {
+    if (std::is_trivially_default_constructible<T>::value) {
+      size_ += n;
+      return;
+    }
+    for (size_type i = 0; i < n; ++i, ++size_) {
+      ::new (static_cast<void *>(data_ + size_)) T;
+    }
+  }
+  void fill_construct(size_type n, const T &value) {
+    for (size_type i = 0; i < n; ++i, ++size_) {
+      ::new (static_cast<void *>(data_ + size_)) T(value);
+    }
+  }
+  void relocate_from(T *from, size_type n) {
+    if (std::is_trivially_copyable<T>::value) {
+      if (n != 0) {
+        std::memcpy(static_cast<void *>(data_ + size_), static_cast<const void *>(from), n * sizeof(T));
+      }
+      size_ += n;
+      return;
+    }
+    for (size_type i = 0; i < n; ++i, ++size_) {
+      ::new (static_cast<void *>(data_ + size_)) T(std::move_if_noexcept(from[i]));
+    }
+  }
+
+  void release() noexcept {
+    if (!std::is_trivially_destructible<T>::value) {
+      for (size_type i = size_; i > 0; --i) {
+        data_[i - 1].~T();
+      }
+    }
+    detail::aligned_free(data_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  T *data_ = nullptr;
+  size_type size_ = 0;
+  buffer_hint hint_ = buffer_hint::none;
+};
+
+template <typename T, std::size_t Align> inline void swap(buffer<T, Align> &lhs, buffer<T, Align> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
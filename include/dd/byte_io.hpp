@@ -0,0 +1,480 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only cursors for decoding and encoding binary formats in place: byte_reader over span<const byte> and
+// byte_writer over span<byte>. Fixed-size fields are loaded and stored unaligned in either byte order, and
+// LEB128 varints are decoded in batches by the vector kernels of simd.hpp.
+//
+// read<T>() and friends treat running past the end as a contract violation; the try_ variants return false
+// instead and are meant for input that has not been validated.
+
+#include "simd.hpp"
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <stdlib.h>
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+enum class endian {
+  little,
+  big,
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  native = big,
+#else
+  native = little,
+#endif
+};
+
+// Outcome of a batched varint decode
+struct varint_decode_result {
+  std::size_t bytes; // input consumed
+  std::size_t count; // values written
+};
+
+namespace detail {
+
+inline std::uint8_t byteswap(std::uint8_t v) noexcept { return v; }
+#if defined(_MSC_VER) && !defined(__clang__)
+inline std::uint16_t byteswap(std::uint16_t v) noexcept { return _byteswap_ushort(v); }
+inline std::uint32_t byteswap(std::uint32_t v) noexcept { return _byteswap_ulong(v); }
+inline std::uint64_t byteswap(std::uint64_t v) noexcept { return _byteswap_uint64(v); }
+#else
+inline std::uint16_t byteswap(std::uint16_t v) noexcept { return __builtin_bswap16(v); }
+inline std::uint32_t byteswap(std::uint32_t v) noexcept { return __builtin_bswap32(v); }
+inline std::uint64_t byteswap(std::uint64_t v) noexcept { return __builtin_bswap64(v); }
+#endif
+
+template <std::size_t Size> struct uint_of_size;
+template <> struct uint_of_size<1> {
+  using type = std::uint8_t;
+};
+template <> struct uint_of_size<2> {
+  using type = std::uint16_t;
+};
+template <> struct uint_of_size<4> {
+  using type = std::uint32_t;
+};
+template <> struct uint_of_size<8> {
+  using type = std::uint64_t;
+};
+
+// Arithmetic and enum types of 1, 2, 4 or 8 bytes can be loaded and stored as fields
+template <typename T>
+struct byte_field
+    : std::integral_constant<bool, (std::is_arithmetic<T>::value || std::is_enum<T>::value) &&
+                                       (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+template <typename T, endian E> T load_field(const unsigned char *p) noexcept {
+  using U = typename uint_of_size<sizeof(T)>::type;
+  U bits;
+  std::memcpy(&bits, p, sizeof(T));
+  if (E != endian::native) {
+    bits = byteswap(bits);
+  }
+  T value;
+  std::memcpy(&value, &bits, sizeof(T));
+  return value;
+}
+
+template <typename T, endian E> void store_field(unsigned char *p, T value) noexcept {
+  using U = typename uint_of_size<sizeof(T)>::type;
+  U bits;
+  std::memcpy(&bits, &value, sizeof(T));
+  if (E != endian::native) {
+    bits = byteswap(bits);
+  }
+  std::memcpy(p, &bits, sizeof(T));
+}
+
+// Longest LEB128 encoding of a 64-bit value
+DD_SPAN_INLINE_VAR constexpr std::size_t varint_max_bytes = 10;
+
+// Decodes one varint from [p, end); returns its length, or 0 if it is truncated or longer than 10 bytes. Bits
+// beyond the 64th are dropped.
+inline std::size_t leb128_decode_one(const unsigned char *p, const unsigned char *end, std::uint64_t &value) noexcept {
+  std::uint64_t result = 0;
+  for (std::size_t i = 0; i < varint_max_bytes && p + i < end; ++i) {
+    result |= static_cast<std::uint64_t>(p[i] & 0x7f) << (7 * i);
+    if ((p[i] & 0x80) == 0) {
+      value = result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+// The 7-bit groups of the first len (1 to 8) bytes of w, gathered pairwise into one value
+inline std::uint64_t leb128_gather(std::uint64_t w, std::size_t len) noexcept {
+  w &= 0x7f7f7f7f7f7f7f7full >> (64 - 8 * len);
+  w = (w & 0x007f007f007f007full) | ((w & 0x7f007f007f007f00ull) >> 1);
+  w = (w & 0x00003fff00003fffull) | ((w & 0x3fff00003fff0000ull) >> 2);
+  w = (w & 0x000000000fffffffull) | ((w & 0x0fffffff00000000ull) >> 4);
+  return w;
+}
+
+// As leb128_decode_one, but requires 8 readable bytes at p; varints of up to 8 bytes are decoded from one word
+inline std::size_t leb128_decode_word(const unsigned char *p, const unsigned char *end, std::uint64_t &value) noexcept {
+  const std::uint64_t w = load_field<std::uint64_t, endian::little>(p);
+  const std::uint64_t stops = ~w & 0x8080808080808080ull;
+  if (stops == 0) {
+    return leb128_decode_one(p, end, value);
+  }
+  const std::size_t len = (countr_zero(stops) + 1) / 8;
+  value = leb128_gather(w, len);
+  return len;
+}
+
+// Bit i of the result is set when byte i of the 8 at p ends a varint, i.e. has its high bit clear
+inline std::uint64_t leb128_stops8(std::uint64_t w) noexcept {
+  const std::uint64_t t = (~w >> 7) & 0x0101010101010101ull;
+  return (t * 0x0102040810204080ull) >> 56;
+}
+
+// Decodes the varints that end within the 64-byte block at p, given the block's stop mask, into o (room for 64).
+// Each varint's start follows from the mask alone, so successive decodes do not wait for each other's loads.
+// Requires 80 readable bytes at p. Returns the bytes consumed; a varint left open at the end of the block is not
+// consumed, and decoding stops in front of a varint longer than 10 bytes.
+inline std::size_t leb128_decode_block(const unsigned char *p, std::uint64_t stops, std::uint64_t *o,
+                                       std::size_t &count) noexcept {
+  std::size_t start = 0;
+  std::size_t n = 0;
+  while (stops != 0) {
+    const std::size_t stop = countr_zero(stops);
+    const std::size_t len = stop + 1 - start;
+    if (len <= 8) {
+      o[n] = leb128_gather(load_field<std::uint64_t, endian::little>(p + start), len);
+    } else if (leb128_decode_one(p + start, p + stop + 1, o[n]) == 0) {
+      break;
+    }
+    ++n;
+    start = stop + 1;
+    stops &= stops - 1;
+  }
+  count += n;
+  return start;
+}
+
+// Walks the input in 64-byte blocks while 80 bytes and 64 output slots remain, so bounds are checked once per
+// block. Blocks made only of single-byte varints, common for small counts, tags and deltas, are widened in one go.
+struct leb128_op {
+  varint_decode_result scalar(span<const unsigned char> in, span<std::uint64_t> out) const noexcept {
+    const unsigned char *const first = in.data();
+    const unsigned char *p = first;
+    const unsigned char *const end = first + in.size();
+    std::size_t count = 0;
+    while (out.size() - count >= 64 && end - p >= 80) {
+      std::uint64_t stops = 0;
+      for (std::size_t j = 0; j < 8; ++j) {
+        stops |= leb128_stops8(load_field<std::uint64_t, endian::little>(p + 8 * j)) << (8 * j);
+      }
+      if (stops == ~std::uint64_t(0)) {
+        for (std::size_t j = 0; j < 64; ++j) {
+          out.data()[count + j] = p[j];
+        }
+        p += 64;
+        count += 64;
+        continue;
+      }
+      const std::size_t used = leb128_decode_block(p, stops, out.data() + count, count);
+      if (used == 0) {
+        break;
+      }
+      p += used;
+    }
+    return finish(first, p, end, out, count);
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  // As scalar(), with the stop mask computed from vector shifts and the widening of blocks of single-byte
+  // varints done Bytes at a time
+  template <std::size_t Bytes>
+  DD_SPAN_SIMD_KERNEL varint_decode_result vector(span<const unsigned char> in,
+                                                  span<std::uint64_t> out) const noexcept {
+    using V = typename simd_vector<unsigned char, Bytes>::type;
+    const unsigned char *const first = in.data();
+    const unsigned char *p = first;
+    const unsigned char *const end = first + in.size();
+    std::uint64_t *const o = out.data();
+    std::size_t count = 0;
+    while (out.size() - count >= 64 && end - p >= 80) {
+      std::uint64_t words[8];
+      for (std::size_t k = 0; k < 64 / Bytes; ++k) {
+        V x;
+        std::memcpy(&x, p + k * Bytes, Bytes);
+        const V high = x >> 7;
+        std::memcpy(reinterpret_cast<unsigned char *>(words) + k * Bytes, &high, Bytes);
+      }
+      std::uint64_t stops = 0;
+      for (std::size_t j = 0; j < 8; ++j) {
+        stops |= ((((words[j] ^ 0x0101010101010101ull) * 0x0102040810204080ull) >> 56) << (8 * j));
+      }
+      if (stops == ~std::uint64_t(0)) {
+        for (std::size_t j = 0; j < 64; ++j) {
+          o[count + j] = p[j];
+        }
+        p += 64;
+        count += 64;
+        continue;
+      }
+      const std::size_t used = leb128_decode_block(p, stops, o + count, count);
+      if (used == 0) {
+        break;
+      }
+      p += used;
+    }
+    return finish(first, p, end, out, count);
+  }
+#endif
+
+private:
+  // The last few varints, with bounds checks
+  static varint_decode_result finish(const unsigned char *first, const unsigned char *p, const unsigned char *end,
+                                     span<std::uint64_t> out, std::size_t count) noexcept {
+    while (count < out.size() && p < end) {
+      const std::size_t len = end - p >= 8 ? leb128_decode_word(p, end, out.data()[count])
+                                           : leb128_decode_one(p, end, out.data()[count]);
+      if (len == 0) {
+        break;
+      }
+      p += len;
+      ++count;
+    }
+    return varint_decode_result{static_cast<std::size_t>(p - first), count};
+  }
+};
+
+} // namespace detail
+
+// Bytes needed to encode v as a LEB128 varint
+inline std::size_t varint_size(std::uint64_t v) noexcept {
+  std::size_t n = 1;
+  while (v >= 0x80) {
+    v >>= 7;
+    ++n;
+  }
+  return n;
+}
+
+// Decodes unsigned LEB128 varints from in into out until out is full, in is exhausted, or a varint is truncated
+// or longer than 10 bytes. Returns the bytes consumed and the number of values written.
+template <std::size_t E1, std::size_t E2>
+varint_decode_result decode_varints(span<const byte, E1> in, span<std::uint64_t, E2> out,
+                                    simd_isa isa = best_simd_isa()) {
+  const span<const unsigned char> bytes(reinterpret_cast<const unsigned char *>(in.data()), in.size());
+  return detail::simd_dispatch(std::true_type(), isa, detail::leb128_op(), bytes, span<std::uint64_t>(out));
+}
+
+class byte_reader {
+public:
+  byte_reader() noexcept = default;
+  explicit byte_reader(span<const byte> bytes) noexcept
+      : data_(reinterpret_cast<const unsigned char *>(bytes.data())), size_(bytes.size()) {}
+
+  std::size_t size() const noexcept { return size_; }
+  std::size_t position() const noexcept { return pos_; }
+  std::size_t remaining() const noexcept { return size_ - pos_; }
+  DD_SPAN_NODISCARD bool empty() const noexcept { return pos_ == size_; }
+  // The bytes not read yet
+  span<const byte> rest() const noexcept { return span<const byte>(as_byte(data_ + pos_), remaining()); }
+
+  void seek(std::size_t pos) {
+    DD_SPAN_EXPECT(pos <= size_);
+    pos_ = pos;
+  }
+  void skip(std::size_t n) {
+    DD_SPAN_EXPECT(n <= remaining());
+    pos_ += n;
+  }
+
+  // Fixed-size fields, loaded unaligned in byte order E
+  template <typename T, endian E = endian::little> T read() {
+    static_assert(detail::byte_field<T>::value, "read<T> needs an arithmetic or enum type of 1, 2, 4 or 8 bytes");
+    DD_SPAN_EXPECT(sizeof(T) <= remaining());
+    const T value = detail::load_field<T, E>(data_ + pos_);
+    pos_ += sizeof(T);
+    return value;
+  }
+  template <typename T, endian E = endian::little> T peek() const {
+    static_assert(detail::byte_field<T>::value, "peek<T> needs an arithmetic or enum type of 1, 2, 4 or 8 bytes");
+    DD_SPAN_EXPECT(sizeof(T) <= remaining());
+    return detail::load_field<T, E>(data_ + pos_);
+  }
+  template <typename T, endian E = endian::little> bool try_read(T &value) noexcept {
+    static_assert(detail::byte_field<T>::value, "try_read<T> needs an arithmetic or enum type of 1, 2, 4 or 8 bytes");
+    if (sizeof(T) > remaining()) {
+      return false;
+    }
+    value = detail::load_field<T, E>(data_ + pos_);
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  span<const byte> read_bytes(std::size_t n) {
+    DD_SPAN_EXPECT(n <= remaining());
+    const span<const byte> s(as_byte(data_ + pos_), n);
+    pos_ += n;
+    return s;
+  }
+
+  // Whether the cursor is suitably aligned for read_n<T>
+  template <typename T> bool aligned_for() const noexcept {
+    return reinterpret_cast<std::uintptr_t>(data_ + pos_) % alignof(T) == 0;
+  }
+  // count native-order elements viewed in place; the cursor must be aligned for T
+  template <typename T> span<const T> read_n(std::size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value, "read_n<T> needs a trivially copyable type");
+    DD_SPAN_EXPECT(count <= remaining() / sizeof(T));
+    DD_SPAN_EXPECT(aligned_for<T>());
+    const span<const T> s(reinterpret_cast<const T *>(data_ + pos_), count);
+    pos_ += count * sizeof(T);
+    return s;
+  }
+  // Copies out.size() elements in byte order E, whatever the alignment
+  template <typename T, endian E = endian::little> void read_n_into(span<T> out) {
+    static_assert(detail::byte_field<T>::value, "read_n_into needs an arithmetic or enum type of 1, 2, 4 or 8 bytes");
+    DD_SPAN_EXPECT(out.size() <= remaining() / sizeof(T));
+    const unsigned char *p = data_ + pos_;
+    if (E == endian::native) {
+      if (!out.empty()) {
+        std::memcpy(static_cast<void *>(out.data()), p, out.size_bytes());
+      }
+    } else {
+      T *o = out.data();
+      for (std::size_t i = 0; i < out.size(); ++i) {
+        o[i] = detail::load_field<T, E>(p + i * sizeof(T));
+      }
+    }
+    pos_ += out.size_bytes();
+  }
+
+  // Unsigned LEB128 varints
+  std::uint64_t read_varint() {
+    std::uint64_t value = 0;
+    const std::size_t len = detail::leb128_decode_one(data_ + pos_, data_ + size_, value);
+    DD_SPAN_EXPECT(len != 0);
+    pos_ += len;
+    return value;
+  }
+  bool try_read_varint(std::uint64_t &value) noexcept {
+    const std::size_t len = detail::leb128_decode_one(data_ + pos_, data_ + size_, value);
+    pos_ += len;
+    return len != 0;
+  }
+  // Decodes up to out.size() varints and returns how many were read; fewer means the input ended or the next
+  // varint is malformed, and the cursor stops in front of it
+  std::size_t read_varints(span<std::uint64_t> out, simd_isa isa = best_simd_isa()) {
+    const varint_decode_result r = decode_varints(rest(), out, isa);
+    pos_ += r.bytes;
+    return r.count;
+  }
+
+private:
+  static const byte *as_byte(const unsigned char *p) noexcept { return reinterpret_cast<const byte *>(p); }
+
+  const unsigned char *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t pos_ = 0;
+};
+
+class byte_writer {
+public:
+  byte_writer() noexcept = default;
+  explicit byte_writer(span<byte> bytes) noexcept
+      : data_(reinterpret_cast<unsigned char *>(bytes.data())), size_(bytes.size()) {}
+
+  std::size_t size() const noexcept { return size_; }
+  std::size_t position() const noexcept { return pos_; }
+  std::size_t remaining() const noexcept { return size_ - pos_; }
+  // The bytes written so far
+  span<byte> written() const noexcept { return span<byte>(reinterpret_cast<byte *>(data_), pos_); }
+
+  void seek(std::size_t pos) {
+    DD_SPAN_EXPECT(pos <= size_);
+    pos_ = pos;
+  }
+
+  template <endian E = endian::little, typename T> void write(T value) {
+    static_assert(detail::byte_field<T>::value, "write needs an arithmetic or enum type of 1, 2, 4 or 8 bytes");
+    DD_SPAN_EXPECT(sizeof(T) <= remaining());
+    detail::store_field<T, E>(data_ + pos_, value);
+    pos_ += sizeof(T);
+  }
+  template <endian E = endian::little, typename T> bool try_write(T value) noexcept {
+    static_assert(detail::byte_field<T>::value, "try_write needs an arithmetic or enum type of 1, 2, 4 or 8 bytes");
+    if (sizeof(T) > remaining()) {
+      return false;
+    }
+    detail::store_field<T, E>(data_ + pos_, value);
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  void write_bytes(span<const byte> bytes) {
+    DD_SPAN_EXPECT(bytes.size() <= remaining());
+    if (!bytes.empty()) {
+      std::memcpy(data_ + pos_, bytes.data(), bytes.size());
+    }
+    pos_ += bytes.size();
+  }
+  // Elements in byte order E
+  template <endian E = endian::little, typename T, std::size_t N> void write_n(span<T, N> values) {
+    using V = typename std::remove_cv<T>::type;
+    static_assert(detail::byte_field<V>::value, "write_n needs an arithmetic or enum type of 1, 2, 4 or 8 bytes");
+    DD_SPAN_EXPECT(values.size() <= remaining() / sizeof(T));
+    if (E == endian::native) {
+      if (!values.empty()) {
+        std::memcpy(data_ + pos_, static_cast<const void *>(values.data()), values.size_bytes());
+      }
+    } else {
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        detail::store_field<V, E>(data_ + pos_ + i * sizeof(T), values[i]);
+      }
+    }
+    pos_ += values.size_bytes();
+  }
+
+  void write_varint(std::uint64_t value) {
+    DD_SPAN_EXPECT(varint_size(value) <= remaining());
+    while (value >= 0x80) {
+      data_[pos_++] = static_cast<unsigned char>(value | 0x80);
+      value >>= 7;
+    }
+    data_[pos_++] = static_cast<unsigned char>(value);
+  }
+
+private:
+  unsigned char *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t pos_ = 0;
+};
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "span.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+namespace detail {
+
+// Random-access iterator over any view exposing a value-returning unchecked(i)
+template <typename View> class index_iterator {
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = typename View::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type;
+  using pointer = void;
+
+  DD_SPAN_API constexpr index_iterator() noexcept = default;
+  DD_SPAN_API constexpr index_iterator(const View &view, difference_type idx) noexcept : view_(view), idx_(idx) {}
+
+  DD_SPAN_API constexpr reference operator*() const noexcept {
+    return view_.unchecked(static_cast<std::size_t>(idx_));
+  }
+  DD_SPAN_API constexpr reference operator[](difference_type n) const noexcept {
+    return view_.unchecked(static_cast<std::size_t>(idx_ + n));
+  }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_iterator &operator++() noexcept {
+    ++idx_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_iterator operator++(int) noexcept {
+    index_iterator tmp = *this;
+    ++idx_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_iterator &operator--() noexcept {
+    --idx_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_iterator operator--(int) noexcept {
+    index_iterator tmp = *this;
+    --idx_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_iterator &operator+=(difference_type n) noexcept {
+    idx_ += n;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_iterator &operator-=(difference_type n) noexcept {
+    idx_ -= n;
+    return *this;
+  }
+  DD_SPAN_API constexpr friend index_iterator operator+(const index_iterator &it, difference_type n) noexcept {
+    return index_iterator(it.view_, it.idx_ + n);
+  }
+  DD_SPAN_API constexpr friend index_iterator operator+(difference_type n, const index_iterator &it) noexcept {
+    return it + n;
+  }
+  DD_SPAN_API constexpr friend index_iterator operator-(const index_iterator &it, difference_type n) noexcept {
+    return index_iterator(it.view_, it.idx_ - n);
+  }
+  DD_SPAN_API constexpr friend difference_type operator-(const index_iterator &lhs,
+                                                         const index_iterator &rhs) noexcept {
+    return lhs.idx_ - rhs.idx_;
+  }
+
+  DD_SPAN_API constexpr friend bool operator==(const index_iterator &lhs, const index_iterator &rhs) noexcept {
+    return lhs.idx_ == rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator!=(const index_iterator &lhs, const index_iterator &rhs) noexcept {
+    return lhs.idx_ != rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator<(const index_iterator &lhs, const index_iterator &rhs) noexcept {
+    return lhs.idx_ < rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator>(const index_iterator &lhs, const index_iterator &rhs) noexcept {
+    return lhs.idx_ > rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator<=(const index_iterator &lhs, const index_iterator &rhs) noexcept {
+    return lhs.idx_ <= rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator>=(const index_iterator &lhs, const index_iterator &rhs) noexcept {
+    return lhs.idx_ >= rhs.idx_;
+  }
+
+private:
+  View view_;
+  difference_type idx_ = 0;
+};
+
+} // namespace detail
+
+// Full chunks of N elements as span<T, N>; the remainder is available through tail()
+
+template <typename ElementType, std::size_t Extent, std::size_t N> class static_chunk_view {
+  static_assert(N != 0 && N != dynamic_extent, "chunk size must be a positive static value");
+  using span_type = span<ElementType, Extent>;
+
+public:
+  using value_type = span<ElementType, N>;
+  using tail_type = span<ElementType, (Extent == dynamic_extent ? dynamic_extent : Extent % N)>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = detail::index_iterator<static_chunk_view>;
+  static constexpr size_type chunk_size = N;
+
+  DD_SPAN_API constexpr static_chunk_view() noexcept = default;
+  DD_SPAN_API constexpr explicit static_chunk_view(span_type s) noexcept : span_(s) {}
+
+  // number of full chunks
+  DD_SPAN_API constexpr size_type size() const noexcept { return span_.size() / N; }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return size() == 0; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 value_type operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return unchecked(idx);
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 tail_type tail() const {
+    return tail_type(span_.data() + size() * N, span_.size() % N);
+  }
+
+  DD_SPAN_API constexpr iterator begin() const noexcept { return iterator(*this, 0); }
+  DD_SPAN_API constexpr iterator end() const noexcept { return iterator(*this, static_cast<difference_type>(size())); }
+
+private:
+  friend class detail::index_iterator<static_chunk_view>;
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 value_type unchecked(size_type idx) const {
+    return value_type(span_.data() + idx * N, N);
+  }
+
+  span_type span_;
+};
+
+// Chunks of a runtime size; the last one may be shorter
+
+template <typename ElementType, std::size_t Extent> class chunk_view {
+  using span_type = span<ElementType, Extent>;
+
+public:
+  using value_type = span<ElementType>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = detail::index_iterator<chunk_view>;
+
+  DD_SPAN_API constexpr chunk_view() noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 chunk_view(span_type s, size_type chunk) : span_(s), chunk_(chunk) {
+    DD_SPAN_EXPECT(chunk != 0);
+  }
+
+  DD_SPAN_API constexpr size_type size() const noexcept {
+    return chunk_ == 0 ? 0 : (span_.size() + chunk_ - 1) / chunk_;
+  }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return size() == 0; }
+  DD_SPAN_API constexpr size_type chunk_size() const noexcept { return chunk_; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 value_type operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return unchecked(idx);
+  }
+
+  DD_SPAN_API constexpr iterator begin() const noexcept { return iterator(*this, 0); }
+  DD_SPAN_API constexpr iterator end() const noexcept { return iterator(*this, static_cast<difference_type>(size())); }
+
+private:
+  friend class detail::index_iterator<chunk_view>;
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 value_type unchecked(size_type idx) const {
+    return value_type(span_.data() + idx * chunk_,
+                      span_.size() - idx * chunk_ < chunk_ ? span_.size() - idx * chunk_ : chunk_);
+  }
+
+  span_type span_;
+  size_type chunk_ = 0;
+};
+
+// A fixed number of contiguous tiles whose sizes differ by at most one element, e.g. one per worker
+
+template <typename ElementType, std::size_t Extent> class tile_view {
+  using span_type = span<ElementType, Extent>;
+
+public:
+  using value_type = span<ElementType>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = detail::index_iterator<tile_view>;
+
+  DD_SPAN_API constexpr tile_view() noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 tile_view(span_type s, size_type count) : span_(s), count_(count) {
+    DD_SPAN_EXPECT(count != 0);
+  }
+
+  DD_SPAN_API constexpr size_type size() const noexcept { return count_; }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return size() == 0; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 value_type operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return unchecked(idx);
+  }
+
+  DD_SPAN_API constexpr iterator begin() const noexcept { return iterator(*this, 0); }
+  DD_SPAN_API constexpr iterator end() const noexcept { return iterator(*this, static_cast<difference_type>(size())); }
+
+private:
+  friend class detail::index_iterator<tile_view>;
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 value_type unchecked(size_type idx) const {
+    const size_type base = span_.size() / count_;
+    const size_type rem = span_.size() % count_;
+    return value_type(span_.data() + idx * base + (idx < rem ? idx : rem), base + (idx < rem ? 1 : 0));
+  }
+
+  span_type span_;
+  size_type count_ = 0;
+};
+
+// free makers
+
+template <std::size_t N, typename ET, std::size_t E>
+DD_SPAN_API constexpr static_chunk_view<ET, E, N> chunks(span<ET, E> s) noexcept {
+  return static_chunk_view<ET, E, N>(s);
+}
+template <typename ET, std::size_t E>
+DD_SPAN_API DD_SPAN_CONSTEXPR11 chunk_view<ET, E> chunks(span<ET, E> s, std::size_t chunk) {
+  return chunk_view<ET, E>(s, chunk);
+}
+template <typename ET, std::size_t E>
+DD_SPAN_API DD_SPAN_CONSTEXPR11 tile_view<ET, E> tiles(span<ET, E> s, std::size_t count) {
+  return tile_view<ET, E>(s, count);
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,418 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only 64-bit content hashing of byte spans and of spans of trivially copyable values.
+//
+// Inputs of up to 128 bytes are mixed with a few 64x64->128-bit multiplications. Longer inputs are folded into eight
+// 64-bit lanes, one 64-byte stripe at a time, with 32x32->64-bit multiplications that the vector kernels of
+// simd.hpp run several lanes at once (the scheme follows XXH3, but the output is not XXH3's). The lanes are
+// scrambled every 1 KiB block and merged at the end. The result is the same on every instruction set and platform
+// and does not change between releases, so it may be stored. It is not a cryptographic hash.
+
+#include "byte_io.hpp"
+#include "simd.hpp"
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+#if defined(DD_SPAN_SIMD_X86)
+#include <immintrin.h>
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+namespace detail {
+
+DD_SPAN_INLINE_VAR constexpr std::size_t hash_stripe_bytes = 64;
+DD_SPAN_INLINE_VAR constexpr std::size_t hash_block_stripes = 16;
+DD_SPAN_INLINE_VAR constexpr std::size_t hash_block_bytes = hash_stripe_bytes * hash_block_stripes;
+DD_SPAN_INLINE_VAR constexpr std::size_t hash_short_max = 128;
+DD_SPAN_INLINE_VAR constexpr std::size_t hash_secret_words = 24;
+// Key of the final, possibly overlapping stripe; stripe j of a block uses words j to j + 7
+DD_SPAN_INLINE_VAR constexpr std::size_t hash_last_key = 16;
+
+DD_SPAN_INLINE_VAR constexpr std::uint64_t hash_prime1 = 0x9e3779b185ebca87ull;
+DD_SPAN_INLINE_VAR constexpr std::uint64_t hash_prime2 = 0xc2b2ae3d27d4eb4full;
+DD_SPAN_INLINE_VAR constexpr std::uint64_t hash_prime3 = 0x165667b19e3779f9ull;
+DD_SPAN_INLINE_VAR constexpr std::uint64_t hash_prime4 = 0x85ebca77c2b2ae63ull;
+DD_SPAN_INLINE_VAR constexpr std::uint64_t hash_prime5 = 0x27d4eb2f165667c5ull;
+DD_SPAN_INLINE_VAR constexpr std::uint64_t hash_prime32 = 0x9e3779b1ull;
+
+// splitmix64 outputs; a seed is added to the even words and subtracted from the odd ones
+DD_SPAN_INLINE_VAR constexpr std::uint64_t hash_secret[hash_secret_words] = {
+    0x2cb0f69f4abea221ull, 0x9417034723148989ull, 0xdd555950609dfe03ull, 0xdbafb150deb12800ull,
+    0x7e789b2e6c442cb6ull, 0xf41e5636c7e4f8c4ull, 0x0959d150f8fba7e4ull, 0xa97316f13cdb9eeaull,
+    0x74cd8258f9520068ull, 0x55c74a62e116868bull, 0xd2f4c799a2023cbdull, 0xdf98cb79a37b51b9ull,
+    0x396f5885524f3905ull, 0xaf1d56386ca3b276ull, 0xa9ffbe6b5104e85aull, 0x6bd0c51b9fd533b3ull,
+    0x980ce91c50ab4b56ull, 0x28ac395780fe62c5ull, 0x768912e3a6bcedc7ull, 0x50b3e8c9332c7c88ull,
+    0xce3bbfe520bd47daull, 0xcba6c8e8e0bb7c4full, 0xbf194db8434a346dull, 0x7d8f2a7b60416d7full,
+};
+
+constexpr std::uint64_t hash_key(std::size_t i, std::uint64_t seed) noexcept {
+  return i % 2 == 0 ? hash_secret[i] + seed : hash_secret[i] - seed;
+}
+
+// The whole seeded secret, for inputs long enough to use all of it
+struct hash_keys {
+  std::uint64_t words[hash_secret_words];
+
+  explicit hash_keys(std::uint64_t seed) noexcept {
+    for (std::size_t i = 0; i < hash_secret_words; ++i) {
+      words[i] = hash_key(i, seed);
+    }
+  }
+};
+
+inline std::uint64_t hash_read64(const unsigned char *p) noexcept {
+  return load_field<std::uint64_t, endian::little>(p);
+}
+inline std::uint64_t hash_read32(const unsigned char *p) noexcept {
+  return load_field<std::uint32_t, endian::little>(p);
+}
+
+inline std::uint64_t rotl64(std::uint64_t v, unsigned r) noexcept { return (v << r) | (v >> (64 - r)); }
+
+// Low and high halves of the 128-bit product, xor-ed together
+inline std::uint64_t mul128_fold(std::uint64_t a, std::uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ using u128 = unsigned __int128;
+  const u128 p = static_cast<u128>(a) * b;
+  return static_cast<std::uint64_t>(p) ^ static_cast<std::uint64_t>(p >> 64);
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+  std::uint64_t hi;
+  const std::uint64_t lo = _umul128(a, b, &hi);
+  return lo ^ hi;
+#else
+  const std::uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32, b_lo = b & 0xffffffffu, b_hi = b >> 32;
+  const std::uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+  const std::uint64_t mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+  const std::uint64_t lo = (ll & 0xffffffffu) | (mid << 32);
+  const std::uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  return lo ^ hi;
+#endif
+}
+
+inline std::uint64_t hash_avalanche(std::uint64_t h) noexcept {
+  h ^= h >> 37;
+  h *= 0x165667919e3779f9ull;
+  return h ^ (h >> 32);
+}
+
+inline std::uint64_t hash_mix16(const unsigned char *p, std::size_t key, std::uint64_t seed) noexcept {
+  return mul128_fold(hash_read64(p) ^ hash_key(key, seed), hash_read64(p + 8) ^ hash_key(key + 1, seed));
+}
+
+// Inputs of at most hash_short_max bytes
+inline std::uint64_t hash_short(const unsigned char *p, std::size_t len, std::uint64_t seed) noexcept {
+  if (len == 0) {
+    return hash_avalanche(hash_key(0, seed) ^ hash_key(1, seed));
+  }
+  if (len <= 3) {
+    const std::uint64_t c = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[len / 2]) << 24) | p[len - 1] |
+                            (std::uint64_t(len) << 8);
+    return hash_avalanche((c ^ hash_key(0, seed)) * hash_prime1);
+  }
+  if (len <= 8) {
+    std::uint64_t v = ((hash_read32(p) << 32) | hash_read32(p + len - 4)) ^ hash_key(1, seed);
+    v ^= rotl64(v, 49) ^ rotl64(v, 24);
+    v *= 0x9fb21c651e98df25ull;
+    v ^= (v >> 35) + len;
+    v *= 0x9fb21c651e98df25ull;
+    return v ^ (v >> 28);
+  }
+  if (len <= 16) {
+    const std::uint64_t a = hash_read64(p) ^ hash_key(2, seed);
+    const std::uint64_t b = hash_read64(p + len - 8) ^ hash_key(3, seed);
+    return hash_avalanche(len + byteswap(a) + b + mul128_fold(a, b));
+  }
+  // Pairs of 16-byte reads from both ends, overlapping in the middle
+  std::uint64_t h = len * hash_prime1;
+  if (len > 32) {
+    if (len > 64) {
+      if (len > 96) {
+        h += hash_mix16(p + 48, 16, seed);
+        h += hash_mix16(p + len - 64, 18, seed);
+      }
+      h += hash_mix16(p + 32, 12, seed);
+      h += hash_mix16(p + len - 48, 14, seed);
+    }
+    h += hash_mix16(p + 16, 8, seed);
+    h += hash_mix16(p + len - 32, 10, seed);
+  }
+  h += hash_mix16(p, 4, seed);
+  h += hash_mix16(p + len - 16, 6, seed);
+  return hash_avalanche(h);
+}
+
+#if defined(DD_SPAN_SIMD_X86)
+// GCC multiplies generic 64-bit vectors in full (three pmuludq) even when both high halves are zero, so the x86
+// kernels spell out the 32x32->64-bit multiply: one pmuludq per vector.
+#define DD_SPAN_HASH_ACCUMULATE(vec, load, add, mul, xor_, srl)                                                      \
+  vec a[hash_stripe_bytes / sizeof(vec)];                                                                           \
+  std::memcpy(a, acc, hash_stripe_bytes);                                                                           \
+  for (std::size_t j = 0; j < stripes; ++j) {                                                                       \
+    for (std::size_t r = 0; r < hash_stripe_bytes / sizeof(vec); ++r) {                                             \
+      const vec d = load(reinterpret_cast<const vec *>(p + j * hash_stripe_bytes + r * sizeof(vec)));               \
+      const vec k = xor_(d, load(reinterpret_cast<const vec *>(key + j + r * (sizeof(vec) / 8))));                  \
+      a[r] = add(a[r], add(d, mul(k, srl(k, 32))));                                                                 \
+    }                                                                                                               \
+  }                                                                                                                 \
+  std::memcpy(acc, a, hash_stripe_bytes)
+
+inline void hash_accumulate_x86(std::integral_constant<std::size_t, 16>, std::uint64_t *acc, const unsigned char *p,
+                                std::size_t stripes, const std::uint64_t *key) noexcept {
+  DD_SPAN_HASH_ACCUMULATE(__m128i, _mm_loadu_si128, _mm_add_epi64, _mm_mul_epu32, _mm_xor_si128, _mm_srli_epi64);
+}
+__attribute__((target("avx2"))) inline void hash_accumulate_x86(std::integral_constant<std::size_t, 32>,
+                                                                std::uint64_t *acc, const unsigned char *p,
+                                                                std::size_t stripes,
+                                                                const std::uint64_t *key) noexcept {
+  DD_SPAN_HASH_ACCUMULATE(__m256i, _mm256_loadu_si256, _mm256_add_epi64, _mm256_mul_epu32, _mm256_xor_si256,
+                          _mm256_srli_epi64);
+}
+// Zero-masking forms with a full mask: the plain ones trip -Wmaybe-uninitialized inside GCC 12's headers
+__attribute__((target("avx512f"), always_inline)) inline __m512i hash_mul512(__m512i a, __m512i b) noexcept {
+  return _mm512_maskz_mul_epu32(0xff, a, b);
+}
+__attribute__((target("avx512f"), always_inline)) inline __m512i hash_srl512(__m512i a, unsigned n) noexcept {
+  return _mm512_maskz_srli_epi64(0xff, a, n);
+}
+__attribute__((target("avx512f"))) inline void hash_accumulate_x86(std::integral_constant<std::size_t, 64>,
+                                                                   std::uint64_t *acc, const unsigned char *p,
+                                                                   std::size_t stripes,
+                                                                   const std::uint64_t *key) noexcept {
+  DD_SPAN_HASH_ACCUMULATE(__m512i, _mm512_loadu_si512, _mm512_add_epi64, hash_mul512, _mm512_xor_si512, hash_srl512);
+}
+#undef DD_SPAN_HASH_ACCUMULATE
+#endif
+
+// acc[lane] += d + lo32(d ^ key) * hi32(d ^ key) for each 8-byte lane d of stripes 64-byte stripes, stripe j keyed
+// with key[j + lane]
+struct hash_accumulate_op {
+  void scalar(std::uint64_t *acc, const unsigned char *p, std::size_t stripes,
+              const std::uint64_t *key) const noexcept {
+    for (std::size_t j = 0; j < stripes; ++j) {
+      for (std::size_t lane = 0; lane < 8; ++lane) {
+        const std::uint64_t d = hash_read64(p + j * hash_stripe_bytes + lane * 8);
+        const std::uint64_t k = d ^ key[j + lane];
+        acc[lane] += d + (k & 0xffffffffu) * (k >> 32);
+      }
+    }
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  template <std::size_t Bytes>
+  DD_SPAN_SIMD_KERNEL void vector(std::uint64_t *acc, const unsigned char *p, std::size_t stripes,
+                                  const std::uint64_t *key) const noexcept {
+#if defined(DD_SPAN_SIMD_X86)
+    hash_accumulate_x86(std::integral_constant<std::size_t, Bytes>(), acc, p, stripes, key);
+#else
+    using V = typename simd_vector<std::uint64_t, Bytes>::type;
+    constexpr std::size_t per_stripe = hash_stripe_bytes / Bytes;
+    constexpr std::size_t lanes = Bytes / 8;
+    V a[per_stripe];
+    std::memcpy(a, acc, hash_stripe_bytes);
+    for (std::size_t j = 0; j < stripes; ++j) {
+      for (std::size_t r = 0; r < per_stripe; ++r) {
+        V d, k;
+        std::memcpy(&d, p + j * hash_stripe_bytes + r * Bytes, Bytes);
+        std::memcpy(&k, key + j + r * lanes, Bytes);
+        k ^= d;
+        a[r] += d + (k & 0xffffffffu) * (k >> 32);
+      }
+    }
+    std::memcpy(acc, a, hash_stripe_bytes);
+#endif
+  }
+#endif
+};
+
+// The vector kernels load lanes in native order, so only little-endian targets use them
+using hash_vectorizable = std::integral_constant<bool, endian::native == endian::little>;
+
+inline void hash_accumulate(std::uint64_t *acc, const unsigned char *p, std::size_t stripes, const std::uint64_t *key,
+                            simd_isa isa) {
+  simd_dispatch(hash_vectorizable(), isa, hash_accumulate_op(), acc, p, stripes, key);
+}
+
+inline void hash_scramble(std::uint64_t *acc, const hash_keys &keys) noexcept {
+  for (std::size_t lane = 0; lane < 8; ++lane) {
+    std::uint64_t a = acc[lane];
+    a ^= a >> 47;
+    a ^= keys.words[hash_last_key + lane];
+    acc[lane] = a * hash_prime32;
+  }
+}
+
+inline void hash_init_lanes(std::uint64_t *acc) noexcept {
+  const std::uint64_t init[8] = {0xc2b2ae3dull, hash_prime1, hash_prime2, hash_prime3,
+                                 hash_prime4,   0x85ebca77ull, hash_prime5, hash_prime32};
+  std::memcpy(acc, init, sizeof(init));
+}
+
+// Whole blocks, each followed by a scramble
+inline void hash_blocks(std::uint64_t *acc, const unsigned char *p, std::size_t blocks, const hash_keys &keys,
+                        simd_isa isa) {
+  for (std::size_t b = 0; b < blocks; ++b) {
+    hash_accumulate(acc, p + b * hash_block_bytes, hash_block_stripes, keys.words, isa);
+    hash_scramble(acc, keys);
+  }
+}
+
+// The last 1 to hash_block_bytes bytes: their whole stripes except the last, then the final 64 bytes of the input
+// (which may reach back into the previous block), then the lanes merged into one value
+inline std::uint64_t hash_finish(std::uint64_t *acc, const unsigned char *rest, std::size_t rest_len,
+                                 const unsigned char *last_stripe, std::uint64_t total, const hash_keys &keys,
+                                 simd_isa isa) {
+  hash_accumulate(acc, rest, (rest_len - 1) / hash_stripe_bytes, keys.words, isa);
+  hash_accumulate(acc, last_stripe, 1, keys.words + hash_last_key, isa);
+  std::uint64_t h = total * hash_prime1;
+  for (std::size_t i = 0; i < 4; ++i) {
+    h += mul128_fold(acc[2 * i] ^ keys.words[4 + 2 * i], acc[2 * i + 1] ^ keys.words[5 + 2 * i]);
+  }
+  return hash_avalanche(h);
+}
+
+inline std::uint64_t hash_long(const unsigned char *p, std::size_t len, const hash_keys &keys, simd_isa isa) {
+  std::uint64_t acc[8];
+  hash_init_lanes(acc);
+  // At least one byte is left for hash_finish
+  const std::size_t blocks = (len - 1) / hash_block_bytes;
+  hash_blocks(acc, p, blocks, keys, isa);
+  const std::size_t done = blocks * hash_block_bytes;
+  return hash_finish(acc, p + done, len - done, p + len - hash_stripe_bytes, len, keys, isa);
+}
+
+} // namespace detail
+
+// 64-bit hash of the bytes; equal inputs and seeds give equal hashes on every platform
+inline std::uint64_t hash_bytes(span<const byte> bytes, std::uint64_t seed = 0, simd_isa isa = best_simd_isa()) {
+  DD_SPAN_EXPECT(simd_supported(isa));
+  const unsigned char *p = reinterpret_cast<const unsigned char *>(bytes.data());
+  return bytes.size() <= detail::hash_short_max ? detail::hash_short(p, bytes.size(), seed)
+                                                : detail::hash_long(p, bytes.size(), detail::hash_keys(seed), isa);
+}
+
+// Incremental form of hash_bytes: feeding the same bytes in any number of pieces gives the same digest
+class hasher {
+public:
+  explicit hasher(std::uint64_t seed = 0, simd_isa isa = best_simd_isa()) : keys_(seed), seed_(seed), isa_(isa) {
+    DD_SPAN_EXPECT(simd_supported(isa));
+    reset();
+  }
+
+  void reset() noexcept {
+    detail::hash_init_lanes(acc_);
+    buffered_ = 0;
+    total_ = 0;
+  }
+
+  void update(span<const byte> bytes) {
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(bytes.data());
+    std::size_t n = bytes.size();
+    total_ += n;
+    while (n != 0) {
+      // A full buffer is only a block once more input shows it is not the last one
+      if (buffered_ == detail::hash_block_bytes) {
+        consume_block(buffer_);
+        buffered_ = 0;
+      }
+      if (buffered_ == 0 && n > detail::hash_block_bytes) {
+        const std::size_t blocks = (n - 1) / detail::hash_block_bytes;
+        for (std::size_t b = 0; b < blocks; ++b) {
+          consume_block(p);
+          p += detail::hash_block_bytes;
+        }
+        n -= blocks * detail::hash_block_bytes;
+      }
+      const std::size_t take = n < detail::hash_block_bytes - buffered_ ? n : detail::hash_block_bytes - buffered_;
+      std::memcpy(buffer_ + buffered_, p, take);
+      buffered_ += take;
+      p += take;
+      n -= take;
+    }
+  }
+  template <typename T, std::size_t E> void update(span<T, E> values) { update(as_bytes(values)); }
+
+  // Hash of everything passed to update since construction or reset(); the state is left unchanged
+  std::uint64_t digest() const {
+    if (total_ <= detail::hash_short_max) {
+      return detail::hash_short(buffer_, buffered_, seed_);
+    }
+    std::uint64_t acc[8];
+    std::memcpy(acc, acc_, sizeof(acc));
+    unsigned char last[detail::hash_stripe_bytes];
+    const unsigned char *last_stripe = buffer_ + buffered_ - detail::hash_stripe_bytes;
+    if (buffered_ < detail::hash_stripe_bytes) {
+      const std::size_t from_previous = detail::hash_stripe_bytes - buffered_;
+      std::memcpy(last, previous_ + detail::hash_stripe_bytes - from_previous, from_previous);
+      std::memcpy(last + from_previous, buffer_, buffered_);
+      last_stripe = last;
+    }
+    return detail::hash_finish(acc, buffer_, buffered_, last_stripe, total_, keys_, isa_);
+  }
+
+private:
+  void consume_block(const unsigned char *block) {
+    detail::hash_blocks(acc_, block, 1, keys_, isa_);
+    std::memcpy(previous_, block + detail::hash_block_bytes - detail::hash_stripe_bytes, detail::hash_stripe_bytes);
+  }
+
+  std::uint64_t acc_[8];
+  detail::hash_keys keys_;
+  std::uint64_t seed_;
+  simd_isa isa_;
+  std::size_t buffered_ = 0;
+  std::uint64_t total_ = 0;
+  unsigned char previous_[detail::hash_stripe_bytes] = {}; // last stripe of the most recent block
+  unsigned char buffer_[detail::hash_block_bytes];
+};
+
+// Hash functor for spans of T, e.g. for unordered containers keyed by span contents. T must have no padding
+// or other bits outside its value (floating-point 0.0 and -0.0 hash differently).
+template <typename T> struct span_hash {
+#if defined(__cpp_lib_has_unique_object_representations)
+  static_assert(std::has_unique_object_representations<T>::value || std::is_floating_point<T>::value,
+                "span_hash needs a type whose bytes are exactly its value");
+#else
+  static_assert(std::is_trivially_copyable<T>::value, "span_hash needs a trivially copyable type");
+#endif
+
+  std::uint64_t seed = 0;
+
+  template <typename U, std::size_t E,
+            typename std::enable_if<std::is_same<typename std::remove_cv<U>::type, T>::value, int>::type = 0>
+  std::size_t operator()(span<U, E> s) const {
+    return static_cast<std::size_t>(hash_bytes(as_bytes(s), seed));
+  }
+};
+
+} // namespace DD_SPAN_NAMESPACE_NAME
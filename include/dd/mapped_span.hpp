@@ -0,0 +1,326 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only, POSIX: files mapped into memory and viewed as spans, so large binary arrays are read in place instead
+// of being copied into a container first
+
+#include "span.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+enum class map_access {
+  read_only,
+  read_write,    // writes go to the file
+  copy_on_write, // writes stay private to the mapping
+};
+
+// madvise hints; hugepage asks for transparent huge pages and fails where the kernel cannot back files with them
+enum class map_advice { normal, sequential, random, willneed, dontneed, hugepage };
+
+// A byte range of a file mapped into memory. The mapping stays valid after the file descriptor is closed and is
+// removed by the destructor. Failures are reported as std::system_error, or through the std::error_code overloads.
+class mapped_file {
+public:
+  mapped_file() noexcept = default;
+
+  // Maps length bytes starting at offset; dynamic_extent maps up to the end of the file
+  mapped_file(const std::string &path, map_access access, std::size_t offset, std::size_t length,
+              std::error_code &ec) noexcept {
+    ec = map(path.c_str(), access, offset, length);
+  }
+#ifndef DD_SPAN_NO_EXCEPTIONS
+  explicit mapped_file(const std::string &path, map_access access = map_access::read_only, std::size_t offset = 0,
+                       std::size_t length = dynamic_extent) {
+    const std::error_code ec = map(path.c_str(), access, offset, length);
+    if (ec) {
+      throw std::system_error(ec, "dd::mapped_file: " + path);
+    }
+  }
+#endif
+
+  mapped_file(const mapped_file &) = delete;
+  mapped_file &operator=(const mapped_file &) = delete;
+  mapped_file(mapped_file &&other) noexcept { swap(other); }
+  mapped_file &operator=(mapped_file &&other) noexcept {
+    mapped_file(std::move(other)).swap(*this);
+    return *this;
+  }
+  ~mapped_file() { unmap(); }
+
+  void swap(mapped_file &other) noexcept {
+    std::swap(base_, other.base_);
+    std::swap(mapped_, other.mapped_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(access_, other.access_);
+  }
+
+  unsigned char *data() const noexcept { return data_; }
+  std::size_t size() const noexcept { return size_; }
+  DD_SPAN_NODISCARD bool empty() const noexcept { return size_ == 0; }
+  map_access access() const noexcept { return access_; }
+  bool writable() const noexcept { return access_ != map_access::read_only; }
+
+  span<const unsigned char> bytes() const noexcept { return span<const unsigned char>(data_, size_); }
+  span<unsigned char> writable_bytes() const {
+    DD_SPAN_EXPECT(writable());
+    return span<unsigned char>(data_, size_);
+  }
+
+  // Applies a hint to length bytes starting at offset, widened to whole pages
+  std::error_code advise(map_advice advice, std::size_t offset = 0, std::size_t length = dynamic_extent) const {
+    DD_SPAN_EXPECT(offset <= size_);
+    if (length == dynamic_extent || length > size_ - offset) {
+      length = size_ - offset;
+    }
+    if (length == 0) {
+      return std::error_code();
+    }
+    const int flag = advice_flag(advice);
+    if (flag < 0) {
+      return std::make_error_code(std::errc::not_supported);
+    }
+    unsigned char *first = page_floor(data_ + offset);
+    const std::size_t span_length = static_cast<std::size_t>(data_ + offset + length - first);
+    return ::madvise(first, span_length, flag) == 0 ? std::error_code() : last_error();
+  }
+
+  // Writes modified pages of a read_write mapping back to the file and waits for completion
+  std::error_code flush() const noexcept {
+    if (mapped_ == 0 || access_ != map_access::read_write) {
+      return std::error_code();
+    }
+    return ::msync(base_, mapped_, MS_SYNC) == 0 ? std::error_code() : last_error();
+  }
+
+private:
+  static std::error_code last_error() noexcept { return std::error_code(errno, std::generic_category()); }
+
+  static std::size_t page_size() noexcept {
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return page;
+  }
+  static unsigned char *page_floor(unsigned char *p) noexcept {
+    const std::size_t addr = reinterpret_cast<std::size_t>(p);
+    return p - addr % page_size();
+  }
+
+  static int advice_flag(map_advice advice) noexcept {
+    switch (advice) {
+    case map_advice::normal:
+      return MADV_NORMAL;
+    case map_advice::sequential:
+      return MADV_SEQUENTIAL;
+    case map_advice::random:
+      return MADV_RANDOM;
+    case map_advice::willneed:
+      return MADV_WILLNEED;
+    case map_advice::dontneed:
+      return MADV_DONTNEED;
+    case map_advice::hugepage:
+#ifdef MADV_HUGEPAGE
+      return MADV_HUGEPAGE;
+#else
+      return -1;
+#endif
+    }
+    return -1;
+  }
+
+  std::error_code map(const char *path, map_access access, std::size_t offset, std::size_t length) noexcept {
+    const int fd = ::open(path, access == map_access::read_write ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+      return last_error();
+    }
+    const std::error_code ec = map_fd(fd, access, offset, length);
+    ::close(fd);
+    return ec;
+  }
+
+  std::error_code map_fd(int fd, map_access access, std::size_t offset, std::size_t length) noexcept {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      return last_error();
+    }
+    const std::size_t file_size = static_cast<std::size_t>(st.st_size);
+    // Pages past the end of the file raise SIGBUS when touched, so the range must lie within the file
+    if (offset > file_size || (length != dynamic_extent && length > file_size - offset)) {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    if (length == dynamic_extent) {
+      length = file_size - offset;
+    }
+    access_ = access;
+    if (length == 0) {
+      return std::error_code();
+    }
+    // mmap offsets must be page aligned; the slack before offset is mapped and skipped
+    const std::size_t slack = offset % page_size();
+    const int prot = access == map_access::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    const int flags = access == map_access::read_write ? MAP_SHARED : MAP_PRIVATE;
+    void *base = ::mmap(nullptr, length + slack, prot, flags, fd, static_cast<off_t>(offset - slack));
+    if (base == MAP_FAILED) {
+      return last_error();
+    }
+    base_ = base;
+    mapped_ = length + slack;
+    data_ = static_cast<unsigned char *>(base) + slack;
+    size_ = length;
+    return std::error_code();
+  }
+
+  void unmap() noexcept {
+    if (mapped_ != 0) {
+      ::munmap(base_, mapped_);
+    }
+    base_ = nullptr;
+    mapped_ = 0;
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  void *base_ = nullptr;
+  std::size_t mapped_ = 0;
+  unsigned char *data_ = nullptr;
+  std::size_t size_ = 0;
+  map_access access_ = map_access::read_only;
+};
+
+inline void swap(mapped_file &lhs, mapped_file &rhs) noexcept { lhs.swap(rhs); }
+
+// A mapped file viewed as an array of T. mapped_span<const T> maps read-only, mapped_span<T> read-write. The
+// mapping must hold a whole number of elements and start at a multiple of alignof(T).
+template <typename ElementType> class mapped_span {
+  static_assert(std::is_trivially_copyable<typename std::remove_cv<ElementType>::type>::value,
+                "mapped_span requires a trivially copyable element type");
+
+public:
+  using element_type = ElementType;
+  using value_type = typename std::remove_cv<ElementType>::type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = element_type *;
+  using reference = element_type &;
+  using iterator = pointer;
+  using span_type = span<element_type>;
+
+  mapped_span() noexcept = default;
+
+  // Maps count elements starting at element offset; dynamic_extent maps up to the end of the file
+  mapped_span(const std::string &path, size_type offset, size_type count, std::error_code &ec) noexcept {
+    ec = open(path, offset, count);
+  }
+  // Takes over an existing mapping, e.g. one that starts after a file header
+  mapped_span(mapped_file file, std::error_code &ec) noexcept { ec = adopt(std::move(file)); }
+#ifndef DD_SPAN_NO_EXCEPTIONS
+  explicit mapped_span(const std::string &path, size_type offset = 0, size_type count = dynamic_extent) {
+    const std::error_code ec = open(path, offset, count);
+    if (ec) {
+      throw std::system_error(ec, "dd::mapped_span: " + path);
+    }
+  }
+  explicit mapped_span(mapped_file file) {
+    const std::error_code ec = adopt(std::move(file));
+    if (ec) {
+      throw std::system_error(ec, "dd::mapped_span");
+    }
+  }
+#endif
+
+  size_type size() const noexcept { return file_.size() / sizeof(element_type); }
+  size_type size_bytes() const noexcept { return file_.size(); }
+  DD_SPAN_NODISCARD bool empty() const noexcept { return size() == 0; }
+  pointer data() const noexcept { return reinterpret_cast<pointer>(file_.data()); }
+
+  reference operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return data()[idx];
+  }
+  iterator begin() const noexcept { return data(); }
+  iterator end() const noexcept { return data() + size(); }
+
+  span_type as_span() const noexcept { return span_type(data(), size()); }
+  operator span_type() const noexcept { return as_span(); }
+
+  // Views into the mapping; they are plain spans and are valid as long as the mapped_span is
+  span_type first(size_type count) const { return as_span().first(count); }
+  span_type last(size_type count) const { return as_span().last(count); }
+  span_type subspan(size_type offset, size_type count = dynamic_extent) const {
+    return as_span().subspan(offset, count);
+  }
+
+  // Hints for count elements starting at offset
+  std::error_code advise(map_advice advice, size_type offset = 0, size_type count = dynamic_extent) const {
+    DD_SPAN_EXPECT(offset <= size());
+    return file_.advise(advice, offset * sizeof(element_type),
+                        count == dynamic_extent ? dynamic_extent : count * sizeof(element_type));
+  }
+  std::error_code flush() const noexcept { return file_.flush(); }
+
+  const mapped_file &file() const noexcept { return file_; }
+
+private:
+  static constexpr map_access default_access() noexcept {
+    return std::is_const<element_type>::value ? map_access::read_only : map_access::read_write;
+  }
+
+  std::error_code open(const std::string &path, size_type offset, size_type count) noexcept {
+    const size_type max_count = dynamic_extent / sizeof(element_type);
+    if (offset > max_count || (count != dynamic_extent && count > max_count)) {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    std::error_code ec;
+    mapped_file file(path, default_access(), offset * sizeof(element_type),
+                     count == dynamic_extent ? dynamic_extent : count * sizeof(element_type), ec);
+    return ec ? ec : adopt(std::move(file));
+  }
+
+  std::error_code adopt(mapped_file file) noexcept {
+    const std::size_t addr = reinterpret_cast<std::size_t>(file.data());
+    if (file.size() % sizeof(element_type) != 0 || addr % alignof(element_type) != 0 ||
+        (!std::is_const<element_type>::value && !file.writable())) {
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    file_ = std::move(file);
+    return std::error_code();
+  }
+
+  mapped_file file_;
+};
+
+} // namespace DD_SPAN_NAMESPACE_NAME
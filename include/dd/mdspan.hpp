@@ -0,0 +1,544 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "span.hpp"
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+template <typename IndexType, std::size_t... Extents> class extents;
+
+namespace detail {
+
+// Per-dimension storage: static extents occupy no space, dynamic ones store a single index (see span_storage)
+template <std::size_t I, typename IndexType, std::size_t E> struct extent_storage {
+  DD_SPAN_API constexpr extent_storage() noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit extent_storage(IndexType p_value) {
+    DD_SPAN_EXPECT(static_cast<std::size_t>(p_value) == E);
+    (void)p_value;
+  }
+  DD_SPAN_API static constexpr IndexType get() noexcept { return static_cast<IndexType>(E); }
+};
+
+template <std::size_t I, typename IndexType> struct extent_storage<I, IndexType, dynamic_extent> {
+  DD_SPAN_API constexpr extent_storage() noexcept = default;
+  DD_SPAN_API constexpr explicit extent_storage(IndexType p_value) noexcept : value(p_value) {}
+  DD_SPAN_API constexpr IndexType get() const noexcept { return value; }
+  IndexType value = 0;
+};
+
+template <typename IndexType, typename Seq, std::size_t... Extents> struct extents_base;
+template <typename IndexType, std::size_t... I, std::size_t... Extents>
+struct extents_base<IndexType, std::index_sequence<I...>, Extents...> : extent_storage<I, IndexType, Extents>... {
+  DD_SPAN_API constexpr extents_base() noexcept = default;
+  template <typename... Idx>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit extents_base(Idx... exts)
+      : extent_storage<I, IndexType, Extents>(static_cast<IndexType>(exts))... {}
+};
+
+template <std::size_t... Extents> DD_SPAN_API constexpr std::size_t count_dynamic(std::size_t n) noexcept {
+  const std::size_t exts[] = {Extents..., 0};
+  std::size_t count = 0;
+  for (std::size_t r = 0; r < n; ++r) {
+    count += exts[r] == dynamic_extent ? 1 : 0;
+  }
+  return count;
+}
+
+template <std::size_t I, std::size_t E, std::size_t... Es> struct nth_extent : nth_extent<I - 1, Es...> {};
+template <std::size_t E, std::size_t... Es> struct nth_extent<0, E, Es...> : std::integral_constant<std::size_t, E> {};
+
+template <typename IndexType, std::size_t Rank, typename = std::make_index_sequence<Rank>> struct make_dextents;
+template <typename IndexType, std::size_t Rank, std::size_t... I>
+struct make_dextents<IndexType, Rank, std::index_sequence<I...>> {
+  template <std::size_t> using dyn = std::integral_constant<std::size_t, dynamic_extent>;
+  using type = extents<IndexType, dyn<I>::value...>;
+};
+
+template <typename...> struct all_convertible : std::true_type {};
+template <typename To, typename T, typename... Ts>
+struct all_convertible<To, T, Ts...>
+    : std::integral_constant<bool, std::is_convertible<T, To>::value && all_convertible<To, Ts...>::value> {};
+
+// Offset recursions: unrolled at compile time so that static extents fold into constant strides
+template <std::size_t I, std::size_t Rank> struct layout_right_offset {
+  template <typename Ext, typename... Idx>
+  DD_SPAN_API static constexpr typename Ext::index_type apply(const Ext &e, typename Ext::index_type acc,
+                                                              typename Ext::index_type i, Idx... rest) noexcept {
+    return layout_right_offset<I + 1, Rank>::apply(e, acc * e.template static_or_dynamic_extent<I>() + i, rest...);
+  }
+};
+template <std::size_t Rank> struct layout_right_offset<Rank, Rank> {
+  template <typename Ext>
+  DD_SPAN_API static constexpr typename Ext::index_type apply(const Ext &, typename Ext::index_type acc) noexcept {
+    return acc;
+  }
+};
+
+template <std::size_t I, std::size_t Rank> struct layout_left_offset {
+  template <typename Ext, typename... Idx>
+  DD_SPAN_API static constexpr typename Ext::index_type apply(const Ext &e, typename Ext::index_type i,
+                                                              Idx... rest) noexcept {
+    return i + e.template static_or_dynamic_extent<I>() * layout_left_offset<I + 1, Rank>::apply(e, rest...);
+  }
+};
+template <std::size_t Rank> struct layout_left_offset<Rank, Rank> {
+  template <typename Ext> DD_SPAN_API static constexpr typename Ext::index_type apply(const Ext &) noexcept {
+    return 0;
+  }
+};
+
+template <typename Ext, std::size_t... I, typename... Idx>
+DD_SPAN_API constexpr bool in_bounds(const Ext &e, std::index_sequence<I...>, Idx... idx) noexcept {
+  const bool checks[] = {true, (static_cast<std::size_t>(idx) <
+                                static_cast<std::size_t>(e.template static_or_dynamic_extent<I>()))...};
+  bool ok = true;
+  for (bool c : checks) {
+    ok = ok && c;
+  }
+  return ok;
+}
+
+} // namespace detail
+
+// extents
+
+template <typename IndexType, std::size_t... Extents>
+class extents : private detail::extents_base<IndexType, std::make_index_sequence<sizeof...(Extents)>, Extents...> {
+  static_assert(std::is_integral<IndexType>::value, "IndexType must be integral");
+  using base_type = detail::extents_base<IndexType, std::make_index_sequence<sizeof...(Extents)>, Extents...>;
+
+  template <std::size_t I> using static_at = detail::nth_extent<I, Extents...>;
+  template <std::size_t I> using storage_type = detail::extent_storage<I, IndexType, static_at<I>::value>;
+
+public:
+  using index_type = IndexType;
+  using size_type = typename std::make_unsigned<IndexType>::type;
+  using rank_type = std::size_t;
+
+  DD_SPAN_API static constexpr rank_type rank() noexcept { return sizeof...(Extents); }
+  DD_SPAN_API static constexpr rank_type rank_dynamic() noexcept {
+    return detail::count_dynamic<Extents...>(sizeof...(Extents));
+  }
+  DD_SPAN_API static constexpr std::size_t static_extent(rank_type r) noexcept {
+    return std::array<std::size_t, sizeof...(Extents) + 1>{{Extents..., 0}}[r];
+  }
+
+  // constructors
+  DD_SPAN_API constexpr extents() noexcept = default;
+
+  // Either one value per dimension (static ones are checked) or one value per dynamic dimension
+  template <typename... Idx,
+            typename std::enable_if<sizeof...(Idx) != 0 && sizeof...(Idx) == sizeof...(Extents) &&
+                                        detail::all_convertible<IndexType, Idx...>::value,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit extents(Idx... exts) : base_type(exts...) {}
+  template <typename... Idx,
+            typename std::enable_if<sizeof...(Idx) != 0 && sizeof...(Idx) != sizeof...(Extents) &&
+                                        sizeof...(Idx) == detail::count_dynamic<Extents...>(sizeof...(Extents)) &&
+                                        detail::all_convertible<IndexType, Idx...>::value,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit extents(Idx... exts)
+      : extents(std::make_index_sequence<sizeof...(Extents)>{},
+                std::array<IndexType, sizeof...(Idx)>{{static_cast<IndexType>(exts)...}}) {}
+  template <typename OtherIndexType, std::size_t N,
+            typename std::enable_if<(N == sizeof...(Extents) ||
+                                     N == detail::count_dynamic<Extents...>(sizeof...(Extents))) &&
+                                        std::is_convertible<OtherIndexType, IndexType>::value,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit extents(const std::array<OtherIndexType, N> &exts)
+      : extents(std::make_index_sequence<sizeof...(Extents)>{}, exts, std::integral_constant<bool, N == rank()>{}) {}
+
+  // observers
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_type extent(rank_type r) const noexcept {
+    return extent_seq(r, std::make_index_sequence<sizeof...(Extents)>{});
+  }
+
+  // Compile-time indexed access, folds to a constant for static dimensions
+  template <std::size_t I> DD_SPAN_API constexpr index_type static_or_dynamic_extent() const noexcept {
+    return static_cast<const storage_type<I> &>(*this).get();
+  }
+
+  template <typename OtherIndexType, std::size_t... OtherExtents>
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 friend bool operator==(const extents &lhs,
+                                                         const extents<OtherIndexType, OtherExtents...> &rhs) noexcept {
+    if (lhs.rank() != rhs.rank()) {
+      return false;
+    }
+    for (rank_type r = 0; r < lhs.rank(); ++r) {
+      if (static_cast<std::size_t>(lhs.extent(r)) != static_cast<std::size_t>(rhs.extent(r))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  template <typename OtherIndexType, std::size_t... OtherExtents>
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 friend bool operator!=(const extents &lhs,
+                                                         const extents<OtherIndexType, OtherExtents...> &rhs) noexcept {
+    return !(lhs == rhs);
+  }
+
+private:
+  template <std::size_t... I, typename Array>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 extents(std::index_sequence<I...>, const Array &dyn)
+      : base_type((static_at<I>::value == dynamic_extent
+                       ? static_cast<IndexType>(dyn[detail::count_dynamic<Extents...>(I)])
+                       : static_cast<IndexType>(static_at<I>::value))...) {}
+  template <std::size_t... I, typename Array>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 extents(std::index_sequence<I...> seq, const Array &exts, std::false_type)
+      : extents(seq, exts) {}
+  template <std::size_t... I, typename Array>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 extents(std::index_sequence<I...>, const Array &exts, std::true_type)
+      : base_type(static_cast<IndexType>(exts[I])...) {}
+
+  template <std::size_t... I>
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_type extent_seq(rank_type r, std::index_sequence<I...>) const noexcept {
+    const index_type exts[] = {static_or_dynamic_extent<I>()..., 0};
+    return exts[r];
+  }
+};
+
+template <typename IndexType, std::size_t Rank>
+using dextents = typename detail::make_dextents<IndexType, Rank>::type;
+
+// layouts
+
+struct layout_right {
+  template <typename Extents> class mapping;
+};
+struct layout_left {
+  template <typename Extents> class mapping;
+};
+struct layout_stride {
+  template <typename Extents> class mapping;
+};
+
+template <typename Extents> class layout_right::mapping : private Extents {
+public:
+  using extents_type = Extents;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using layout_type = layout_right;
+
+  DD_SPAN_API constexpr mapping() noexcept = default;
+  DD_SPAN_API constexpr mapping(const extents_type &exts) noexcept : extents_type(exts) {}
+
+  DD_SPAN_API constexpr const extents_type &extents() const noexcept { return *this; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_type required_span_size() const noexcept {
+    index_type size = 1;
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      size *= extents().extent(r);
+    }
+    return size;
+  }
+
+  template <typename... Idx, typename std::enable_if<sizeof...(Idx) == Extents::rank(), int>::type = 0>
+  DD_SPAN_API constexpr index_type operator()(Idx... idx) const noexcept {
+    return offset(static_cast<index_type>(idx)...);
+  }
+
+  DD_SPAN_API static constexpr bool is_always_unique() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_always_exhaustive() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_always_strided() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_unique() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_exhaustive() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_strided() noexcept { return true; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_type stride(rank_type r) const noexcept {
+    index_type value = 1;
+    for (rank_type k = r + 1; k < extents_type::rank(); ++k) {
+      value *= extents().extent(k);
+    }
+    return value;
+  }
+
+private:
+  DD_SPAN_API constexpr index_type offset() const noexcept { return 0; }
+  template <typename... Idx> DD_SPAN_API constexpr index_type offset(index_type i, Idx... rest) const noexcept {
+    return detail::layout_right_offset<1, extents_type::rank()>::apply(extents(), i, rest...);
+  }
+};
+
+template <typename Extents> class layout_left::mapping : private Extents {
+public:
+  using extents_type = Extents;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using layout_type = layout_left;
+
+  DD_SPAN_API constexpr mapping() noexcept = default;
+  DD_SPAN_API constexpr mapping(const extents_type &exts) noexcept : extents_type(exts) {}
+
+  DD_SPAN_API constexpr const extents_type &extents() const noexcept { return *this; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_type required_span_size() const noexcept {
+    index_type size = 1;
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      size *= extents().extent(r);
+    }
+    return size;
+  }
+
+  template <typename... Idx, typename std::enable_if<sizeof...(Idx) == Extents::rank(), int>::type = 0>
+  DD_SPAN_API constexpr index_type operator()(Idx... idx) const noexcept {
+    return detail::layout_left_offset<0, extents_type::rank()>::apply(extents(), static_cast<index_type>(idx)...);
+  }
+
+  DD_SPAN_API static constexpr bool is_always_unique() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_always_exhaustive() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_always_strided() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_unique() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_exhaustive() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_strided() noexcept { return true; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_type stride(rank_type r) const noexcept {
+    index_type value = 1;
+    for (rank_type k = 0; k < r; ++k) {
+      value *= extents().extent(k);
+    }
+    return value;
+  }
+};
+
+template <typename Extents> class layout_stride::mapping : private Extents {
+public:
+  using extents_type = Extents;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using layout_type = layout_stride;
+  using strides_type = std::array<index_type, extents_type::rank()>;
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 mapping() noexcept : mapping(layout_right::mapping<extents_type>()) {}
+  template <typename OtherIndexType>
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 mapping(const extents_type &exts,
+                                          const std::array<OtherIndexType, extents_type::rank()> &strides) noexcept
+      : extents_type(exts), strides_() {
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      strides_[r] = static_cast<index_type>(strides[r]);
+    }
+  }
+  // Any other strided mapping over the same extents
+  template <typename StridedMapping,
+            typename std::enable_if<std::is_same<typename StridedMapping::extents_type, extents_type>::value &&
+                                        StridedMapping::is_always_strided() &&
+                                        !std::is_same<StridedMapping, mapping>::value,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 mapping(const StridedMapping &other) noexcept
+      : extents_type(other.extents()), strides_() {
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      strides_[r] = other.stride(r);
+    }
+  }
+
+  DD_SPAN_API constexpr const extents_type &extents() const noexcept { return *this; }
+  DD_SPAN_API constexpr const strides_type &strides() const noexcept { return strides_; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_type required_span_size() const noexcept {
+    index_type size = 1;
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      if (extents().extent(r) == 0) {
+        return 0;
+      }
+      size += (extents().extent(r) - 1) * strides_[r];
+    }
+    return size;
+  }
+
+  template <typename... Idx, typename std::enable_if<sizeof...(Idx) == Extents::rank(), int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 index_type operator()(Idx... idx) const noexcept {
+    const index_type indices[] = {static_cast<index_type>(idx)..., 0};
+    index_type offset = 0;
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      offset += indices[r] * strides_[r];
+    }
+    return offset;
+  }
+
+  DD_SPAN_API static constexpr bool is_always_unique() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_always_exhaustive() noexcept { return false; }
+  DD_SPAN_API static constexpr bool is_always_strided() noexcept { return true; }
+  DD_SPAN_API static constexpr bool is_unique() noexcept { return true; }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 bool is_exhaustive() const noexcept {
+    index_type size = 1;
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      size *= extents().extent(r);
+    }
+    return required_span_size() == size;
+  }
+  DD_SPAN_API static constexpr bool is_strided() noexcept { return true; }
+
+  DD_SPAN_API constexpr index_type stride(rank_type r) const noexcept { return strides_[r]; }
+
+private:
+  strides_type strides_;
+};
+
+namespace detail {
+
+// Pointer plus mapping; empty mappings (fully static extents) cost nothing
+template <typename E, typename M> struct mdspan_storage : M {
+  DD_SPAN_API constexpr mdspan_storage() noexcept = default;
+  DD_SPAN_API constexpr mdspan_storage(E *p_ptr, const M &p_map) noexcept : M(p_map), ptr(p_ptr) {}
+  E *ptr = nullptr;
+};
+
+} // namespace detail
+
+// mdspan class
+
+template <typename ElementType, typename Extents, typename LayoutPolicy = layout_right> class mdspan {
+  static_assert(std::is_object<ElementType>::value, "ElementType must be object");
+  static_assert(!std::is_abstract<ElementType>::value, "ElementType cannot be abstract");
+
+public:
+  using extents_type = Extents;
+  using layout_type = LayoutPolicy;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
+  using element_type = ElementType;
+  using value_type = typename std::remove_cv<ElementType>::type;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using data_handle_type = element_type *;
+  using reference = element_type &;
+
+  DD_SPAN_API static constexpr rank_type rank() noexcept { return extents_type::rank(); }
+  DD_SPAN_API static constexpr rank_type rank_dynamic() noexcept { return extents_type::rank_dynamic(); }
+  DD_SPAN_API static constexpr std::size_t static_extent(rank_type r) noexcept {
+    return extents_type::static_extent(r);
+  }
+
+  // constructors
+  DD_SPAN_API constexpr mdspan() noexcept = default;
+
+  template <typename... Idx,
+            typename std::enable_if<(sizeof...(Idx) == extents_type::rank() ||
+                                     sizeof...(Idx) == extents_type::rank_dynamic()) &&
+                                        detail::all_convertible<index_type, Idx...>::value,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit mdspan(data_handle_type ptr, Idx... exts)
+      : storage_(ptr, mapping_type(extents_type(static_cast<index_type>(exts)...))) {}
+  DD_SPAN_API constexpr mdspan(data_handle_type ptr, const extents_type &exts) : storage_(ptr, mapping_type(exts)) {}
+  DD_SPAN_API constexpr mdspan(data_handle_type ptr, const mapping_type &map) : storage_(ptr, map) {}
+
+  // Views over an existing span, which must cover the whole mapping
+  template <typename U, std::size_t N, typename... Idx,
+            typename std::enable_if<std::is_convertible<U (*)[], ElementType (*)[]>::value &&
+                                        (sizeof...(Idx) == extents_type::rank() ||
+                                         sizeof...(Idx) == extents_type::rank_dynamic()) &&
+                                        detail::all_convertible<index_type, Idx...>::value,
+                                    int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit mdspan(span<U, N> s, Idx... exts)
+      : mdspan(s, mapping_type(extents_type(static_cast<index_type>(exts)...))) {}
+  template <typename U, std::size_t N,
+            typename std::enable_if<std::is_convertible<U (*)[], ElementType (*)[]>::value, int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 mdspan(span<U, N> s, const mapping_type &map) : storage_(s.data(), map) {
+    DD_SPAN_EXPECT(static_cast<std::size_t>(map.required_span_size()) <= s.size());
+  }
+
+  template <typename U, typename OtherExtents,
+            typename std::enable_if<std::is_convertible<U (*)[], ElementType (*)[]>::value &&
+                                        std::is_same<OtherExtents, extents_type>::value,
+                                    int>::type = 0>
+  DD_SPAN_API constexpr mdspan(const mdspan<U, OtherExtents, LayoutPolicy> &other) noexcept
+      : storage_(other.data_handle(), other.mapping()) {}
+
+  DD_SPAN_API constexpr mdspan(const mdspan &other) noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR_ASSIGN mdspan &operator=(const mdspan &other) noexcept = default;
+  DD_SPAN_API ~mdspan() noexcept = default;
+
+  // element access
+  template <typename... Idx, typename std::enable_if<sizeof...(Idx) == extents_type::rank() &&
+                                                         detail::all_convertible<index_type, Idx...>::value,
+                                                     int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference operator()(Idx... idx) const {
+    DD_SPAN_EXPECT(detail::in_bounds(extents(), std::make_index_sequence<sizeof...(Idx)>{}, idx...));
+    return data_handle()[mapping()(static_cast<index_type>(idx)...)];
+  }
+  template <typename OtherIndexType>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference
+  operator()(const std::array<OtherIndexType, extents_type::rank()> &idx) const {
+    return index_array(idx, std::make_index_sequence<extents_type::rank()>{});
+  }
+
+  // observers
+  DD_SPAN_API constexpr data_handle_type data_handle() const noexcept { return storage_.ptr; }
+  DD_SPAN_API constexpr const mapping_type &mapping() const noexcept { return storage_; }
+  DD_SPAN_API constexpr const extents_type &extents() const noexcept { return mapping().extents(); }
+  DD_SPAN_API constexpr index_type extent(rank_type r) const noexcept { return extents().extent(r); }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 size_type size() const noexcept {
+    size_type size = 1;
+    for (rank_type r = 0; r < rank(); ++r) {
+      size *= static_cast<size_type>(extent(r));
+    }
+    return size;
+  }
+  DD_SPAN_API DD_SPAN_NODISCARD DD_SPAN_CONSTEXPR14 bool empty() const noexcept { return size() == 0; }
+  DD_SPAN_API constexpr index_type stride(rank_type r) const { return mapping().stride(r); }
+
+  DD_SPAN_API static constexpr bool is_always_unique() { return mapping_type::is_always_unique(); }
+  DD_SPAN_API static constexpr bool is_always_exhaustive() { return mapping_type::is_always_exhaustive(); }
+  DD_SPAN_API static constexpr bool is_always_strided() { return mapping_type::is_always_strided(); }
+  DD_SPAN_API constexpr bool is_unique() const { return mapping().is_unique(); }
+  DD_SPAN_API constexpr bool is_exhaustive() const { return mapping().is_exhaustive(); }
+  DD_SPAN_API constexpr bool is_strided() const { return mapping().is_strided(); }
+
+private:
+  template <typename Array, std::size_t... I>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference index_array(const Array &idx, std::index_sequence<I...>) const {
+    return (*this)(idx[I]...);
+  }
+
+  detail::mdspan_storage<element_type, mapping_type> storage_;
+};
+
+#ifdef DD_SPAN_HAVE_DEDUCTION_GUIDES
+template <class T, class... Integrals,
+          typename std::enable_if<sizeof...(Integrals) != 0 &&
+                                      detail::all_convertible<std::size_t, Integrals...>::value,
+                                  int>::type = 0>
+DD_SPAN_API mdspan(T *, Integrals...) -> mdspan<T, dextents<std::size_t, sizeof...(Integrals)>>;
+template <class T, std::size_t N, class... Integrals,
+          typename std::enable_if<sizeof...(Integrals) != 0 &&
+                                      detail::all_convertible<std::size_t, Integrals...>::value,
+                                  int>::type = 0>
+DD_SPAN_API mdspan(span<T, N>, Integrals...) -> mdspan<T, dextents<std::size_t, sizeof...(Integrals)>>;
+template <class T, class IndexType, std::size_t... Extents>
+DD_SPAN_API mdspan(T *, const extents<IndexType, Extents...> &) -> mdspan<T, extents<IndexType, Extents...>>;
+template <class T, class Mapping>
+DD_SPAN_API mdspan(T *, const Mapping &)
+    -> mdspan<T, typename Mapping::extents_type, typename Mapping::layout_type>;
+#endif
+
+} // namespace DD_SPAN_NAMESPACE_NAME
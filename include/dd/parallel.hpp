@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only parallel algorithms over spans. Each span is cut into contiguous tiles (see chunks.hpp) that run as
+// tasks on a thread_pool; results that combine tiles do so in tile order, so they do not depend on scheduling.
+
+#include "chunks.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+// Smallest number of elements worth a task of its own
+DD_SPAN_INLINE_VAR constexpr std::size_t parallel_grain = 4096;
+
+namespace detail {
+
+// A few tiles per thread so that stealing can even out imbalanced work
+inline std::size_t parallel_tiles(const thread_pool &pool, std::size_t n) noexcept {
+  const std::size_t by_grain = (n + parallel_grain - 1) / parallel_grain;
+  const std::size_t by_threads = pool.concurrency() * 4;
+  const std::size_t tiles = by_grain < by_threads ? by_grain : by_threads;
+  return tiles == 0 ? 1 : tiles;
+}
+
+} // namespace detail
+
+// f(element) for every element
+template <typename ET, std::size_t E, typename F> void parallel_for(thread_pool &pool, span<ET, E> s, F f) {
+  const auto parts = tiles(span<ET>(s), detail::parallel_tiles(pool, s.size()));
+  pool.run(parts.size(), [&](std::size_t t) {
+    for (ET &x : parts[t]) {
+      f(x);
+    }
+  });
+}
+template <typename ET, std::size_t E, typename F> void parallel_for(span<ET, E> s, F f) {
+  parallel_for(default_thread_pool(), s, f);
+}
+
+// out[i] = f(in[i])
+template <typename T, std::size_t E1, typename U, std::size_t E2, typename F>
+void parallel_transform(thread_pool &pool, span<T, E1> in, span<U, E2> out, F f) {
+  DD_SPAN_EXPECT(in.size() == out.size());
+  const auto parts = tiles(span<T>(in), detail::parallel_tiles(pool, in.size()));
+  pool.run(parts.size(), [&](std::size_t t) {
+    const span<T> src = parts[t];
+    U *dst = out.data() + (src.data() - in.data());
+    for (std::size_t i = 0; i < src.size(); ++i) {
+      dst[i] = f(src[i]);
+    }
+  });
+}
+template <typename T, std::size_t E1, typename U, std::size_t E2, typename F>
+void parallel_transform(span<T, E1> in, span<U, E2> out, F f) {
+  parallel_transform(default_thread_pool(), in, out, f);
+}
+
+// op(...op(op(init, s[0]), s[1])..., s[n-1]) with op associative; tiles are folded separately, then in order
+template <typename ET, std::size_t E, typename R, typename Op>
+R parallel_reduce(thread_pool &pool, span<ET, E> s, R init, Op op) {
+  const auto parts = tiles(span<ET>(s), detail::parallel_tiles(pool, s.size()));
+  std::vector<R> partial(parts.size(), R());
+  std::vector<char> used(parts.size(), 0);
+  pool.run(parts.size(), [&](std::size_t t) {
+    const span<ET> part = parts[t];
+    if (part.empty()) {
+      return;
+    }
+    R acc = part[0];
+    for (std::size_t i = 1; i < part.size(); ++i) {
+      acc = op(acc, part[i]);
+    }
+    partial[t] = acc;
+    used[t] = 1;
+  });
+  for (std::size_t t = 0; t < parts.size(); ++t) {
+    if (used[t]) {
+      init = op(init, partial[t]);
+    }
+  }
+  return init;
+}
+template <typename ET, std::size_t E, typename R, typename Op> R parallel_reduce(span<ET, E> s, R init, Op op) {
+  return parallel_reduce(default_thread_pool(), s, init, op);
+}
+template <typename ET, std::size_t E, typename R> R parallel_reduce(span<ET, E> s, R init) {
+  return parallel_reduce(default_thread_pool(), s, init, std::plus<R>());
+}
+
+// out[i] = in[0] op ... op in[i]; in and out may be the same span. Three passes: per-tile totals, a serial scan
+// of the totals, then per-tile scans seeded with the preceding total.
+template <typename T, std::size_t E1, typename U, std::size_t E2, typename Op>
+void parallel_inclusive_scan(thread_pool &pool, span<T, E1> in, span<U, E2> out, Op op) {
+  DD_SPAN_EXPECT(in.size() == out.size());
+  using value_type = typename std::remove_cv<U>::type;
+  const auto parts = tiles(span<T>(in), detail::parallel_tiles(pool, in.size()));
+  std::vector<value_type> totals(parts.size(), value_type());
+  pool.run(parts.size(), [&](std::size_t t) {
+    const span<T> part = parts[t];
+    if (part.empty()) {
+      return;
+    }
+    value_type acc = part[0];
+    for (std::size_t i = 1; i < part.size(); ++i) {
+      acc = op(acc, part[i]);
+    }
+    totals[t] = acc;
+  });
+  for (std::size_t t = 1; t < parts.size(); ++t) {
+    if (!parts[t].empty()) {
+      totals[t] = op(totals[t - 1], totals[t]);
+    } else {
+      totals[t] = totals[t - 1];
+    }
+  }
+  pool.run(parts.size(), [&](std::size_t t) {
+    const span<T> src = parts[t];
+    if (src.empty()) {
+      return;
+    }
+    U *dst = out.data() + (src.data() - in.data());
+    value_type acc = t == 0 ? value_type(src[0]) : op(totals[t - 1], src[0]);
+    dst[0] = acc;
+    for (std::size_t i = 1; i < src.size(); ++i) {
+      acc = op(acc, src[i]);
+      dst[i] = acc;
+    }
+  });
+}
+template <typename T, std::size_t E1, typename U, std::size_t E2, typename Op>
+void parallel_inclusive_scan(span<T, E1> in, span<U, E2> out, Op op) {
+  parallel_inclusive_scan(default_thread_pool(), in, out, op);
+}
+template <typename T, std::size_t E1, typename U, std::size_t E2>
+void parallel_inclusive_scan(span<T, E1> in, span<U, E2> out) {
+  parallel_inclusive_scan(default_thread_pool(), in, out, std::plus<typename std::remove_cv<U>::type>());
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
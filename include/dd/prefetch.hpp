@@ -0,0 +1,309 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Iteration adapters that prefetch ahead of the cursor. prefetched(s, distance) and streaming(s) walk a span in
+// order and prefetch the element distance positions ahead, once per cache line; gathered(values, indices) walks
+// values[indices[i]] and prefetches the value the index distance positions ahead names. The element iterators keep
+// the compiler from vectorizing the loop body; for_each(view, f) prefetches per block and does not. Hardware
+// prefetchers already follow plain scans, so the best distance (or none) depends on the machine: PrefetchBenchmarks
+// sweeps it. Prefetches are hints: they never fault and compile to nothing in device code and on compilers without
+// a prefetch builtin.
+
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+// Default distance of the sequential adapters, in bytes
+#ifndef DD_SPAN_PREFETCH_DISTANCE_BYTES
+#define DD_SPAN_PREFETCH_DISTANCE_BYTES 1024
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+enum class prefetch_access { read, write };
+
+// How long the line should stay cached: none is non-temporal, high keeps it in every level
+enum class prefetch_locality { none, low, moderate, high };
+
+template <prefetch_access Access = prefetch_access::read, prefetch_locality Locality = prefetch_locality::high>
+DD_SPAN_API inline void prefetch(const void *p) noexcept {
+#if defined(__CUDA_ARCH__)
+  (void)p;
+#elif defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(p, Access == prefetch_access::write ? 1 : 0, static_cast<int>(Locality));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char *>(p), Locality == prefetch_locality::none       ? _MM_HINT_NTA
+                                             : Locality == prefetch_locality::low      ? _MM_HINT_T2
+                                             : Locality == prefetch_locality::moderate ? _MM_HINT_T1
+                                                                                       : _MM_HINT_T0);
+#else
+  (void)p;
+#endif
+}
+
+namespace detail {
+
+DD_SPAN_INLINE_VAR constexpr std::size_t prefetch_line_bytes = 64;
+
+template <typename T> DD_SPAN_API constexpr std::size_t default_prefetch_distance() noexcept {
+  return DD_SPAN_PREFETCH_DISTANCE_BYTES / sizeof(T) == 0 ? 1 : DD_SPAN_PREFETCH_DISTANCE_BYTES / sizeof(T);
+}
+
+template <typename T, prefetch_access Access, prefetch_locality Locality> class prefetch_iterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename std::remove_cv<T>::type;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using pointer = T *;
+
+  DD_SPAN_API constexpr prefetch_iterator() noexcept = default;
+  DD_SPAN_API constexpr prefetch_iterator(T *p, T *end, std::size_t distance) noexcept
+      : p_(p), mark_(static_cast<std::size_t>(end - p) > line_elements ? p + line_elements : end), end_(end),
+        distance_(distance) {}
+
+  DD_SPAN_API constexpr reference operator*() const noexcept { return *p_; }
+  DD_SPAN_API constexpr pointer operator->() const noexcept { return p_; }
+
+  // Prefetches once per cache line of elements, when the cursor reaches the next line mark
+  DD_SPAN_API prefetch_iterator &operator++() noexcept {
+    if (++p_ == mark_) {
+      mark_ = static_cast<std::size_t>(end_ - p_) > line_elements ? p_ + line_elements : end_;
+      if (distance_ < static_cast<std::size_t>(end_ - p_)) {
+        prefetch<Access, Locality>(p_ + distance_);
+      }
+    }
+    return *this;
+  }
+  DD_SPAN_API prefetch_iterator operator++(int) noexcept {
+    prefetch_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  DD_SPAN_API constexpr friend bool operator==(const prefetch_iterator &lhs, const prefetch_iterator &rhs) noexcept {
+    return lhs.p_ == rhs.p_;
+  }
+  DD_SPAN_API constexpr friend bool operator!=(const prefetch_iterator &lhs, const prefetch_iterator &rhs) noexcept {
+    return lhs.p_ != rhs.p_;
+  }
+
+private:
+  static constexpr std::size_t line_elements =
+      prefetch_line_bytes / sizeof(T) == 0 ? 1 : prefetch_line_bytes / sizeof(T);
+
+  T *p_ = nullptr;
+  T *mark_ = nullptr; // where the next prefetch is issued
+  T *end_ = nullptr;
+  std::size_t distance_ = 0;
+};
+
+template <typename T, typename Index> class gather_iterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename std::remove_cv<T>::type;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using pointer = T *;
+
+  DD_SPAN_API constexpr gather_iterator() noexcept = default;
+  DD_SPAN_API constexpr gather_iterator(span<T> values, const Index *idx, const Index *end,
+                                        std::size_t distance) noexcept
+      : values_(values), idx_(idx), end_(end), distance_(distance) {}
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference operator*() const { return values_[static_cast<std::size_t>(*idx_)]; }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 pointer operator->() const { return &**this; }
+  // Position in the index span
+  DD_SPAN_API constexpr const Index *index() const noexcept { return idx_; }
+
+  DD_SPAN_API gather_iterator &operator++() noexcept {
+    ++idx_;
+    if (distance_ < static_cast<std::size_t>(end_ - idx_)) {
+      const std::size_t ahead = static_cast<std::size_t>(idx_[distance_]);
+      if (ahead < values_.size()) {
+        prefetch(values_.data() + ahead);
+      }
+    }
+    return *this;
+  }
+  DD_SPAN_API gather_iterator operator++(int) noexcept {
+    gather_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  DD_SPAN_API constexpr friend bool operator==(const gather_iterator &lhs, const gather_iterator &rhs) noexcept {
+    return lhs.idx_ == rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator!=(const gather_iterator &lhs, const gather_iterator &rhs) noexcept {
+    return lhs.idx_ != rhs.idx_;
+  }
+
+private:
+  span<T> values_;
+  const Index *idx_ = nullptr;
+  const Index *end_ = nullptr;
+  std::size_t distance_ = 0;
+};
+
+} // namespace detail
+
+// The elements of a span in order, prefetching distance elements ahead
+
+template <typename T, prefetch_access Access = prefetch_access::read,
+          prefetch_locality Locality = prefetch_locality::high>
+class prefetched_view {
+public:
+  using element_type = T;
+  using value_type = typename std::remove_cv<T>::type;
+  using size_type = std::size_t;
+  using iterator = detail::prefetch_iterator<T, Access, Locality>;
+
+  DD_SPAN_API constexpr prefetched_view() noexcept = default;
+  DD_SPAN_API constexpr prefetched_view(span<T> s, size_type distance) noexcept : span_(s), distance_(distance) {}
+
+  DD_SPAN_API constexpr size_type size() const noexcept { return span_.size(); }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return span_.empty(); }
+  DD_SPAN_API constexpr size_type distance() const noexcept { return distance_; }
+  DD_SPAN_API constexpr span<T> base() const noexcept { return span_; }
+
+  // begin() prefetches the first distance elements, so the cursor does not start on a cold window
+  DD_SPAN_API iterator begin() const noexcept {
+    const size_type warm = distance_ < span_.size() ? distance_ : span_.size();
+    for (size_type i = 0; i < warm * sizeof(T); i += detail::prefetch_line_bytes) {
+      prefetch<Access, Locality>(reinterpret_cast<const char *>(span_.data()) + i);
+    }
+    return iterator(span_.data(), span_.data() + span_.size(), distance_);
+  }
+  DD_SPAN_API constexpr iterator end() const noexcept {
+    return iterator(span_.data() + span_.size(), span_.data() + span_.size(), distance_);
+  }
+
+private:
+  span<T> span_;
+  size_type distance_ = 0;
+};
+
+// values[indices[i]] for every index in order, prefetching the value distance indices ahead. Indices must be in
+// range when dereferenced; the prefetch skips out-of-range ones.
+
+template <typename T, typename Index> class gathered_view {
+public:
+  using element_type = T;
+  using value_type = typename std::remove_cv<T>::type;
+  using size_type = std::size_t;
+  using iterator = detail::gather_iterator<T, Index>;
+
+  DD_SPAN_API constexpr gathered_view() noexcept = default;
+  DD_SPAN_API constexpr gathered_view(span<T> values, span<const Index> indices, size_type distance) noexcept
+      : values_(values), indices_(indices), distance_(distance) {}
+
+  DD_SPAN_API constexpr size_type size() const noexcept { return indices_.size(); }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return indices_.empty(); }
+  DD_SPAN_API constexpr size_type distance() const noexcept { return distance_; }
+
+  DD_SPAN_API iterator begin() const noexcept {
+    const Index *first = indices_.data();
+    const size_type warm = distance_ < indices_.size() ? distance_ : indices_.size();
+    for (size_type i = 0; i < warm; ++i) {
+      if (static_cast<size_type>(first[i]) < values_.size()) {
+        prefetch(values_.data() + static_cast<size_type>(first[i]));
+      }
+    }
+    return iterator(values_, first, first + indices_.size(), distance_);
+  }
+  DD_SPAN_API constexpr iterator end() const noexcept {
+    return iterator(values_, indices_.data() + indices_.size(), indices_.data() + indices_.size(), distance_);
+  }
+
+private:
+  span<T> values_;
+  span<const Index> indices_;
+  size_type distance_ = 0;
+};
+
+namespace detail {
+
+// Lines per block of prefetched_view::for_each
+DD_SPAN_INLINE_VAR constexpr std::size_t prefetch_block_lines = 8;
+
+} // namespace detail
+
+// f(element) for every element of the view. Works a block of cache lines at a time: the lines distance elements
+// ahead of the block are prefetched, then a plain loop runs over the block, which the compiler can vectorize.
+template <typename T, prefetch_access Access, prefetch_locality Locality, typename F>
+DD_SPAN_API void for_each(const prefetched_view<T, Access, Locality> &view, F f) {
+  constexpr std::size_t line = detail::prefetch_line_bytes;
+  constexpr std::size_t block_bytes = detail::prefetch_block_lines * line;
+  constexpr std::size_t block = block_bytes / sizeof(T) == 0 ? 1 : block_bytes / sizeof(T);
+  const span<T> s = view.base();
+  T *p = s.data();
+  const std::size_t n = s.size();
+  const char *bytes = reinterpret_cast<const char *>(p);
+  const std::size_t ahead = view.distance() * sizeof(T);
+  for (std::size_t i = 0; i < n; i += block) {
+    const std::size_t count = n - i < block ? n - i : block;
+    const std::size_t from = i * sizeof(T) + ahead;
+    for (std::size_t b = 0; b < block_bytes && from + b < n * sizeof(T); b += line) {
+      prefetch<Access, Locality>(bytes + from + b);
+    }
+    for (std::size_t j = 0; j < count; ++j) {
+      f(p[i + j]);
+    }
+  }
+}
+
+// makers
+
+template <prefetch_access Access = prefetch_access::read, prefetch_locality Locality = prefetch_locality::high,
+          typename T, std::size_t E>
+DD_SPAN_API constexpr prefetched_view<T, Access, Locality>
+prefetched(span<T, E> s, std::size_t distance = detail::default_prefetch_distance<T>()) noexcept {
+  return prefetched_view<T, Access, Locality>(s, distance);
+}
+
+// A single pass over data that will not be reused soon: non-temporal prefetches keep it from displacing the
+// rest of the cache
+template <typename T, std::size_t E>
+DD_SPAN_API constexpr prefetched_view<T, prefetch_access::read, prefetch_locality::none>
+streaming(span<T, E> s, std::size_t distance = detail::default_prefetch_distance<T>()) noexcept {
+  return prefetched_view<T, prefetch_access::read, prefetch_locality::none>(s, distance);
+}
+
+template <typename T, std::size_t E1, typename Index, std::size_t E2>
+DD_SPAN_API constexpr gathered_view<T, typename std::remove_const<Index>::type>
+gathered(span<T, E1> values, span<Index, E2> indices, std::size_t distance = 16) noexcept {
+  return gathered_view<T, typename std::remove_const<Index>::type>(values, indices, distance);
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only bounded lock-free queues that hand out their storage as spans. A producer reserves up to n free slots,
+// fills them in place and commits them; a consumer peeks up to n filled slots, reads them in place and releases
+// them. A reservation is at most two spans, split where the storage wraps, so batches move with no per-element
+// synchronization and no copy through the queue.
+//
+// spsc_queue connects one producer thread to one consumer thread; each side owns one position counter. mpmc_queue
+// takes any number of both: threads claim runs of positions with a compare-exchange and each slot carries a
+// sequence number telling which lap it is on and whether it is full (the scheme of Vyukov's bounded MPMC queue,
+// applied to runs of slots). Elements stay contiguous so that reservations can be spans; the counters and every
+// sequence number get a cache-line aligned block of their own, so publishing never writes into element lines and
+// threads working on neighbouring slots do not share a line. That costs queue_padding bytes per slot.
+
+#include "buffer.hpp"
+#include "ring_span.hpp"
+#include "span.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+// Slots handed out by reserve() or peek(): the segments in queue order, plus where they start
+template <typename T> struct queue_reservation : ring_segments<T> {
+  std::uint64_t position = 0;
+};
+
+namespace detail {
+
+// Counters touched by different threads are this far apart: two cache lines, because x86's adjacent-line
+// prefetcher pulls lines in pairs
+DD_SPAN_INLINE_VAR constexpr std::size_t queue_padding = 128;
+
+template <typename T> struct alignas(queue_padding) padded_atomic {
+  std::atomic<T> value{T()};
+};
+
+template <typename T>
+queue_reservation<T> queue_region(T *data, std::size_t capacity, std::size_t start, std::size_t count,
+                                  std::uint64_t position) noexcept {
+  queue_reservation<T> r;
+  const std::size_t to_end = capacity - start;
+  r.first = span<T>(data + start, count < to_end ? count : to_end);
+  r.second = span<T>(data, count < to_end ? 0 : count - to_end);
+  r.position = position;
+  return r;
+}
+
+} // namespace detail
+
+template <typename T> class spsc_queue {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reservation = queue_reservation<T>;
+
+  explicit spsc_queue(size_type capacity) : slots_(capacity) { DD_SPAN_EXPECT(capacity != 0); }
+
+  spsc_queue(const spsc_queue &) = delete;
+  spsc_queue &operator=(const spsc_queue &) = delete;
+
+  size_type capacity() const noexcept { return slots_.size(); }
+  // Exact when neither side is running
+  size_type size_approx() const noexcept {
+    const size_type r = read_.value.load(std::memory_order_acquire);
+    return distance(write_.value.load(std::memory_order_acquire), r);
+  }
+
+  // Producer: up to n free slots, fewer (possibly none) when the queue is fuller
+  reservation reserve(size_type n) {
+    const size_type w = write_.value.load(std::memory_order_relaxed);
+    size_type free = capacity() - distance(w, producer_.cached_read);
+    if (free < n) {
+      producer_.cached_read = read_.value.load(std::memory_order_acquire);
+      free = capacity() - distance(w, producer_.cached_read);
+    }
+    producer_.reserved = n < free ? n : free;
+    return detail::queue_region(slots_.data(), capacity(), slot(w), producer_.reserved, w);
+  }
+  // Producer: publishes the first n slots of the last reservation
+  void commit(size_type n) {
+    DD_SPAN_EXPECT(n <= producer_.reserved);
+    producer_.reserved -= n;
+    write_.value.store(advance(write_.value.load(std::memory_order_relaxed), n), std::memory_order_release);
+  }
+  void commit(const reservation &r) { commit(r.size()); }
+
+  // Consumer: up to n filled slots, oldest first
+  reservation peek(size_type n) {
+    const size_type r = read_.value.load(std::memory_order_relaxed);
+    size_type used = distance(consumer_.cached_write, r);
+    if (used < n) {
+      consumer_.cached_write = write_.value.load(std::memory_order_acquire);
+      used = distance(consumer_.cached_write, r);
+    }
+    consumer_.peeked = n < used ? n : used;
+    return detail::queue_region(slots_.data(), capacity(), slot(r), consumer_.peeked, r);
+  }
+  // Consumer: hands the first n slots of the last peek back to the producer
+  void release(size_type n) {
+    DD_SPAN_EXPECT(n <= consumer_.peeked);
+    consumer_.peeked -= n;
+    read_.value.store(advance(read_.value.load(std::memory_order_relaxed), n), std::memory_order_release);
+  }
+  void release(const reservation &r) { release(r.size()); }
+
+  bool try_push(const T &value) {
+    const reservation r = reserve(1);
+    if (r.empty()) {
+      return false;
+    }
+    r.first[0] = value;
+    commit(1);
+    return true;
+  }
+  bool try_pop(T &out) {
+    const reservation r = peek(1);
+    if (r.empty()) {
+      return false;
+    }
+    out = std::move(r.first[0]);
+    release(1);
+    return true;
+  }
+
+private:
+  // Positions run over [0, 2 * capacity) so that a full queue differs from an empty one; wrapping them needs a
+  // compare, never a division
+  size_type slot(size_type pos) const noexcept { return pos < capacity() ? pos : pos - capacity(); }
+  size_type advance(size_type pos, size_type n) const noexcept {
+    pos += n;
+    return pos < 2 * capacity() ? pos : pos - 2 * capacity();
+  }
+  size_type distance(size_type to, size_type from) const noexcept {
+    return to >= from ? to - from : to + 2 * capacity() - from;
+  }
+
+  // Each side's cached copy of the other's counter sits with its own counter, away from the other side's
+  struct alignas(detail::queue_padding) producer_state {
+    size_type cached_read = 0;
+    size_type reserved = 0;
+  };
+  struct alignas(detail::queue_padding) consumer_state {
+    size_type cached_write = 0;
+    size_type peeked = 0;
+  };
+
+  buffer<T> slots_;
+  detail::padded_atomic<size_type> write_;
+  producer_state producer_;
+  detail::padded_atomic<size_type> read_;
+  consumer_state consumer_;
+};
+
+// The capacity is rounded up to a power of two. Positions are 64-bit and never wrap in practice.
+template <typename T> class mpmc_queue {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reservation = queue_reservation<T>;
+
+  explicit mpmc_queue(size_type capacity)
+      : slots_(round_up(capacity)), sequence_(slots_.size()), mask_(slots_.size() - 1) {
+    DD_SPAN_EXPECT(capacity != 0);
+    // Slot i starts empty for the producer of position i
+    for (size_type i = 0; i < slots_.size(); ++i) {
+      sequence(i).store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+
+  size_type capacity() const noexcept { return slots_.size(); }
+  // Exact when no thread is running
+  size_type size_approx() const noexcept {
+    const std::uint64_t r = read_.value.load(std::memory_order_acquire);
+    const std::uint64_t w = write_.value.load(std::memory_order_acquire);
+    return w > r ? static_cast<size_type>(w - r) : 0;
+  }
+
+  // Producer: claims up to n consecutive free slots, fewer (possibly none) when the queue is fuller. Every
+  // non-empty reservation must be committed, or consumers stall at its position.
+  reservation reserve(size_type n) { return claim(write_.value, n, 0); }
+  void commit(const reservation &r) { publish(r, 1); }
+
+  // Consumer: claims up to n consecutive filled slots; every non-empty reservation must be released
+  reservation peek(size_type n) { return claim(read_.value, n, 1); }
+  void release(const reservation &r) { publish(r, capacity()); }
+
+  bool try_push(const T &value) {
+    const reservation r = reserve(1);
+    if (r.empty()) {
+      return false;
+    }
+    r.first[0] = value;
+    commit(r);
+    return true;
+  }
+  bool try_pop(T &out) {
+    const reservation r = peek(1);
+    if (r.empty()) {
+      return false;
+    }
+    out = std::move(r.first[0]);
+    release(r);
+    return true;
+  }
+
+private:
+  // Each sequence number has a padded block to itself: a producer committing slot p and a consumer releasing a slot
+  // just behind it would otherwise write the same line whenever the queue runs nearly empty
+  std::atomic<std::uint64_t> &sequence(std::uint64_t pos) noexcept { return sequence_[pos & mask_].value; }
+
+  static size_type round_up(size_type n) noexcept {
+    size_type p = 1;
+    while (p < n) {
+      p <<= 1;
+    }
+    return p;
+  }
+
+  // Slot p is ready for a producer when its sequence is p, and for a consumer when it is p + 1 (ready is 0 or 1).
+  // The run starts at the shared counter and ends before the first slot that is not ready yet.
+  reservation claim(std::atomic<std::uint64_t> &counter, size_type n, std::uint64_t ready) {
+    std::uint64_t pos = counter.load(std::memory_order_relaxed);
+    for (;;) {
+      size_type run = 0;
+      while (run < n && sequence(pos + run).load(std::memory_order_acquire) == pos + run + ready) {
+        ++run;
+      }
+      if (run == 0) {
+        const std::uint64_t seq = sequence(pos).load(std::memory_order_acquire);
+        // Behind by a lap: the queue is full (producer) or empty (consumer)
+        if (static_cast<std::int64_t>(seq - (pos + ready)) < 0) {
+          return reservation();
+        }
+        pos = counter.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (counter.compare_exchange_weak(pos, pos + run, std::memory_order_relaxed, std::memory_order_relaxed)) {
+        return detail::queue_region(slots_.data(), capacity(), static_cast<size_type>(pos & mask_), run, pos);
+      }
+    }
+  }
+
+  // Moves every slot of the run to its next state: filled (step 1) or empty for the next lap (step capacity)
+  void publish(const reservation &r, std::uint64_t step) {
+    for (size_type i = 0; i < r.size(); ++i) {
+      const std::uint64_t pos = r.position + i;
+      DD_SPAN_EXPECT(sequence(pos).load(std::memory_order_relaxed) == pos + (step == 1 ? 0 : 1));
+      sequence(pos).store(pos + step, std::memory_order_release);
+    }
+  }
+
+  buffer<T> slots_;
+  buffer<detail::padded_atomic<std::uint64_t>> sequence_;
+  size_type mask_;
+  detail::padded_atomic<std::uint64_t> write_;
+  detail::padded_atomic<std::uint64_t> read_;
+};
+
+} // namespace DD_SPAN_NAMESPACE_NAME
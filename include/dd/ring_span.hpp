@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// A ring buffer view: a span used as circular storage, plus the position and length of the stored run. The view
+// owns no memory; copying it copies the head and size, not the elements. Logical index i lives at physical slot
+// (head + i) wrapped to the capacity, which is a mask for power-of-two capacities and a compare-and-subtract
+// otherwise, never a division. Bulk reads and writes go through readable_segments()/writable_segments(): at most
+// two contiguous spans, split at the end of the storage. A ring_span is not safe to share between threads.
+
+#include "algorithm.hpp"
+#include "aligned_span.hpp"
+#include "span.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+// The elements of a ring region in order: first, then second (empty unless the region wraps)
+template <typename T> struct ring_segments {
+  span<T> first;
+  span<T> second;
+
+  DD_SPAN_API constexpr std::size_t size() const noexcept { return first.size() + second.size(); }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return size() == 0; }
+};
+
+namespace detail {
+
+// Slot of logical position pos < 2 * capacity
+DD_SPAN_API constexpr std::size_t ring_wrap(std::size_t pos, std::size_t capacity, bool pow2) noexcept {
+  return pow2 ? (pos & (capacity - 1)) : (pos >= capacity ? pos - capacity : pos);
+}
+
+template <typename T> class ring_iterator {
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = typename std::remove_cv<T>::type;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using pointer = T *;
+
+  DD_SPAN_API constexpr ring_iterator() noexcept = default;
+  DD_SPAN_API constexpr ring_iterator(T *data, std::size_t capacity, std::size_t head, bool pow2,
+                                      difference_type pos) noexcept
+      : data_(data), capacity_(capacity), head_(head), pow2_(pow2), pos_(pos) {}
+
+  DD_SPAN_API constexpr reference operator*() const noexcept { return at(pos_); }
+  DD_SPAN_API constexpr reference operator[](difference_type n) const noexcept { return at(pos_ + n); }
+  DD_SPAN_API constexpr pointer operator->() const noexcept { return &at(pos_); }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 ring_iterator &operator++() noexcept {
+    ++pos_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 ring_iterator operator++(int) noexcept {
+    ring_iterator tmp = *this;
+    ++pos_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 ring_iterator &operator--() noexcept {
+    --pos_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 ring_iterator operator--(int) noexcept {
+    ring_iterator tmp = *this;
+    --pos_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 ring_iterator &operator+=(difference_type n) noexcept {
+    pos_ += n;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 ring_iterator &operator-=(difference_type n) noexcept {
+    pos_ -= n;
+    return *this;
+  }
+  DD_SPAN_API constexpr friend ring_iterator operator+(const ring_iterator &it, difference_type n) noexcept {
+    return ring_iterator(it.data_, it.capacity_, it.head_, it.pow2_, it.pos_ + n);
+  }
+  DD_SPAN_API constexpr friend ring_iterator operator+(difference_type n, const ring_iterator &it) noexcept {
+    return it + n;
+  }
+  DD_SPAN_API constexpr friend ring_iterator operator-(const ring_iterator &it, difference_type n) noexcept {
+    return ring_iterator(it.data_, it.capacity_, it.head_, it.pow2_, it.pos_ - n);
+  }
+  DD_SPAN_API constexpr friend difference_type operator-(const ring_iterator &lhs, const ring_iterator &rhs) noexcept {
+    return lhs.pos_ - rhs.pos_;
+  }
+
+  DD_SPAN_API constexpr friend bool operator==(const ring_iterator &lhs, const ring_iterator &rhs) noexcept {
+    return lhs.pos_ == rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator!=(const ring_iterator &lhs, const ring_iterator &rhs) noexcept {
+    return lhs.pos_ != rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator<(const ring_iterator &lhs, const ring_iterator &rhs) noexcept {
+    return lhs.pos_ < rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator>(const ring_iterator &lhs, const ring_iterator &rhs) noexcept {
+    return lhs.pos_ > rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator<=(const ring_iterator &lhs, const ring_iterator &rhs) noexcept {
+    return lhs.pos_ <= rhs.pos_;
+  }
+  DD_SPAN_API constexpr friend bool operator>=(const ring_iterator &lhs, const ring_iterator &rhs) noexcept {
+    return lhs.pos_ >= rhs.pos_;
+  }
+
+private:
+  DD_SPAN_API constexpr reference at(difference_type pos) const noexcept {
+    return data_[ring_wrap(head_ + static_cast<std::size_t>(pos), capacity_, pow2_)];
+  }
+
+  T *data_ = nullptr;
+  std::size_t capacity_ = 0;
+  std::size_t head_ = 0;
+  bool pow2_ = false;
+  difference_type pos_ = 0;
+};
+
+} // namespace detail
+
+template <typename ElementType, std::size_t Extent = dynamic_extent> class ring_span {
+  static_assert(!std::is_const<ElementType>::value, "a ring is written to; use a span for read-only data");
+
+public:
+  using element_type = ElementType;
+  using value_type = typename std::remove_cv<ElementType>::type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = element_type &;
+  using const_reference = const element_type &;
+  using iterator = detail::ring_iterator<element_type>;
+  using segments_type = ring_segments<element_type>;
+
+  DD_SPAN_API constexpr ring_span() noexcept = default;
+  // Storage holding size elements starting at slot head, wrapping at the end
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 explicit ring_span(span<element_type, Extent> storage, size_type head = 0,
+                                                     size_type size = 0)
+      : storage_(storage), head_(head), size_(size), pow2_(detail::is_pow2(storage.size())) {
+    DD_SPAN_EXPECT(head < storage.size() || (head == 0 && storage.empty()));
+    DD_SPAN_EXPECT(size <= storage.size());
+  }
+
+  DD_SPAN_API constexpr size_type capacity() const noexcept { return storage_.size(); }
+  DD_SPAN_API constexpr size_type size() const noexcept { return size_; }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return size_ == 0; }
+  DD_SPAN_API constexpr bool full() const noexcept { return size_ == capacity(); }
+  // Slot of the front element
+  DD_SPAN_API constexpr size_type head() const noexcept { return head_; }
+  DD_SPAN_API constexpr span<element_type, Extent> storage() const noexcept { return storage_; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return storage_.data()[slot(head_ + idx)];
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference front() const {
+    DD_SPAN_EXPECT(!empty());
+    return storage_.data()[head_];
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference back() const {
+    DD_SPAN_EXPECT(!empty());
+    return storage_.data()[slot(head_ + size_ - 1)];
+  }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 void push_back(const value_type &value) {
+    DD_SPAN_EXPECT(!full());
+    storage_.data()[slot(head_ + size_)] = value;
+    ++size_;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 void pop_front() {
+    DD_SPAN_EXPECT(!empty());
+    head_ = slot(head_ + 1);
+    --size_;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 void clear() noexcept {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  // The stored elements, oldest first
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 segments_type readable_segments() const noexcept { return region(head_, size_); }
+  // The free slots, in the order push_back fills them
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 segments_type writable_segments() const noexcept {
+    return region(capacity() == 0 ? 0 : slot(head_ + size_), capacity() - size_);
+  }
+  // Appends the first count writable slots, after the caller has filled them
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 void commit(size_type count) {
+    DD_SPAN_EXPECT(count <= capacity() - size_);
+    size_ += count;
+  }
+  // Drops the first count elements
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 void consume(size_type count) {
+    DD_SPAN_EXPECT(count <= size_);
+    if (count != 0) {
+      head_ = slot(head_ + count);
+      size_ -= count;
+    }
+  }
+
+  // Appends as much of values as fits, a segment at a time; returns the number appended
+  template <typename U, std::size_t E> DD_SPAN_API size_type write(span<U, E> values) {
+    const segments_type free = writable_segments();
+    const size_type n = values.size() < free.size() ? values.size() : free.size();
+    const size_type n1 = n < free.first.size() ? n : free.first.size();
+    copy(values.first(n1), free.first);
+    copy(values.subspan(n1, n - n1), free.second);
+    size_ += n;
+    return n;
+  }
+  // Moves up to out.size() elements from the front into out; returns the number moved
+  template <typename U, std::size_t E> DD_SPAN_API size_type read(span<U, E> out) {
+    const segments_type used = readable_segments();
+    const size_type n = out.size() < used.size() ? out.size() : used.size();
+    const size_type n1 = n < used.first.size() ? n : used.first.size();
+    copy(span<const element_type>(used.first.first(n1)), out);
+    copy(span<const element_type>(used.second.first(n - n1)), out.subspan(n1));
+    consume(n);
+    return n;
+  }
+
+  DD_SPAN_API constexpr iterator begin() const noexcept {
+    return iterator(storage_.data(), capacity(), head_, pow2(), 0);
+  }
+  DD_SPAN_API constexpr iterator end() const noexcept {
+    return iterator(storage_.data(), capacity(), head_, pow2(), static_cast<difference_type>(size_));
+  }
+
+private:
+  // Folds to a constant for static extents
+  DD_SPAN_API constexpr bool pow2() const noexcept {
+    return Extent != dynamic_extent ? detail::is_pow2(Extent) : pow2_;
+  }
+  DD_SPAN_API constexpr size_type slot(size_type pos) const noexcept {
+    return detail::ring_wrap(pos, capacity(), pow2());
+  }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 segments_type region(size_type start, size_type count) const noexcept {
+    const size_type to_end = capacity() - start;
+    if (count <= to_end) {
+      return segments_type{span<element_type>(storage_.data() + start, count), span<element_type>()};
+    }
+    return segments_type{span<element_type>(storage_.data() + start, to_end),
+                         span<element_type>(storage_.data(), count - to_end)};
+  }
+
+  span<element_type, Extent> storage_;
+  size_type head_ = 0;
+  size_type size_ = 0;
+  bool pow2_ = false;
+};
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,589 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only reductions and searches over arithmetic spans: sum, dot, minmax, count, count_if and find.
+//
+// Every algorithm has a scalar path and, with GCC or Clang, vector paths built from the compilers' vector
+// extensions: SSE2, AVX2 and AVX-512 on x86 (chosen at runtime from the CPU) and NEON on AArch64. The kernels
+// keep several independent accumulators to hide instruction latency. Floating-point sums and dot products are
+// therefore reassociated and may differ from a left-to-right loop in the last bits; min/max of NaNs is
+// unspecified. Define DD_SPAN_NO_SIMD to always use the scalar path.
+
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if !defined(DD_SPAN_NO_SIMD) && !defined(__CUDACC__) && (defined(__GNUC__) || defined(__clang__))
+#if defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__))
+#define DD_SPAN_SIMD_X86
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define DD_SPAN_SIMD_NEON
+#endif
+#endif
+
+#if defined(DD_SPAN_SIMD_X86) || defined(DD_SPAN_SIMD_NEON)
+#define DD_SPAN_SIMD_KERNEL __attribute__((always_inline)) inline
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+enum class simd_isa { scalar, sse2, avx2, avx512, neon };
+
+namespace detail {
+
+inline simd_isa detect_simd_isa() noexcept {
+#if defined(DD_SPAN_SIMD_X86)
+  __builtin_cpu_init();
+  // simd_run_avx512 is compiled for all four extensions; AVX-512F alone (e.g. Knights Landing) falls back to AVX2
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") &&
+      __builtin_cpu_supports("avx512vl")) {
+    return simd_isa::avx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return simd_isa::avx2;
+  }
+  return simd_isa::sse2;
+#elif defined(DD_SPAN_SIMD_NEON)
+  return simd_isa::neon;
+#else
+  return simd_isa::scalar;
+#endif
+}
+
+// Index of the lowest set bit; v must not be zero
+inline unsigned countr_zero(std::uint64_t v) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long idx;
+  _BitScanForward64(&idx, v);
+  return static_cast<unsigned>(idx);
+#else
+  return static_cast<unsigned>(__builtin_ctzll(v));
+#endif
+}
+
+} // namespace detail
+
+// Widest instruction set available on this CPU, detected once
+inline simd_isa best_simd_isa() noexcept {
+  static const simd_isa isa = detail::detect_simd_isa();
+  return isa;
+}
+
+inline bool simd_supported(simd_isa isa) noexcept {
+  const simd_isa best = best_simd_isa();
+  switch (isa) {
+  case simd_isa::scalar:
+    return true;
+  case simd_isa::sse2:
+    return best == simd_isa::sse2 || best == simd_isa::avx2 || best == simd_isa::avx512;
+  case simd_isa::avx2:
+    return best == simd_isa::avx2 || best == simd_isa::avx512;
+  case simd_isa::avx512:
+  case simd_isa::neon:
+    return best == isa;
+  }
+  return false;
+}
+
+inline const char *simd_isa_name(simd_isa isa) noexcept {
+  switch (isa) {
+  case simd_isa::scalar:
+    return "scalar";
+  case simd_isa::sse2:
+    return "sse2";
+  case simd_isa::avx2:
+    return "avx2";
+  case simd_isa::avx512:
+    return "avx512";
+  case simd_isa::neon:
+    return "neon";
+  }
+  return "unknown";
+}
+
+namespace detail {
+
+// Element types the vector kernels handle; everything else (bool, long double, ...) takes the scalar path
+template <typename T>
+struct simd_element
+    : std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+                                       (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+// Integer sums and products wrap in the unsigned type instead of overflowing
+template <typename T, bool = std::is_integral<T>::value> struct simd_accumulator {
+  using type = typename std::make_unsigned<T>::type;
+};
+template <typename T> struct simd_accumulator<T, false> {
+  using type = T;
+};
+
+template <std::size_t Size> struct simd_counter {
+  using type = std::uint64_t;
+};
+template <> struct simd_counter<1> {
+  using type = std::uint8_t;
+};
+template <> struct simd_counter<2> {
+  using type = std::uint16_t;
+};
+template <> struct simd_counter<4> {
+  using type = std::uint32_t;
+};
+
+#if defined(DD_SPAN_SIMD_KERNEL)
+template <typename T, std::size_t Bytes> struct simd_vector {
+  typedef T type __attribute__((vector_size(Bytes)));
+};
+
+// Whether any lane of a comparison result (or any bit of a vector) is set. Testing the words of the vector
+// avoids OR-ing mask registers, which GCC scalarizes for 512-bit vectors.
+template <typename M> DD_SPAN_SIMD_KERNEL bool simd_any(const M &mask) noexcept {
+  std::uint64_t words[sizeof(M) / 8];
+  std::memcpy(words, &mask, sizeof(M));
+  std::uint64_t bits = 0;
+  for (std::size_t j = 0; j < sizeof(M) / 8; ++j) {
+    bits |= words[j];
+  }
+  return bits != 0;
+}
+#endif
+
+struct sum_op {
+  template <typename T> T scalar(span<const T> s) const noexcept {
+    using A = typename simd_accumulator<T>::type;
+    A acc[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 <= s.size(); i += 4) {
+      for (std::size_t j = 0; j < 4; ++j) {
+        acc[j] += static_cast<A>(s[i + j]);
+      }
+    }
+    A total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    for (; i < s.size(); ++i) {
+      total += static_cast<A>(s[i]);
+    }
+    return static_cast<T>(total);
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  template <std::size_t Bytes, typename T> DD_SPAN_SIMD_KERNEL T vector(span<const T> s) const noexcept {
+    using A = typename simd_accumulator<T>::type;
+    using V = typename simd_vector<A, Bytes>::type;
+    constexpr std::size_t W = Bytes / sizeof(T);
+    const T *p = s.data();
+    const std::size_t n = s.size();
+    V acc0 = {}, acc1 = {}, acc2 = {}, acc3 = {};
+    std::size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+      V x0, x1, x2, x3;
+      std::memcpy(&x0, p + i, Bytes);
+      std::memcpy(&x1, p + i + W, Bytes);
+      std::memcpy(&x2, p + i + 2 * W, Bytes);
+      std::memcpy(&x3, p + i + 3 * W, Bytes);
+      acc0 += x0;
+      acc1 += x1;
+      acc2 += x2;
+      acc3 += x3;
+    }
+    for (; i + W <= n; i += W) {
+      V x;
+      std::memcpy(&x, p + i, Bytes);
+      acc0 += x;
+    }
+    acc0 = (acc0 + acc1) + (acc2 + acc3);
+    A total = A();
+    for (std::size_t j = 0; j < W; ++j) {
+      total += acc0[j];
+    }
+    for (; i < n; ++i) {
+      total += static_cast<A>(p[i]);
+    }
+    return static_cast<T>(total);
+  }
+#endif
+};
+
+struct dot_op {
+  template <typename T> T scalar(span<const T> a, span<const T> b) const noexcept {
+    using A = typename simd_accumulator<T>::type;
+    A acc[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 <= a.size(); i += 4) {
+      for (std::size_t j = 0; j < 4; ++j) {
+        acc[j] += static_cast<A>(static_cast<A>(a[i + j]) * static_cast<A>(b[i + j]));
+      }
+    }
+    A total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+    for (; i < a.size(); ++i) {
+      total += static_cast<A>(static_cast<A>(a[i]) * static_cast<A>(b[i]));
+    }
+    return static_cast<T>(total);
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  template <std::size_t Bytes, typename T>
+  DD_SPAN_SIMD_KERNEL T vector(span<const T> a, span<const T> b) const noexcept {
+    using A = typename simd_accumulator<T>::type;
+    using V = typename simd_vector<A, Bytes>::type;
+    constexpr std::size_t W = Bytes / sizeof(T);
+    const T *p = a.data();
+    const T *q = b.data();
+    const std::size_t n = a.size();
+    V acc0 = {}, acc1 = {}, acc2 = {}, acc3 = {};
+    std::size_t i = 0;
+    for (; i + 4 * W <= n; i += 4 * W) {
+      V x0, x1, x2, x3, y0, y1, y2, y3;
+      std::memcpy(&x0, p + i, Bytes);
+      std::memcpy(&x1, p + i + W, Bytes);
+      std::memcpy(&x2, p + i + 2 * W, Bytes);
+      std::memcpy(&x3, p + i + 3 * W, Bytes);
+      std::memcpy(&y0, q + i, Bytes);
+      std::memcpy(&y1, q + i + W, Bytes);
+      std::memcpy(&y2, q + i + 2 * W, Bytes);
+      std::memcpy(&y3, q + i + 3 * W, Bytes);
+      acc0 += x0 * y0;
+      acc1 += x1 * y1;
+      acc2 += x2 * y2;
+      acc3 += x3 * y3;
+    }
+    for (; i + W <= n; i += W) {
+      V x, y;
+      std::memcpy(&x, p + i, Bytes);
+      std::memcpy(&y, q + i, Bytes);
+      acc0 += x * y;
+    }
+    acc0 = (acc0 + acc1) + (acc2 + acc3);
+    A total = A();
+    for (std::size_t j = 0; j < W; ++j) {
+      total += acc0[j];
+    }
+    for (; i < n; ++i) {
+      total += static_cast<A>(static_cast<A>(p[i]) * static_cast<A>(q[i]));
+    }
+    return static_cast<T>(total);
+  }
+#endif
+};
+
+struct minmax_op {
+  template <typename T> std::pair<T, T> scalar(span<const T> s) const noexcept {
+    T lo = s[0], hi = s[0];
+    for (std::size_t i = 1; i < s.size(); ++i) {
+      lo = s[i] < lo ? s[i] : lo;
+      hi = hi < s[i] ? s[i] : hi;
+    }
+    return std::pair<T, T>(lo, hi);
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  // The elements after the last full vector are covered by one more, overlapping vector: s.last<W>()
+  template <std::size_t Bytes, typename T>
+  DD_SPAN_SIMD_KERNEL std::pair<T, T> vector(span<const T> s) const noexcept {
+    using V = typename simd_vector<T, Bytes>::type;
+    constexpr std::size_t W = Bytes / sizeof(T);
+    const T *p = s.data();
+    const std::size_t n = s.size();
+    if (n < W) {
+      return scalar(s);
+    }
+    V lo0, lo1, hi0, hi1;
+    std::memcpy(&lo0, s.template last<W>().data(), Bytes);
+    lo1 = hi0 = hi1 = lo0;
+    std::size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W) {
+      V x0, x1;
+      std::memcpy(&x0, p + i, Bytes);
+      std::memcpy(&x1, p + i + W, Bytes);
+      lo0 = x0 < lo0 ? x0 : lo0;
+      hi0 = hi0 < x0 ? x0 : hi0;
+      lo1 = x1 < lo1 ? x1 : lo1;
+      hi1 = hi1 < x1 ? x1 : hi1;
+    }
+    if (i + W <= n) {
+      V x;
+      std::memcpy(&x, p + i, Bytes);
+      lo0 = x < lo0 ? x : lo0;
+      hi0 = hi0 < x ? x : hi0;
+    }
+    lo0 = lo1 < lo0 ? lo1 : lo0;
+    hi0 = hi0 < hi1 ? hi1 : hi0;
+    T lo = lo0[0], hi = hi0[0];
+    for (std::size_t j = 1; j < W; ++j) {
+      lo = lo0[j] < lo ? lo0[j] : lo;
+      hi = hi < hi0[j] ? hi0[j] : hi;
+    }
+    return std::pair<T, T>(lo, hi);
+  }
+#endif
+};
+
+template <typename T> struct count_op {
+  T value;
+
+  std::size_t scalar(span<const T> s) const noexcept {
+    std::size_t c[4] = {};
+    std::size_t i = 0;
+    for (; i + 4 <= s.size(); i += 4) {
+      for (std::size_t j = 0; j < 4; ++j) {
+        c[j] += s[i + j] == value ? 1 : 0;
+      }
+    }
+    std::size_t total = (c[0] + c[1]) + (c[2] + c[3]);
+    for (; i < s.size(); ++i) {
+      total += s[i] == value ? 1 : 0;
+    }
+    return total;
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  // Comparisons yield -1 per matching lane; the lane counters are flushed before they can overflow
+  template <std::size_t Bytes> DD_SPAN_SIMD_KERNEL std::size_t vector(span<const T> s) const noexcept {
+    using V = typename simd_vector<T, Bytes>::type;
+    using M = decltype(V() == V());
+    constexpr std::size_t W = Bytes / sizeof(T);
+    constexpr std::size_t flush = sizeof(T) == 1 ? 63 : 4096;
+    const T *p = s.data();
+    const std::size_t n = s.size();
+    V v;
+    for (std::size_t j = 0; j < W; ++j) {
+      v[j] = value;
+    }
+    std::size_t total = 0;
+    std::size_t i = 0;
+    while (i + 2 * W <= n) {
+      M c0 = {}, c1 = {};
+      for (std::size_t k = 0; k < flush && i + 2 * W <= n; ++k, i += 2 * W) {
+        V x0, x1;
+        std::memcpy(&x0, p + i, Bytes);
+        std::memcpy(&x1, p + i + W, Bytes);
+        c0 -= x0 == v;
+        c1 -= x1 == v;
+      }
+      c0 += c1;
+      for (std::size_t j = 0; j < W; ++j) {
+        total += static_cast<std::size_t>(c0[j]);
+      }
+    }
+    for (; i < n; ++i) {
+      total += p[i] == value ? 1 : 0;
+    }
+    return total;
+  }
+#endif
+};
+
+template <typename T, typename Pred> struct count_if_op {
+  Pred pred;
+
+  std::size_t scalar(span<const T> s) const {
+    std::size_t total = 0;
+    for (const T &x : s) {
+      total += pred(x) ? 1 : 0;
+    }
+    return total;
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  // A branch-free count into a counter as wide as the elements, so that the compiler vectorizes pred for the
+  // selected instruction set once it is inlined. Narrow counters are flushed before they can overflow.
+  template <std::size_t Bytes> DD_SPAN_SIMD_KERNEL std::size_t vector(span<const T> s) const {
+    using C = typename simd_counter<sizeof(T)>::type;
+    constexpr std::size_t block = sizeof(T) < sizeof(std::uint32_t) ? static_cast<C>(-1) : std::size_t(1) << 30;
+    const T *p = s.data();
+    const std::size_t n = s.size();
+    std::size_t total = 0;
+    std::size_t i = 0;
+    while (i < n) {
+      const std::size_t m = n - i < block ? n - i : block;
+      C c = 0;
+      for (std::size_t k = 0; k < m; ++k) {
+        c += pred(p[i + k]) ? 1 : 0;
+      }
+      total += c;
+      i += m;
+    }
+    return total;
+  }
+#endif
+};
+
+template <typename T> struct find_op {
+  T value;
+
+  std::size_t scalar(span<const T> s) const noexcept {
+    for (std::size_t i = 0; i < s.size(); ++i) {
+      if (s[i] == value) {
+        return i;
+      }
+    }
+    return s.size();
+  }
+#if defined(DD_SPAN_SIMD_KERNEL)
+  // Returns s.size() when value is absent. Like minmax, the tail is one overlapping vector s.last<W>(); its
+  // leading lanes were already known not to match.
+  template <std::size_t Bytes> DD_SPAN_SIMD_KERNEL std::size_t vector(span<const T> s) const noexcept {
+    using V = typename simd_vector<T, Bytes>::type;
+    constexpr std::size_t W = Bytes / sizeof(T);
+    const T *p = s.data();
+    const std::size_t n = s.size();
+    if (n < W) {
+      return scalar(s);
+    }
+    V v;
+    for (std::size_t j = 0; j < W; ++j) {
+      v[j] = value;
+    }
+    std::size_t i = 0;
+    for (; i + 2 * W <= n; i += 2 * W) {
+      V x0, x1;
+      std::memcpy(&x0, p + i, Bytes);
+      std::memcpy(&x1, p + i + W, Bytes);
+      if (simd_any(x0 == v) || simd_any(x1 == v)) {
+        return i + scalar(span<const T>(p + i, 2 * W));
+      }
+    }
+    if (i + W <= n) {
+      V x;
+      std::memcpy(&x, p + i, Bytes);
+      if (simd_any(x == v)) {
+        return i + scalar(span<const T>(p + i, W));
+      }
+      i += W;
+    }
+    if (i < n) {
+      V x;
+      std::memcpy(&x, s.template last<W>().data(), Bytes);
+      if (simd_any(x == v)) {
+        return n - W + scalar(span<const T>(p + n - W, W));
+      }
+    }
+    return n;
+  }
+#endif
+};
+
+#if defined(DD_SPAN_SIMD_X86)
+template <typename Op, typename... Args>
+__attribute__((target("avx2"))) auto simd_run_avx2(const Op &op, Args... args)
+    -> decltype(op.template vector<32>(args...)) {
+  return op.template vector<32>(args...);
+}
+template <typename Op, typename... Args>
+__attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) auto simd_run_avx512(const Op &op, Args... args)
+    -> decltype(op.template vector<64>(args...)) {
+  return op.template vector<64>(args...);
+}
+#endif
+
+template <typename Op, typename... Args>
+auto simd_dispatch(std::true_type /*vectorizable*/, simd_isa isa, const Op &op, Args... args)
+    -> decltype(op.scalar(args...)) {
+  DD_SPAN_EXPECT(simd_supported(isa));
+  switch (isa) {
+#if defined(DD_SPAN_SIMD_X86)
+  case simd_isa::avx512:
+    return simd_run_avx512(op, args...);
+  case simd_isa::avx2:
+    return simd_run_avx2(op, args...);
+  case simd_isa::sse2:
+    return op.template vector<16>(args...);
+#elif defined(DD_SPAN_SIMD_NEON)
+  case simd_isa::neon:
+    return op.template vector<16>(args...);
+#endif
+  default:
+    return op.scalar(args...);
+  }
+}
+template <typename Op, typename... Args>
+auto simd_dispatch(std::false_type /*vectorizable*/, simd_isa isa, const Op &op, Args... args)
+    -> decltype(op.scalar(args...)) {
+  DD_SPAN_EXPECT(simd_supported(isa));
+  return op.scalar(args...);
+}
+
+template <typename T> using simd_dispatch_tag = simd_element<typename std::remove_cv<T>::type>;
+
+} // namespace detail
+
+// Every algorithm takes an optional simd_isa to force a code path, e.g. for testing or benchmarking; it must be
+// supported by the CPU.
+
+// Sum of the elements, accumulated in the element type
+template <typename T, std::size_t E>
+typename std::remove_cv<T>::type sum(span<T, E> s, simd_isa isa = best_simd_isa()) {
+  using V = typename std::remove_cv<T>::type;
+  return detail::simd_dispatch(detail::simd_dispatch_tag<T>(), isa, detail::sum_op(), span<const V>(s));
+}
+
+// Sum of a[i] * b[i]
+template <typename T, std::size_t E1, typename U, std::size_t E2,
+          typename std::enable_if<
+              std::is_same<typename std::remove_cv<T>::type, typename std::remove_cv<U>::type>::value, int>::type = 0>
+typename std::remove_cv<T>::type dot(span<T, E1> a, span<U, E2> b, simd_isa isa = best_simd_isa()) {
+  DD_SPAN_EXPECT(a.size() == b.size());
+  using V = typename std::remove_cv<T>::type;
+  return detail::simd_dispatch(detail::simd_dispatch_tag<T>(), isa, detail::dot_op(), span<const V>(a),
+                               span<const V>(b));
+}
+
+// Smallest and largest element of a non-empty span
+template <typename T, std::size_t E>
+std::pair<typename std::remove_cv<T>::type, typename std::remove_cv<T>::type> minmax(span<T, E> s,
+                                                                                     simd_isa isa = best_simd_isa()) {
+  DD_SPAN_EXPECT(!s.empty());
+  using V = typename std::remove_cv<T>::type;
+  return detail::simd_dispatch(detail::simd_dispatch_tag<T>(), isa, detail::minmax_op(), span<const V>(s));
+}
+
+// Number of elements equal to value
+template <typename T, std::size_t E>
+std::size_t count(span<T, E> s, const typename std::remove_cv<T>::type &value, simd_isa isa = best_simd_isa()) {
+  using V = typename std::remove_cv<T>::type;
+  return detail::simd_dispatch(detail::simd_dispatch_tag<T>(), isa, detail::count_op<V>{value}, span<const V>(s));
+}
+
+// Number of elements for which pred returns true. pred is called on every element in an unspecified order.
+template <typename T, std::size_t E, typename Pred>
+std::size_t count_if(span<T, E> s, Pred pred, simd_isa isa = best_simd_isa()) {
+  using V = typename std::remove_cv<T>::type;
+  return detail::simd_dispatch(detail::simd_dispatch_tag<T>(), isa, detail::count_if_op<V, Pred>{pred},
+                               span<const V>(s));
+}
+
+// Iterator to the first element equal to value, or s.end()
+template <typename T, std::size_t E>
+typename span<T, E>::iterator find(span<T, E> s, const typename std::remove_cv<T>::type &value,
+                                   simd_isa isa = best_simd_isa()) {
+  using V = typename std::remove_cv<T>::type;
+  return s.begin() + detail::simd_dispatch(detail::simd_dispatch_tag<T>(), isa, detail::find_op<V>{value},
+                                           span<const V>(s));
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only sorting primitives over spans: a stable LSD radix sort for integer and floating-point keys that can
+// carry a span of values along, and a stable merge of two sorted spans.
+//
+// The radix sort moves one 8-bit digit per pass, ping-ponging between the keys and a caller-provided scratch span
+// of the same size, so it never allocates storage proportional to the input. A pass whose digit is the same for
+// every key is skipped, so keys that use few of their bits finish in fewer passes. Large inputs are cut into tiles
+// on a thread_pool: each tile counts its digits, the counts become per-tile offsets in tile order, and the tiles
+// scatter concurrently, so the parallel sort is stable as well.
+
+#include "algorithm.hpp"
+#include "chunks.hpp"
+#include "parallel.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+// Inputs shorter than this are sorted on the calling thread
+DD_SPAN_INLINE_VAR constexpr std::size_t radix_sort_parallel_min = std::size_t(1) << 17;
+
+namespace detail {
+
+// Maps keys to unsigned integers in the same order. Signed integers flip the sign bit; floating-point values flip
+// the sign bit when it is clear and every bit when it is set, so -0.0 sorts before +0.0 and NaNs sort to the end
+// their sign bit points to.
+template <typename K, typename = void> struct radix_key;
+template <typename K> struct radix_key<K, typename std::enable_if<std::is_unsigned<K>::value>::type> {
+  using bits = K;
+  static bits encode(K k) noexcept { return k; }
+};
+template <typename K>
+struct radix_key<K, typename std::enable_if<std::is_integral<K>::value && std::is_signed<K>::value>::type> {
+  using bits = typename std::make_unsigned<K>::type;
+  static bits encode(K k) noexcept { return static_cast<bits>(static_cast<bits>(k) ^ sign_bit()); }
+  static constexpr bits sign_bit() noexcept { return static_cast<bits>(bits(1) << (sizeof(K) * 8 - 1)); }
+};
+template <typename K> struct radix_key<K, typename std::enable_if<std::is_floating_point<K>::value>::type> {
+  static_assert(sizeof(K) == 4 || sizeof(K) == 8, "floating-point keys must be IEEE float or double");
+  using bits = typename std::conditional<sizeof(K) == 4, std::uint32_t, std::uint64_t>::type;
+  static bits encode(K k) noexcept {
+    bits b;
+    std::memcpy(&b, &k, sizeof(b));
+    // All ones when the sign bit is set, without a branch that random signs would mispredict
+    const bits negative = bits(0) - (b >> (sizeof(K) * 8 - 1));
+    return b ^ (negative | (bits(1) << (sizeof(K) * 8 - 1)));
+  }
+};
+
+template <typename K> struct is_radix_key : std::integral_constant<bool, std::is_arithmetic<K>::value &&
+                                                                           !std::is_same<K, bool>::value> {};
+
+DD_SPAN_INLINE_VAR constexpr std::size_t radix_buckets = 256;
+
+template <typename K> inline unsigned radix_digit(K key, unsigned pass) noexcept {
+  return static_cast<unsigned>((radix_key<K>::encode(key) >> (8 * pass)) & 0xff);
+}
+
+// Stands in for the values of a keys-only sort
+struct radix_no_values {};
+
+template <typename V> inline void radix_move(const V *src, std::size_t from, V *dst, std::size_t to) {
+  dst[to] = src[from];
+}
+inline void radix_move(const radix_no_values *, std::size_t, radix_no_values *, std::size_t) noexcept {}
+
+template <typename V> inline void radix_copy(const V *src, V *dst, std::size_t n) {
+  copy(span<const V>(src, n), span<V>(dst, n));
+}
+inline void radix_copy(const radix_no_values *, radix_no_values *, std::size_t) noexcept {}
+
+// The four buffers of a sort; after each pass the sorted-so-far data sits in keys/values
+template <typename K, typename V> struct radix_buffers {
+  K *keys;
+  K *key_scratch;
+  V *values;
+  V *value_scratch;
+  std::size_t size;
+
+  void swap() noexcept {
+    K *k = keys;
+    keys = key_scratch;
+    key_scratch = k;
+    V *v = values;
+    values = value_scratch;
+    value_scratch = v;
+  }
+};
+
+// Exclusive prefix sum of counts; returns false when a single bucket holds all n keys and the pass can be skipped
+inline bool radix_offsets(std::size_t *counts, std::size_t n) noexcept {
+  std::size_t sum = 0;
+  for (std::size_t b = 0; b < radix_buckets; ++b) {
+    const std::size_t c = counts[b];
+    if (c == n) {
+      return false;
+    }
+    counts[b] = sum;
+    sum += c;
+  }
+  return true;
+}
+
+// Moves [begin, end) of the current buffers to offsets[digit]++ in the scratch buffers
+template <typename K, typename V>
+void radix_scatter(const radix_buffers<K, V> &buf, std::size_t begin, std::size_t end, unsigned pass,
+                   std::size_t *offsets) {
+  for (std::size_t i = begin; i < end; ++i) {
+    const std::size_t to = offsets[radix_digit(buf.keys[i], pass)]++;
+    buf.key_scratch[to] = buf.keys[i];
+    radix_move(buf.values, i, buf.value_scratch, to);
+  }
+}
+
+// Leaves the sorted data in the caller's spans when an odd number of passes ran
+template <typename K, typename V> void radix_finish(radix_buffers<K, V> buf, const K *home) {
+  if (buf.keys != home) {
+    radix_copy(buf.keys, buf.key_scratch, buf.size);
+    radix_copy(buf.values, buf.value_scratch, buf.size);
+  }
+}
+
+// One read counts the digits of every pass, so the counters live on the stack
+template <typename K, typename V> void radix_sort_serial(radix_buffers<K, V> buf) {
+  const K *home = buf.keys;
+  const std::size_t n = buf.size;
+  std::size_t counts[sizeof(K)][radix_buckets] = {};
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto b = radix_key<K>::encode(buf.keys[i]);
+    for (unsigned pass = 0; pass < sizeof(K); ++pass) {
+      ++counts[pass][(b >> (8 * pass)) & 0xff];
+    }
+  }
+  for (unsigned pass = 0; pass < sizeof(K); ++pass) {
+    if (radix_offsets(counts[pass], n)) {
+      radix_scatter(buf, 0, n, pass, counts[pass]);
+      buf.swap();
+    }
+  }
+  radix_finish(buf, home);
+}
+
+// Tiles are recounted every pass since the previous scatter reshuffled them. The tiles x buckets counters are the
+// only allocation, a few KiB per tile regardless of the input size.
+template <typename K, typename V> void radix_sort_parallel(thread_pool &pool, radix_buffers<K, V> buf) {
+  const K *home = buf.keys;
+  const std::size_t n = buf.size;
+  const std::size_t ntiles = parallel_tiles(pool, n);
+  const auto parts = tiles(span<const K>(buf.keys, n), ntiles);
+  std::vector<std::size_t> counts(ntiles * radix_buckets);
+  std::size_t totals[radix_buckets];
+  for (unsigned pass = 0; pass < sizeof(K); ++pass) {
+    const K *keys = buf.keys;
+    pool.run(ntiles, [&](std::size_t t) {
+      std::size_t *local = counts.data() + t * radix_buckets;
+      std::fill(local, local + radix_buckets, std::size_t(0));
+      const std::size_t begin = static_cast<std::size_t>(parts[t].data() - home);
+      const std::size_t end = begin + parts[t].size();
+      for (std::size_t i = begin; i < end; ++i) {
+        ++local[radix_digit(keys[i], pass)];
+      }
+    });
+    for (std::size_t b = 0; b < radix_buckets; ++b) {
+      totals[b] = 0;
+      for (std::size_t t = 0; t < ntiles; ++t) {
+        totals[b] += counts[t * radix_buckets + b];
+      }
+    }
+    if (!radix_offsets(totals, n)) {
+      continue;
+    }
+    // Within a bucket, tile t writes after tiles 0..t-1, which keeps equal keys in their original order
+    for (std::size_t b = 0; b < radix_buckets; ++b) {
+      std::size_t offset = totals[b];
+      for (std::size_t t = 0; t < ntiles; ++t) {
+        const std::size_t c = counts[t * radix_buckets + b];
+        counts[t * radix_buckets + b] = offset;
+        offset += c;
+      }
+    }
+    pool.run(ntiles, [&](std::size_t t) {
+      const std::size_t begin = static_cast<std::size_t>(parts[t].data() - home);
+      radix_scatter(buf, begin, begin + parts[t].size(), pass, counts.data() + t * radix_buckets);
+    });
+    buf.swap();
+  }
+  radix_finish(buf, home);
+}
+
+template <typename K, typename V> void radix_sort_dispatch(thread_pool &pool, radix_buffers<K, V> buf) {
+  if (buf.size < 2) {
+    return;
+  }
+  if (buf.size >= radix_sort_parallel_min && pool.concurrency() > 1) {
+    radix_sort_parallel(pool, buf);
+  } else {
+    radix_sort_serial(buf);
+  }
+}
+
+// Transparent a < b for merges of spans whose element types differ
+struct merge_less {
+  template <typename A, typename B> bool operator()(const A &a, const B &b) const { return a < b; }
+};
+
+} // namespace detail
+
+// Sorts keys in ascending order, stable, using scratch (at least keys.size() elements) as the second buffer. Floats
+// order as their sign and magnitude: -0.0 before +0.0, negative NaNs first and positive NaNs last.
+template <typename K, std::size_t E1, std::size_t E2>
+void radix_sort(thread_pool &pool, span<K, E1> keys, span<K, E2> scratch) {
+  static_assert(detail::is_radix_key<K>::value && !std::is_const<K>::value,
+                "radix_sort needs mutable integer or floating-point keys");
+  DD_SPAN_EXPECT(scratch.size() >= keys.size());
+  detail::radix_no_values none;
+  detail::radix_sort_dispatch(pool, detail::radix_buffers<K, detail::radix_no_values>{
+                                        keys.data(), scratch.data(), &none, &none, keys.size()});
+}
+template <typename K, std::size_t E1, std::size_t E2> void radix_sort(span<K, E1> keys, span<K, E2> scratch) {
+  radix_sort(default_thread_pool(), keys, scratch);
+}
+
+// Sorts keys and applies the same permutation to values; equal keys keep their relative order
+template <typename K, std::size_t E1, typename V, std::size_t E2, std::size_t E3, std::size_t E4>
+void radix_sort_by_key(thread_pool &pool, span<K, E1> keys, span<V, E2> values, span<K, E3> key_scratch,
+                       span<V, E4> value_scratch) {
+  static_assert(detail::is_radix_key<K>::value && !std::is_const<K>::value,
+                "radix_sort_by_key needs mutable integer or floating-point keys");
+  static_assert(!std::is_const<V>::value, "cannot sort a span of const values");
+  DD_SPAN_EXPECT(values.size() == keys.size());
+  DD_SPAN_EXPECT(key_scratch.size() >= keys.size() && value_scratch.size() >= keys.size());
+  detail::radix_sort_dispatch(pool, detail::radix_buffers<K, V>{keys.data(), key_scratch.data(), values.data(),
+                                                                value_scratch.data(), keys.size()});
+}
+template <typename K, std::size_t E1, typename V, std::size_t E2, std::size_t E3, std::size_t E4>
+void radix_sort_by_key(span<K, E1> keys, span<V, E2> values, span<K, E3> key_scratch, span<V, E4> value_scratch) {
+  radix_sort_by_key(default_thread_pool(), keys, values, key_scratch, value_scratch);
+}
+
+// Merges the sorted spans a and b into the front of out (at least a.size() + b.size() elements) and returns the
+// rest of out. Stable: on ties the elements of a come first.
+template <typename T, std::size_t E1, typename U, std::size_t E2, typename O, std::size_t E3, typename Compare>
+span<O> merge(span<T, E1> a, span<U, E2> b, span<O, E3> out, Compare comp) {
+  static_assert(!std::is_const<O>::value, "cannot merge into a span of const elements");
+  DD_SPAN_EXPECT(out.size() >= a.size() + b.size());
+  std::size_t i = 0, j = 0, k = 0;
+  while (i < a.size() && j < b.size()) {
+    if (comp(b[j], a[i])) {
+      out[k++] = b[j++];
+    } else {
+      out[k++] = a[i++];
+    }
+  }
+  copy(a.subspan(i), out.subspan(k));
+  k += a.size() - i;
+  copy(b.subspan(j), out.subspan(k));
+  k += b.size() - j;
+  return span<O>(out).subspan(k);
+}
+template <typename T, std::size_t E1, typename U, std::size_t E2, typename O, std::size_t E3>
+span<O> merge(span<T, E1> a, span<U, E2> b, span<O, E3> out) {
+  return merge(a, b, out, detail::merge_less());
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
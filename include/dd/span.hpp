@@ -64,7 +64,7 @@ namespace DD_SPAN_NAMESPACE_NAME {
 
 // Default contract checking
 #if !defined(DD_SPAN_THROW_ON_CONTRACT_VIOLATION) && !defined(DD_SPAN_TERMINATE_ON_CONTRACT_VIOLATION) &&              \
-    !defined(DD_SPAN_NO_CONTRACT_CHECKING)
+    !defined(DD_SPAN_NO_CONTRACT_CHECKING) && !defined(DD_SPAN_ASSUME_ON_CONTRACT_VIOLATION)
 #if defined(NDEBUG) || !defined(DD_SPAN_HAVE_CPP14)
 #define DD_SPAN_NO_CONTRACT_CHECKING
 #else
@@ -81,7 +81,17 @@ DD_SPAN_API inline void contract_violation(const char *msg) { throw contract_vio
 [[noreturn]] DD_SPAN_API inline void contract_violation(const char * /*unused*/) { std::terminate(); }
 #endif
 
-#if !defined(DD_SPAN_NO_CONTRACT_CHECKING)
+#if defined(DD_SPAN_ASSUME_ON_CONTRACT_VIOLATION)
+// Contracts become optimizer assumptions: a violation is undefined behaviour instead of being reported.
+// __builtin_assume is not used because Clang ignores assumptions that contain function calls, such as size().
+#if defined(_MSC_VER) && !defined(__clang__)
+#define DD_SPAN_EXPECT(cond) __assume(cond)
+#elif defined(__GNUC__) || defined(__clang__) || defined(__CUDACC__)
+#define DD_SPAN_EXPECT(cond) ((cond) ? (void)0 : __builtin_unreachable())
+#else
+#define DD_SPAN_EXPECT(cond)
+#endif
+#elif !defined(DD_SPAN_NO_CONTRACT_CHECKING)
 #define DD_SPAN_STRINGIFY(cond) #cond
 #define DD_SPAN_EXPECT(cond) (cond ? (void)0 : contract_violation("Expected " DD_SPAN_STRINGIFY(cond)))
 #else
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only: a monotonic arena handing out uninitialized, aligned spans for short-lived scratch buffers. Nothing is
+// freed individually; reset() or rolling back to a marker releases everything allocated since.
+
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Capacity of the per-thread arena returned by dd::thread_span_arena()
+#ifndef DD_SPAN_THREAD_ARENA_BYTES
+#define DD_SPAN_THREAD_ARENA_BYTES (std::size_t(1) << 20)
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+// Position in an arena to roll back to
+struct arena_marker {
+  std::size_t offset;
+};
+
+class span_arena {
+public:
+  span_arena() noexcept = default;
+  // Owns a buffer of capacity bytes
+  explicit span_arena(std::size_t capacity)
+      : owned_(new unsigned char[capacity]), base_(owned_.get()), capacity_(capacity) {}
+  // Carves allocations out of memory owned by the caller
+  explicit span_arena(span<unsigned char> buffer) noexcept : base_(buffer.data()), capacity_(buffer.size()) {}
+
+  span_arena(const span_arena &) = delete;
+  span_arena &operator=(const span_arena &) = delete;
+  span_arena(span_arena &&other) noexcept { swap(other); }
+  span_arena &operator=(span_arena &&other) noexcept {
+    span_arena(std::move(other)).swap(*this);
+    return *this;
+  }
+
+  void swap(span_arena &other) noexcept {
+    std::swap(owned_, other.owned_);
+    std::swap(base_, other.base_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(used_, other.used_);
+  }
+
+  std::size_t capacity() const noexcept { return capacity_; }
+  std::size_t used() const noexcept { return used_; }
+  std::size_t remaining() const noexcept { return capacity_ - used_; }
+
+  // n uninitialized elements aligned to align, a power of two at least alignof(T); the arena must have room unless
+  // n is zero, which always succeeds
+  template <typename T> span<T> allocate(std::size_t n, std::size_t align = alignof(T)) {
+    const span<T> s = try_allocate<T>(n, align);
+    DD_SPAN_EXPECT(n == 0 || s.data() != nullptr);
+    return s;
+  }
+  template <typename T, std::size_t N, std::size_t Align = alignof(T)> span<T, N> allocate() {
+    static_assert(N != dynamic_extent, "allocate<T, N> needs a static extent");
+    static_assert(Align >= alignof(T) && (Align & (Align - 1)) == 0, "Align must be a power of two >= alignof(T)");
+    return span<T, N>(allocate<T>(N, Align).data(), N);
+  }
+
+  // As allocate(), but returns an empty span with a null data() when the arena is full
+  template <typename T> span<T> try_allocate(std::size_t n, std::size_t align = alignof(T)) {
+    static_assert(std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                  "span_arena neither constructs nor destroys elements");
+    DD_SPAN_EXPECT(align >= alignof(T) && (align & (align - 1)) == 0);
+    if (n > dynamic_extent / sizeof(T)) {
+      return span<T>();
+    }
+    void *p = allocate_bytes(n * sizeof(T), align);
+    return p == nullptr ? span<T>() : span<T>(static_cast<T *>(p), n);
+  }
+
+  arena_marker mark() const noexcept { return arena_marker{used_}; }
+  // Releases everything allocated after m was taken
+  void rollback(arena_marker m) {
+    DD_SPAN_EXPECT(m.offset <= used_);
+    used_ = m.offset;
+  }
+  void reset() noexcept { used_ = 0; }
+
+private:
+  void *allocate_bytes(std::size_t bytes, std::size_t align) noexcept {
+    const std::uintptr_t top = reinterpret_cast<std::uintptr_t>(base_) + used_;
+    const std::size_t pad = static_cast<std::size_t>((align - top % align) % align);
+    if (pad > remaining() || bytes > remaining() - pad) {
+      return nullptr;
+    }
+    void *p = base_ + used_ + pad;
+    used_ += pad + bytes;
+    return p;
+  }
+
+  std::unique_ptr<unsigned char[]> owned_;
+  unsigned char *base_ = nullptr;
+  std::size_t capacity_ = 0;
+  std::size_t used_ = 0;
+};
+
+inline void swap(span_arena &lhs, span_arena &rhs) noexcept { lhs.swap(rhs); }
+
+// Rolls an arena back on scope exit to where it was on entry
+class arena_scope {
+public:
+  explicit arena_scope(span_arena &arena) noexcept : arena_(arena), marker_(arena.mark()) {}
+  arena_scope(const arena_scope &) = delete;
+  arena_scope &operator=(const arena_scope &) = delete;
+  ~arena_scope() {
+    // A reset() inside the scope has already released more than the scope would
+    if (marker_.offset <= arena_.used()) {
+      arena_.rollback(marker_);
+    }
+  }
+
+private:
+  span_arena &arena_;
+  arena_marker marker_;
+};
+
+// An arena of DD_SPAN_THREAD_ARENA_BYTES per thread, allocated on first use; pair it with arena_scope so that
+// nested callers release their scratch space
+inline span_arena &thread_span_arena() {
+  static thread_local span_arena arena(DD_SPAN_THREAD_ARENA_BYTES);
+  return arena;
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,267 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only: an ordered list of spans treated as one logical sequence (scatter-gather), e.g. a message assembled
+// from a header and payload pieces that live in different buffers. The first Inline spans are stored in the object
+// itself. On POSIX, the list converts to struct iovec arrays and is written or read with writev/readv/preadv, so
+// the pieces reach the kernel without being concatenated first.
+
+#include "algorithm.hpp"
+#include "span.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+template <typename T = const byte, std::size_t Inline = 8> class span_list {
+  static_assert(Inline != 0, "at least one span is stored inline");
+
+public:
+  using element_type = T;
+  using value_type = typename std::remove_cv<T>::type;
+  using size_type = std::size_t;
+  using segment_type = span<T>;
+  using iterator = const segment_type *;
+
+  span_list() noexcept = default;
+  span_list(std::initializer_list<segment_type> segments) {
+    for (const segment_type &s : segments) {
+      push_back(s);
+    }
+  }
+
+  // Appends a segment; empty spans are skipped, so every stored segment has at least one element
+  void push_back(segment_type s) {
+    if (s.empty()) {
+      return;
+    }
+    if (heap_.empty() && count_ < Inline) {
+      inline_[count_] = s;
+    } else {
+      if (heap_.empty()) {
+        heap_.reserve(2 * Inline);
+        heap_.assign(inline_, inline_ + count_);
+      }
+      heap_.push_back(s);
+    }
+    ++count_;
+    total_ += s.size();
+  }
+  void clear() noexcept {
+    heap_.clear();
+    count_ = 0;
+    total_ = 0;
+  }
+
+  // Elements over all segments
+  size_type size() const noexcept { return total_; }
+  size_type size_bytes() const noexcept { return total_ * sizeof(T); }
+  DD_SPAN_NODISCARD bool empty() const noexcept { return total_ == 0; }
+  size_type segment_count() const noexcept { return count_; }
+
+  span<const segment_type> segments() const noexcept { return span<const segment_type>(begin(), count_); }
+  const segment_type &segment(size_type idx) const {
+    DD_SPAN_EXPECT(idx < count_);
+    return begin()[idx];
+  }
+  iterator begin() const noexcept { return heap_.empty() ? inline_ : heap_.data(); }
+  iterator end() const noexcept { return begin() + count_; }
+
+  // Element at logical position idx; walks the segments
+  T &operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < total_);
+    iterator s = begin();
+    while (idx >= s->size()) {
+      idx -= s->size();
+      ++s;
+    }
+    return (*s)[idx];
+  }
+
+  // The count elements starting at logical position offset, cut from the segments they span
+  span_list subspan(size_type offset, size_type count = dynamic_extent) const {
+    DD_SPAN_EXPECT(offset <= total_ && (count == dynamic_extent || count <= total_ - offset));
+    size_type remaining = count == dynamic_extent ? total_ - offset : count;
+    span_list out;
+    for (iterator s = begin(); s != end() && remaining != 0; ++s) {
+      if (offset >= s->size()) {
+        offset -= s->size();
+        continue;
+      }
+      const size_type take = s->size() - offset < remaining ? s->size() - offset : remaining;
+      out.push_back(s->subspan(offset, take));
+      remaining -= take;
+      offset = 0;
+    }
+    return out;
+  }
+  span_list first(size_type count) const { return subspan(0, count); }
+  span_list last(size_type count) const {
+    DD_SPAN_EXPECT(count <= total_);
+    return subspan(total_ - count, count);
+  }
+
+  // Copies the elements into out, one segment at a time; out must hold size() elements. Returns the rest of out.
+  template <typename U, std::size_t E> span<U> copy_to(span<U, E> out) const {
+    DD_SPAN_EXPECT(out.size() >= total_);
+    span<U> rest(out);
+    for (const segment_type &s : *this) {
+      rest = copy(s, rest);
+    }
+    return rest;
+  }
+
+#if !defined(_WIN32)
+  // Describes segments [first_segment, first_segment + out.size()) in out; returns how many entries were written
+  size_type to_iovecs(span<struct iovec> out, size_type first_segment = 0) const {
+    DD_SPAN_EXPECT(first_segment <= count_);
+    const size_type n = count_ - first_segment < out.size() ? count_ - first_segment : out.size();
+    for (size_type i = 0; i < n; ++i) {
+      const segment_type &s = begin()[first_segment + i];
+      out[i].iov_base = const_cast<value_type *>(s.data());
+      out[i].iov_len = s.size_bytes();
+    }
+    return n;
+  }
+#endif
+
+private:
+  segment_type inline_[Inline];
+  std::vector<segment_type> heap_; // all segments once there are more than Inline
+  size_type count_ = 0;
+  size_type total_ = 0;
+};
+
+#if !defined(_WIN32)
+
+namespace detail {
+
+// Segments per system call: a stack array, well under every platform's IOV_MAX
+DD_SPAN_INLINE_VAR constexpr std::size_t iovec_batch = 64;
+
+// Calls io(iov, count, done) until every byte of the list has been transferred or io returns 0 (end of file) or
+// fails; partial transfers resume inside the segment where they stopped. Returns the number of bytes transferred.
+template <typename T, std::size_t N, typename Io>
+std::size_t vectored_io(const span_list<T, N> &list, std::error_code &ec, Io io) noexcept {
+  ec.clear();
+  std::size_t done = 0;
+  std::size_t segment = 0;
+  std::size_t skip = 0; // bytes of list.segment(segment) already transferred
+  while (segment < list.segment_count()) {
+    struct iovec iov[iovec_batch];
+    const std::size_t count = list.to_iovecs(span<struct iovec>(iov, iovec_batch), segment);
+    iov[0].iov_base = static_cast<char *>(iov[0].iov_base) + skip;
+    iov[0].iov_len -= skip;
+    const ssize_t r = io(iov, static_cast<int>(count), done);
+    if (r < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      ec = std::error_code(errno, std::generic_category());
+      return done;
+    }
+    if (r == 0) {
+      return done;
+    }
+    done += static_cast<std::size_t>(r);
+    std::size_t advance = static_cast<std::size_t>(r) + skip;
+    while (segment < list.segment_count() && advance >= list.segment(segment).size_bytes()) {
+      advance -= list.segment(segment).size_bytes();
+      ++segment;
+    }
+    skip = advance;
+  }
+  return done;
+}
+
+#ifndef DD_SPAN_NO_EXCEPTIONS
+inline std::size_t throw_on_error(std::size_t done, const std::error_code &ec, const char *what) {
+  if (ec) {
+    throw std::system_error(ec, what);
+  }
+  return done;
+}
+#endif
+
+} // namespace detail
+
+// Writes every byte of the list to fd with writev, resuming after partial writes. Returns the bytes written, which
+// is less than list.size_bytes() only when ec reports an error.
+template <typename T, std::size_t N>
+std::size_t writev_all(int fd, const span_list<T, N> &list, std::error_code &ec) noexcept {
+  return detail::vectored_io(list, ec, [fd](const struct iovec *iov, int count, std::size_t) {
+    return ::writev(fd, iov, count);
+  });
+}
+// Reads from fd into the list with readv until it is full or the end of the input; returns the bytes read
+template <typename T, std::size_t N>
+std::size_t readv_all(int fd, const span_list<T, N> &list, std::error_code &ec) noexcept {
+  static_assert(!std::is_const<T>::value, "cannot read into const segments");
+  return detail::vectored_io(list, ec, [fd](const struct iovec *iov, int count, std::size_t) {
+    return ::readv(fd, iov, count);
+  });
+}
+// As readv_all, from file position offset onwards without moving the file offset (preadv)
+template <typename T, std::size_t N>
+std::size_t preadv_all(int fd, const span_list<T, N> &list, off_t offset, std::error_code &ec) noexcept {
+  static_assert(!std::is_const<T>::value, "cannot read into const segments");
+  return detail::vectored_io(list, ec, [fd, offset](const struct iovec *iov, int count, std::size_t done) {
+    return ::preadv(fd, iov, count, offset + static_cast<off_t>(done));
+  });
+}
+
+#ifndef DD_SPAN_NO_EXCEPTIONS
+// Overloads that report failures as std::system_error
+template <typename T, std::size_t N> std::size_t writev_all(int fd, const span_list<T, N> &list) {
+  std::error_code ec;
+  return detail::throw_on_error(writev_all(fd, list, ec), ec, "dd::writev_all");
+}
+template <typename T, std::size_t N> std::size_t readv_all(int fd, const span_list<T, N> &list) {
+  std::error_code ec;
+  return detail::throw_on_error(readv_all(fd, list, ec), ec, "dd::readv_all");
+}
+template <typename T, std::size_t N> std::size_t preadv_all(int fd, const span_list<T, N> &list, off_t offset) {
+  std::error_code ec;
+  return detail::throw_on_error(preadv_all(fd, list, offset, ec), ec, "dd::preadv_all");
+}
+#endif
+
+#endif
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,339 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Non-owning sparse matrices made of spans, and host kernels that multiply them with dense vectors and matrices.
+//
+// csr_view and coo_view check their structure once, when they are constructed, through DD_SPAN_EXPECT; copies are
+// trusted, so a view checked on the host can be passed to a device kernel as is. The scans over every row and index
+// only run when contract violations throw or terminate: DD_SPAN_ASSUME_ON_CONTRACT_VIOLATION keeps just the O(1)
+// size checks as assumptions. The constructors read the index spans, so build the view where they are accessible.
+// spmv and spmm split the rows into parts of about the same number of non-zeros (plus one per row), so a few dense
+// rows do not leave the other threads idle.
+
+#include "chunks.hpp"
+#include "mdspan.hpp"
+#include "parallel.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+namespace detail {
+
+// Negative signed indices wrap to large values and fail the bound as well
+template <typename Index> DD_SPAN_API constexpr bool sparse_index_below(Index i, std::size_t bound) noexcept {
+  return static_cast<std::size_t>(i) < bound;
+}
+
+// row_ptr never decreases and every column is below cols; the O(1) parts of the structure are checked separately
+template <typename Index>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 bool csr_indices_valid(std::size_t cols, span<const Index> row_ptr,
+                                                       span<const Index> col_idx) noexcept {
+  for (std::size_t r = 0; r + 1 < row_ptr.size(); ++r) {
+    if (row_ptr[r + 1] < row_ptr[r]) {
+      return false;
+    }
+  }
+  for (std::size_t k = 0; k < col_idx.size(); ++k) {
+    if (!sparse_index_below(col_idx[k], cols)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Index>
+DD_SPAN_API DD_SPAN_CONSTEXPR14 bool coo_indices_valid(std::size_t rows, std::size_t cols, span<const Index> row_idx,
+                                                       span<const Index> col_idx) noexcept {
+  for (std::size_t k = 0; k < row_idx.size(); ++k) {
+    if (!sparse_index_below(row_idx[k], rows) || !sparse_index_below(col_idx[k], cols)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace detail
+
+// The non-zeros of one row: matching column indices and values
+template <typename T, typename Index> struct csr_row {
+  span<const Index> columns;
+  span<T> values;
+
+  DD_SPAN_API constexpr std::size_t size() const noexcept { return columns.size(); }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return columns.empty(); }
+};
+
+// Compressed sparse rows: row r holds the non-zeros [row_ptr[r], row_ptr[r + 1]) of col_idx and values. Iterating
+// the view yields one csr_row per row.
+template <typename T, typename Index = std::int32_t> class csr_view {
+  static_assert(std::is_integral<Index>::value, "sparse indices must be integers");
+
+public:
+  using element_type = T;
+  using index_type = Index;
+  using value_type = csr_row<T, Index>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = detail::index_iterator<csr_view>;
+
+  DD_SPAN_API constexpr csr_view() noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 csr_view(size_type rows, size_type cols, span<const Index> row_ptr,
+                                           span<const Index> col_idx, span<T> values)
+      : rows_(rows), cols_(cols), row_ptr_(row_ptr), col_idx_(col_idx), values_(values) {
+    DD_SPAN_EXPECT(values.size() == col_idx.size());
+    DD_SPAN_EXPECT(row_ptr.size() == rows + 1);
+    DD_SPAN_EXPECT(row_ptr[0] == Index(0) && static_cast<size_type>(row_ptr[rows]) == col_idx.size());
+#if defined(DD_SPAN_THROW_ON_CONTRACT_VIOLATION) || defined(DD_SPAN_TERMINATE_ON_CONTRACT_VIOLATION)
+    DD_SPAN_EXPECT(detail::csr_indices_valid(cols, row_ptr, col_idx));
+#endif
+  }
+  template <typename U, typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value &&
+                                                    !std::is_same<U, T>::value,
+                                                int>::type = 0>
+  DD_SPAN_API constexpr csr_view(const csr_view<U, Index> &other) noexcept
+      : rows_(other.rows()), cols_(other.cols()), row_ptr_(other.row_ptr()), col_idx_(other.col_idx()),
+        values_(other.values()) {}
+
+  DD_SPAN_API constexpr size_type rows() const noexcept { return rows_; }
+  DD_SPAN_API constexpr size_type cols() const noexcept { return cols_; }
+  DD_SPAN_API constexpr size_type nnz() const noexcept { return values_.size(); }
+  // number of rows, so that the view is a range of rows
+  DD_SPAN_API constexpr size_type size() const noexcept { return rows_; }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return rows_ == 0; }
+
+  DD_SPAN_API constexpr span<const Index> row_ptr() const noexcept { return row_ptr_; }
+  DD_SPAN_API constexpr span<const Index> col_idx() const noexcept { return col_idx_; }
+  DD_SPAN_API constexpr span<T> values() const noexcept { return values_; }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 value_type row(size_type r) const {
+    DD_SPAN_EXPECT(r < rows_);
+    return unchecked(r);
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 value_type operator[](size_type r) const { return row(r); }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 size_type row_nnz(size_type r) const {
+    DD_SPAN_EXPECT(r < rows_);
+    return static_cast<size_type>(row_ptr_[r + 1] - row_ptr_[r]);
+  }
+
+  DD_SPAN_API constexpr iterator begin() const noexcept { return iterator(*this, 0); }
+  DD_SPAN_API constexpr iterator end() const noexcept { return iterator(*this, static_cast<difference_type>(rows_)); }
+
+private:
+  friend class detail::index_iterator<csr_view>;
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 value_type unchecked(size_type r) const {
+    const auto first = static_cast<size_type>(row_ptr_[r]);
+    const auto count = static_cast<size_type>(row_ptr_[r + 1]) - first;
+    return value_type{span<const Index>(col_idx_.data() + first, count), span<T>(values_.data() + first, count)};
+  }
+
+  size_type rows_ = 0;
+  size_type cols_ = 0;
+  span<const Index> row_ptr_;
+  span<const Index> col_idx_;
+  span<T> values_;
+};
+
+// Coordinate format: non-zero k sits at (row_idx[k], col_idx[k]), in any order. Duplicates add up.
+template <typename T, typename Index = std::int32_t> class coo_view {
+  static_assert(std::is_integral<Index>::value, "sparse indices must be integers");
+
+public:
+  using element_type = T;
+  using index_type = Index;
+  using size_type = std::size_t;
+
+  DD_SPAN_API constexpr coo_view() noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 coo_view(size_type rows, size_type cols, span<const Index> row_idx,
+                                           span<const Index> col_idx, span<T> values)
+      : rows_(rows), cols_(cols), row_idx_(row_idx), col_idx_(col_idx), values_(values) {
+    DD_SPAN_EXPECT(values.size() == row_idx.size());
+    DD_SPAN_EXPECT(col_idx.size() == row_idx.size());
+#if defined(DD_SPAN_THROW_ON_CONTRACT_VIOLATION) || defined(DD_SPAN_TERMINATE_ON_CONTRACT_VIOLATION)
+    DD_SPAN_EXPECT(detail::coo_indices_valid(rows, cols, row_idx, col_idx));
+#endif
+  }
+  template <typename U, typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value &&
+                                                    !std::is_same<U, T>::value,
+                                                int>::type = 0>
+  DD_SPAN_API constexpr coo_view(const coo_view<U, Index> &other) noexcept
+      : rows_(other.rows()), cols_(other.cols()), row_idx_(other.row_idx()), col_idx_(other.col_idx()),
+        values_(other.values()) {}
+
+  DD_SPAN_API constexpr size_type rows() const noexcept { return rows_; }
+  DD_SPAN_API constexpr size_type cols() const noexcept { return cols_; }
+  DD_SPAN_API constexpr size_type nnz() const noexcept { return values_.size(); }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return values_.empty(); }
+
+  DD_SPAN_API constexpr span<const Index> row_idx() const noexcept { return row_idx_; }
+  DD_SPAN_API constexpr span<const Index> col_idx() const noexcept { return col_idx_; }
+  DD_SPAN_API constexpr span<T> values() const noexcept { return values_; }
+
+private:
+  size_type rows_ = 0;
+  size_type cols_ = 0;
+  span<const Index> row_idx_;
+  span<const Index> col_idx_;
+  span<T> values_;
+};
+
+namespace detail {
+
+// First row of part p out of parts, weighing each row as its non-zeros plus one so empty rows still count
+template <typename Index>
+inline std::size_t csr_part_begin(span<const Index> row_ptr, std::size_t p, std::size_t parts) noexcept {
+  const std::size_t rows = row_ptr.size() - 1;
+  const std::size_t work = static_cast<std::size_t>(row_ptr[rows]) + rows;
+  const std::size_t target = work / parts * p + work % parts * p / parts;
+  std::size_t lo = 0, hi = rows;
+  while (lo < hi) {
+    const std::size_t mid = lo + (hi - lo) / 2;
+    if (static_cast<std::size_t>(row_ptr[mid]) + mid < target) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// f(first_row, last_row) over row ranges of similar work
+template <typename Index, typename F> void csr_for_parts(thread_pool &pool, span<const Index> row_ptr, F f) {
+  const std::size_t rows = row_ptr.size() - 1;
+  if (rows == 0) {
+    return;
+  }
+  const std::size_t parts = parallel_tiles(pool, static_cast<std::size_t>(row_ptr[rows]) + rows);
+  pool.run(parts, [&](std::size_t p) {
+    f(csr_part_begin(row_ptr, p, parts), p + 1 == parts ? rows : csr_part_begin(row_ptr, p + 1, parts));
+  });
+}
+
+} // namespace detail
+
+// y = a * x
+template <typename T, typename Index, typename X, std::size_t E1, typename Y, std::size_t E2>
+void spmv(thread_pool &pool, const csr_view<T, Index> &a, span<X, E1> x, span<Y, E2> y) {
+  static_assert(!std::is_const<Y>::value, "cannot write to a span of const elements");
+  DD_SPAN_EXPECT(x.size() == a.cols() && y.size() == a.rows());
+  using value_type = typename std::remove_cv<Y>::type;
+  detail::csr_for_parts(pool, a.row_ptr(), [&](std::size_t first, std::size_t last) {
+    const Index *ptr = a.row_ptr().data();
+    const Index *cols = a.col_idx().data();
+    const T *vals = a.values().data();
+    for (std::size_t r = first; r < last; ++r) {
+      value_type acc = value_type();
+      for (auto k = static_cast<std::size_t>(ptr[r]), end = static_cast<std::size_t>(ptr[r + 1]); k < end; ++k) {
+        acc += vals[k] * x[static_cast<std::size_t>(cols[k])];
+      }
+      y[r] = acc;
+    }
+  });
+}
+template <typename T, typename Index, typename X, std::size_t E1, typename Y, std::size_t E2>
+void spmv(const csr_view<T, Index> &a, span<X, E1> x, span<Y, E2> y) {
+  spmv(default_thread_pool(), a, x, y);
+}
+
+// c = a * b for dense rank-2 b (cols x k) and c (rows x k); row-major (layout_right) b and c read and write whole
+// rows at a time
+template <typename T, typename Index, typename B, typename EB, typename LB, typename C, typename EC, typename LC>
+void spmm(thread_pool &pool, const csr_view<T, Index> &a, mdspan<B, EB, LB> b, mdspan<C, EC, LC> c) {
+  static_assert(EB::rank() == 2 && EC::rank() == 2, "spmm multiplies matrices");
+  static_assert(!std::is_const<C>::value, "cannot write to an mdspan of const elements");
+  DD_SPAN_EXPECT(static_cast<std::size_t>(b.extent(0)) == a.cols() &&
+                 static_cast<std::size_t>(c.extent(0)) == a.rows() && b.extent(1) == c.extent(1));
+  using value_type = typename std::remove_cv<C>::type;
+  const auto k = static_cast<std::size_t>(c.extent(1));
+  detail::csr_for_parts(pool, a.row_ptr(), [&](std::size_t first, std::size_t last) {
+    for (std::size_t r = first; r < last; ++r) {
+      for (std::size_t j = 0; j < k; ++j) {
+        c(r, j) = value_type();
+      }
+      const auto row = a.row(r);
+      for (std::size_t n = 0; n < row.size(); ++n) {
+        const auto col = static_cast<std::size_t>(row.columns[n]);
+        const auto v = row.values[n];
+        for (std::size_t j = 0; j < k; ++j) {
+          c(r, j) += v * b(col, j);
+        }
+      }
+    }
+  });
+}
+template <typename T, typename Index, typename B, typename EB, typename LB, typename C, typename EC, typename LC>
+void spmm(const csr_view<T, Index> &a, mdspan<B, EB, LB> b, mdspan<C, EC, LC> c) {
+  spmm(default_thread_pool(), a, b, c);
+}
+
+// y = a * x on the calling thread; entries may come in any order, so they are not split across threads
+template <typename T, typename Index, typename X, std::size_t E1, typename Y, std::size_t E2>
+void spmv(const coo_view<T, Index> &a, span<X, E1> x, span<Y, E2> y) {
+  static_assert(!std::is_const<Y>::value, "cannot write to a span of const elements");
+  DD_SPAN_EXPECT(x.size() == a.cols() && y.size() == a.rows());
+  for (auto &v : y) {
+    v = typename std::remove_cv<Y>::type();
+  }
+  for (std::size_t k = 0; k < a.nnz(); ++k) {
+    y[static_cast<std::size_t>(a.row_idx()[k])] += a.values()[k] * x[static_cast<std::size_t>(a.col_idx()[k])];
+  }
+}
+
+// Converts to CSR in the caller's storage with a counting sort by row, keeping the order of entries within a row.
+// row_ptr needs a.rows() + 1 elements, col_idx and values a.nnz() each.
+template <typename T, typename Index, typename V, std::size_t E1, std::size_t E2, std::size_t E3>
+csr_view<V, Index> csr_from_coo(const coo_view<T, Index> &a, span<Index, E1> row_ptr, span<Index, E2> col_idx,
+                                span<V, E3> values) {
+  DD_SPAN_EXPECT(row_ptr.size() == a.rows() + 1 && col_idx.size() == a.nnz() && values.size() == a.nnz());
+  for (auto &p : row_ptr) {
+    p = Index(0);
+  }
+  for (std::size_t k = 0; k < a.nnz(); ++k) {
+    ++row_ptr[static_cast<std::size_t>(a.row_idx()[k]) + 1];
+  }
+  for (std::size_t r = 0; r < a.rows(); ++r) {
+    row_ptr[r + 1] += row_ptr[r];
+  }
+  // row_ptr[r] serves as the insertion point of row r and ends up at the start of row r + 1; shift it back
+  for (std::size_t k = 0; k < a.nnz(); ++k) {
+    const auto r = static_cast<std::size_t>(a.row_idx()[k]);
+    const auto to = static_cast<std::size_t>(row_ptr[r]++);
+    col_idx[to] = a.col_idx()[k];
+    values[to] = a.values()[k];
+  }
+  for (std::size_t r = a.rows(); r > 0; --r) {
+    row_ptr[r] = row_ptr[r - 1];
+  }
+  row_ptr[0] = Index(0);
+  return csr_view<V, Index>(a.rows(), a.cols(), span<const Index>(row_ptr), span<const Index>(col_idx),
+                            span<V>(values));
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,320 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "span.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+// Strides are measured in bytes, so that a member of every element of an array of structs can be viewed
+DD_SPAN_INLINE_VAR constexpr std::size_t dynamic_stride = dynamic_extent;
+
+template <typename ElementType, std::size_t Extent = dynamic_extent, std::size_t Stride = dynamic_stride>
+class strided_span;
+
+namespace detail {
+
+// Stride storage, same trick as span_storage: static strides take no space
+template <std::size_t S> struct stride_storage {
+  DD_SPAN_API constexpr stride_storage() noexcept = default;
+  DD_SPAN_API constexpr explicit stride_storage(std::size_t /*unused*/) noexcept {}
+  DD_SPAN_API static constexpr std::size_t get() noexcept { return S; }
+};
+
+template <> struct stride_storage<dynamic_stride> {
+  DD_SPAN_API constexpr stride_storage() noexcept = default;
+  DD_SPAN_API constexpr explicit stride_storage(std::size_t p_stride) noexcept : stride(p_stride) {}
+  DD_SPAN_API constexpr std::size_t get() const noexcept { return stride; }
+  std::size_t stride = 0;
+};
+
+template <typename T> DD_SPAN_API inline T *byte_advance(T *ptr, std::ptrdiff_t bytes) noexcept {
+  using byte_pointer = typename std::conditional<std::is_const<T>::value, const char *, char *>::type;
+  return reinterpret_cast<T *>(reinterpret_cast<byte_pointer>(ptr) + bytes);
+}
+
+// Random-access iterator over a strided sequence; it keeps a base pointer plus an index so that the past-the-end
+// position never forms an out-of-bounds pointer
+template <typename T, std::size_t Stride> class strided_iterator : private stride_storage<Stride> {
+  using stride_type = stride_storage<Stride>;
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = typename std::remove_cv<T>::type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T *;
+  using reference = T &;
+
+  DD_SPAN_API constexpr strided_iterator() noexcept = default;
+  DD_SPAN_API constexpr strided_iterator(pointer base, difference_type idx, std::size_t stride) noexcept
+      : stride_type(stride), base_(base), idx_(idx) {}
+  template <typename U, typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value, int>::type = 0>
+  DD_SPAN_API constexpr strided_iterator(const strided_iterator<U, Stride> &other) noexcept
+      : stride_type(other.stride()), base_(other.base()), idx_(other.index()) {}
+
+  DD_SPAN_API reference operator*() const noexcept { return *operator->(); }
+  DD_SPAN_API pointer operator->() const noexcept {
+    return byte_advance(base_, idx_ * static_cast<difference_type>(stride()));
+  }
+  DD_SPAN_API reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 strided_iterator &operator++() noexcept {
+    ++idx_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 strided_iterator operator++(int) noexcept {
+    strided_iterator tmp = *this;
+    ++idx_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 strided_iterator &operator--() noexcept {
+    --idx_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 strided_iterator operator--(int) noexcept {
+    strided_iterator tmp = *this;
+    --idx_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 strided_iterator &operator+=(difference_type n) noexcept {
+    idx_ += n;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 strided_iterator &operator-=(difference_type n) noexcept {
+    idx_ -= n;
+    return *this;
+  }
+  DD_SPAN_API constexpr friend strided_iterator operator+(const strided_iterator &it, difference_type n) noexcept {
+    return strided_iterator(it.base_, it.idx_ + n, it.stride());
+  }
+  DD_SPAN_API constexpr friend strided_iterator operator+(difference_type n, const strided_iterator &it) noexcept {
+    return it + n;
+  }
+  DD_SPAN_API constexpr friend strided_iterator operator-(const strided_iterator &it, difference_type n) noexcept {
+    return strided_iterator(it.base_, it.idx_ - n, it.stride());
+  }
+  DD_SPAN_API constexpr friend difference_type operator-(const strided_iterator &lhs,
+                                                         const strided_iterator &rhs) noexcept {
+    return lhs.idx_ - rhs.idx_;
+  }
+
+  DD_SPAN_API constexpr friend bool operator==(const strided_iterator &lhs, const strided_iterator &rhs) noexcept {
+    return lhs.idx_ == rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator!=(const strided_iterator &lhs, const strided_iterator &rhs) noexcept {
+    return lhs.idx_ != rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator<(const strided_iterator &lhs, const strided_iterator &rhs) noexcept {
+    return lhs.idx_ < rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator>(const strided_iterator &lhs, const strided_iterator &rhs) noexcept {
+    return lhs.idx_ > rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator<=(const strided_iterator &lhs, const strided_iterator &rhs) noexcept {
+    return lhs.idx_ <= rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator>=(const strided_iterator &lhs, const strided_iterator &rhs) noexcept {
+    return lhs.idx_ >= rhs.idx_;
+  }
+
+  DD_SPAN_API constexpr pointer base() const noexcept { return base_; }
+  DD_SPAN_API constexpr difference_type index() const noexcept { return idx_; }
+  DD_SPAN_API constexpr std::size_t stride() const noexcept { return stride_type::get(); }
+
+private:
+  pointer base_ = nullptr;
+  difference_type idx_ = 0;
+};
+
+template <typename E, std::size_t S, std::size_t Stride> struct strided_span_storage : stride_storage<Stride> {
+  DD_SPAN_API constexpr strided_span_storage() noexcept = default;
+  DD_SPAN_API constexpr strided_span_storage(E *p_ptr, std::size_t p_size, std::size_t p_stride) noexcept
+      : stride_storage<Stride>(p_stride), data(p_ptr, p_size) {}
+  span_storage<E, S> data;
+};
+
+} // namespace detail
+
+// strided_span class
+
+template <typename ElementType, std::size_t Extent, std::size_t Stride> class strided_span {
+  static_assert(std::is_object<ElementType>::value, "ElementType must be object");
+  static_assert(detail::is_complete<ElementType>::value, "ElementType must be complete");
+  static_assert(!std::is_abstract<ElementType>::value, "ElementType cannot be abstract");
+  static_assert(Stride == dynamic_stride || (Stride != 0 && Stride % alignof(ElementType) == 0),
+                "Stride must be a non-zero multiple of the alignment of ElementType");
+  using storage_type = detail::strided_span_storage<ElementType, Extent, Stride>;
+
+  template <std::size_t Count>
+  using subspan_type = strided_span<ElementType, Count, Stride>;
+
+public:
+  using element_type = ElementType;
+  using value_type = typename std::remove_cv<ElementType>::type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = element_type *;
+  using const_pointer = const element_type *;
+  using reference = element_type &;
+  using const_reference = const element_type &;
+  using iterator = detail::strided_iterator<element_type, Stride>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  static constexpr size_type extent = Extent;
+  static constexpr size_type static_stride = Stride;
+
+  // constructors
+  template <std::size_t E = Extent, typename std::enable_if<(E == dynamic_extent || E <= 0), int>::type = 0>
+  DD_SPAN_API constexpr strided_span() noexcept {}
+
+  template <std::size_t S = Stride, typename std::enable_if<S != dynamic_stride, int>::type = 0>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 strided_span(pointer ptr, size_type count) : storage_(ptr, count, Stride) {
+    DD_SPAN_EXPECT(extent == dynamic_extent || count == extent);
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 strided_span(pointer ptr, size_type count, size_type stride_bytes)
+      : storage_(ptr, count, stride_bytes) {
+    DD_SPAN_EXPECT(extent == dynamic_extent || count == extent);
+    DD_SPAN_EXPECT((Stride == dynamic_stride ? (stride_bytes != 0 && stride_bytes % alignof(element_type) == 0)
+                                             : stride_bytes == Stride));
+  }
+  // A contiguous span is a strided span with a stride of one element
+  template <typename U, std::size_t N,
+            typename std::enable_if<std::is_convertible<U (*)[], ElementType (*)[]>::value &&
+                                        (Extent == dynamic_extent || Extent == N) &&
+                                        (Stride == dynamic_stride || Stride == sizeof(U)),
+                                    int>::type = 0>
+  DD_SPAN_API constexpr strided_span(const span<U, N> &other) noexcept
+      : storage_(other.data(), other.size(), sizeof(U)) {}
+  template <typename U, std::size_t N, std::size_t S,
+            typename std::enable_if<std::is_convertible<U (*)[], ElementType (*)[]>::value &&
+                                        (Extent == dynamic_extent || Extent == N) &&
+                                        (Stride == dynamic_stride || Stride == S),
+                                    int>::type = 0>
+  DD_SPAN_API constexpr strided_span(const strided_span<U, N, S> &other) noexcept
+      : storage_(other.data(), other.size(), other.stride()) {}
+
+  DD_SPAN_API constexpr strided_span(const strided_span &other) noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR_ASSIGN strided_span &operator=(const strided_span &other) noexcept = default;
+  DD_SPAN_API ~strided_span() noexcept = default;
+
+  // subviews
+  template <std::size_t Count> DD_SPAN_API DD_SPAN_CONSTEXPR11 subspan_type<Count> first() const {
+    DD_SPAN_EXPECT(Count <= size());
+    return {data(), Count, stride()};
+  }
+  template <std::size_t Count> DD_SPAN_API DD_SPAN_CONSTEXPR11 subspan_type<Count> last() const {
+    DD_SPAN_EXPECT(Count <= size());
+    return {element_at(size() - Count), Count, stride()};
+  }
+  template <std::size_t Offset, std::size_t Count = dynamic_extent>
+  DD_SPAN_API DD_SPAN_CONSTEXPR11
+      subspan_type<Count != dynamic_extent ? Count : (Extent != dynamic_extent ? Extent - Offset : dynamic_extent)>
+      subspan() const {
+    DD_SPAN_EXPECT(Offset <= size() && (Count == dynamic_extent || Offset + Count <= size()));
+    return {element_at(Offset), Count != dynamic_extent ? Count : size() - Offset, stride()};
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 subspan_type<dynamic_extent> first(size_type count) const {
+    DD_SPAN_EXPECT(count <= size());
+    return {data(), count, stride()};
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 subspan_type<dynamic_extent> last(size_type count) const {
+    DD_SPAN_EXPECT(count <= size());
+    return {element_at(size() - count), count, stride()};
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 subspan_type<dynamic_extent> subspan(size_type off,
+                                                                       size_type cnt = dynamic_extent) const {
+    DD_SPAN_EXPECT(off <= size() && (cnt == dynamic_extent || off + cnt <= size()));
+    return {element_at(off), cnt == dynamic_extent ? size() - off : cnt, stride()};
+  }
+
+  // observers
+  DD_SPAN_API constexpr size_type size() const noexcept { return storage_.data.size; }
+  DD_SPAN_API constexpr size_type stride() const noexcept { return storage_.get(); }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return size() == 0; }
+
+  // element access
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return *element_at(idx);
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference front() const {
+    DD_SPAN_EXPECT(!empty());
+    return *data();
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference back() const {
+    DD_SPAN_EXPECT(!empty());
+    return *element_at(size() - 1);
+  }
+  DD_SPAN_API constexpr pointer data() const noexcept { return storage_.data.ptr; }
+
+  // iterators
+  DD_SPAN_API constexpr iterator begin() const noexcept { return iterator(data(), 0, stride()); }
+  DD_SPAN_API constexpr iterator end() const noexcept {
+    return iterator(data(), static_cast<difference_type>(size()), stride());
+  }
+  DD_SPAN_API DD_SPAN_ARRAY_CONSTEXPR reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  DD_SPAN_API DD_SPAN_ARRAY_CONSTEXPR reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+private:
+  DD_SPAN_API pointer element_at(size_type idx) const noexcept {
+    return detail::byte_advance(data(), static_cast<difference_type>(idx * stride()));
+  }
+
+  storage_type storage_;
+};
+
+#ifdef DD_SPAN_HAVE_DEDUCTION_GUIDES
+template <class T, std::size_t N> DD_SPAN_API strided_span(const span<T, N> &) -> strided_span<T, N, sizeof(T)>;
+#endif
+
+// free makers
+
+// View of one member of every element, e.g. the x coordinate of every particle
+template <typename ET, std::size_t E, typename M, typename S,
+          typename std::enable_if<std::is_same<typename std::remove_cv<ET>::type, S>::value, int>::type = 0>
+DD_SPAN_API strided_span<typename std::conditional<std::is_const<ET>::value, const M, M>::type, E, sizeof(ET)>
+member_span(span<ET, E> s, M S::*member) noexcept {
+  return {s.empty() ? nullptr : &(s.data()->*member), s.size()};
+}
+
+// Every step-th element of a span, starting with the first; a column of a row-major matrix is
+// stride_span(rows.subspan(j), ncols)
+template <std::size_t Step, typename ET, std::size_t E>
+DD_SPAN_API DD_SPAN_CONSTEXPR11
+    strided_span<ET, (E == dynamic_extent ? dynamic_extent : (E + Step - 1) / Step), Step * sizeof(ET)>
+    stride_span(span<ET, E> s) {
+  static_assert(Step != 0, "Step must be positive");
+  return {s.data(), (s.size() + Step - 1) / Step};
+}
+template <typename ET, std::size_t E>
+DD_SPAN_API DD_SPAN_CONSTEXPR11 strided_span<ET> stride_span(span<ET, E> s, std::size_t step) {
+  DD_SPAN_EXPECT(step != 0);
+  return {s.data(), (s.size() + step - 1) / step, step * sizeof(ET)};
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
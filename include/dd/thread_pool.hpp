@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Host-only: a small work-stealing thread pool used by the parallel span algorithms
+
+#include "span.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+class thread_pool {
+public:
+  // Number of worker threads; the thread calling run() always takes part as well
+  explicit thread_pool(std::size_t workers = default_workers()) : queues_(workers + 1) {
+    for (auto &q : queues_) {
+      q.reset(new queue);
+    }
+    threads_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+      threads_.emplace_back([this, i] { worker_loop(i + 1); });
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+  thread_pool &operator=(const thread_pool &) = delete;
+
+  ~thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto &t : threads_) {
+      t.join();
+    }
+  }
+
+  // Threads that execute tasks during run(), including the caller
+  std::size_t concurrency() const noexcept { return threads_.size() + 1; }
+
+  // Calls f(i) for every i in [0, count) and blocks until all calls have returned. Tasks are spread over the
+  // worker queues; idle workers steal from the others. The first exception thrown by f is rethrown here.
+  template <typename F> void run(std::size_t count, F &&f) {
+    if (count == 0) {
+      return;
+    }
+    if (count == 1 || threads_.empty()) {
+      for (std::size_t i = 0; i < count; ++i) {
+        f(i);
+      }
+      return;
+    }
+    using fn_type = typename std::remove_reference<F>::type;
+    batch b;
+    b.ctx = static_cast<void *>(std::addressof(f));
+    b.invoke = [](void *ctx, std::size_t i) { (*static_cast<fn_type *>(ctx))(i); };
+    b.pending.store(count, std::memory_order_relaxed);
+
+    // The caller's own queue gets the first share, so it starts working without stealing
+    const std::size_t nqueues = queues_.size();
+    const std::size_t self = current_queue(nqueues);
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      queued_.fetch_add(count, std::memory_order_release);
+    }
+    for (std::size_t q = 0; q < nqueues; ++q) {
+      queue &dst = *queues_[(self + q) % nqueues];
+      std::lock_guard<std::mutex> lock(dst.mutex);
+      for (std::size_t i = q; i < count; i += nqueues) {
+        dst.tasks.push_back(task{&b, i});
+      }
+    }
+    sleep_cv_.notify_all();
+
+    while (b.pending.load(std::memory_order_acquire) != 0) {
+      task t;
+      if (try_pop(self, t) || try_steal(self, t)) {
+        execute(t);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    if (b.error) {
+      std::rethrow_exception(b.error);
+    }
+  }
+
+  static std::size_t default_workers() noexcept {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 0;
+  }
+
+private:
+  struct batch {
+    void *ctx = nullptr;
+    void (*invoke)(void *, std::size_t) = nullptr;
+    std::atomic<std::size_t> pending{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+  };
+
+  struct task {
+    batch *owner;
+    std::size_t index;
+  };
+
+  // One deque per thread; each is allocated separately and padded past a cache line so that owners and thieves
+  // of neighbouring queues do not false-share
+  struct queue {
+    std::mutex mutex;
+    std::deque<task> tasks;
+    char padding[64];
+  };
+
+  static std::size_t &queue_index() noexcept {
+    static thread_local std::size_t index = 0;
+    return index;
+  }
+  static std::size_t current_queue(std::size_t nqueues) noexcept {
+    return queue_index() < nqueues ? queue_index() : 0;
+  }
+
+  // Owners take the most recently pushed task, thieves the oldest one
+  bool try_pop(std::size_t self, task &t) {
+    queue &q = *queues_[self];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) {
+      return false;
+    }
+    t = q.tasks.back();
+    q.tasks.pop_back();
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+  bool try_steal(std::size_t self, task &t) {
+    for (std::size_t k = 1; k < queues_.size(); ++k) {
+      queue &q = *queues_[(self + k) % queues_.size()];
+      std::unique_lock<std::mutex> lock(q.mutex, std::try_to_lock);
+      if (!lock.owns_lock() || q.tasks.empty()) {
+        continue;
+      }
+      t = q.tasks.front();
+      q.tasks.pop_front();
+      queued_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+  static void execute(const task &t) {
+    batch &b = *t.owner;
+#ifndef DD_SPAN_NO_EXCEPTIONS
+    try {
+      b.invoke(b.ctx, t.index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(b.error_mutex);
+      if (!b.error) {
+        b.error = std::current_exception();
+      }
+    }
+#else
+    b.invoke(b.ctx, t.index);
+#endif
+    b.pending.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  void worker_loop(std::size_t self) {
+    queue_index() = self;
+    for (;;) {
+      task t;
+      if (try_pop(self, t) || try_steal(self, t)) {
+        execute(t);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      sleep_cv_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) != 0; });
+      if (stop_ && queued_.load(std::memory_order_acquire) == 0) {
+        return;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<queue>> queues_;
+  std::vector<std::thread> threads_;
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  std::atomic<std::size_t> queued_{0};
+  bool stop_ = false;
+};
+
+// Process-wide pool used when no pool is passed explicitly
+inline thread_pool &default_thread_pool() {
+  static thread_pool pool;
+  return pool;
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: MIT
+//
+// MIT License
+//
+// Copyright (c) 2025 Marco Barbone
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "span.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace DD_SPAN_NAMESPACE_NAME {
+
+template <typename... ElementTypes> class zip_span;
+
+namespace detail {
+
+template <std::size_t I, typename T> struct zip_leaf {
+  DD_SPAN_API constexpr zip_leaf() noexcept = default;
+  DD_SPAN_API constexpr explicit zip_leaf(T *p_ptr) noexcept : ptr(p_ptr) {}
+  T *ptr = nullptr;
+};
+
+// One base pointer per member; the proxies below add a shared index to each of them
+template <typename Seq, typename... Ts> struct zip_pointers;
+template <std::size_t... I, typename... Ts>
+struct zip_pointers<std::index_sequence<I...>, Ts...> : zip_leaf<I, Ts>... {
+  DD_SPAN_API constexpr zip_pointers() noexcept = default;
+  DD_SPAN_API constexpr explicit zip_pointers(Ts *...ptrs) noexcept : zip_leaf<I, Ts>(ptrs)... {}
+  DD_SPAN_API constexpr zip_pointers advanced(std::size_t off) const noexcept {
+    return zip_pointers(static_cast<const zip_leaf<I, Ts> &>(*this).ptr + off...);
+  }
+};
+
+template <std::size_t I, typename T> DD_SPAN_API constexpr T *leaf_ptr(const zip_leaf<I, T> &leaf) noexcept {
+  return leaf.ptr;
+}
+
+template <std::size_t I, typename... Ts> using nth_type = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+template <typename... Ts> using zip_pointers_t = zip_pointers<std::index_sequence_for<Ts...>, Ts...>;
+
+} // namespace detail
+
+// Proxy for the i-th element of every member of a zip_span; supports get<I>() and structured bindings
+template <typename... Ts> class zip_reference {
+public:
+  DD_SPAN_API constexpr zip_reference(const detail::zip_pointers_t<Ts...> &ptrs, std::size_t idx) noexcept
+      : ptrs_(ptrs), idx_(idx) {}
+
+  template <std::size_t I> DD_SPAN_API constexpr detail::nth_type<I, Ts...> &get() const noexcept {
+    return detail::leaf_ptr<I>(ptrs_)[idx_];
+  }
+
+  // Host-side copy of the referenced values
+  DD_SPAN_API operator std::tuple<typename std::remove_cv<Ts>::type...>() const {
+    return to_tuple(std::index_sequence_for<Ts...>{});
+  }
+
+private:
+  template <std::size_t... I>
+  DD_SPAN_API std::tuple<typename std::remove_cv<Ts>::type...> to_tuple(std::index_sequence<I...>) const {
+    return std::tuple<typename std::remove_cv<Ts>::type...>(get<I>()...);
+  }
+
+  detail::zip_pointers_t<Ts...> ptrs_;
+  std::size_t idx_;
+};
+
+template <std::size_t I, typename... Ts>
+DD_SPAN_API constexpr detail::nth_type<I, Ts...> &get(const zip_reference<Ts...> &ref) noexcept {
+  return ref.template get<I>();
+}
+
+namespace detail {
+
+template <typename... Ts> class zip_iterator {
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::tuple<typename std::remove_cv<Ts>::type...>;
+  using difference_type = std::ptrdiff_t;
+  using reference = zip_reference<Ts...>;
+  using pointer = void;
+
+  DD_SPAN_API constexpr zip_iterator() noexcept = default;
+  DD_SPAN_API constexpr zip_iterator(const zip_pointers_t<Ts...> &ptrs, difference_type idx) noexcept
+      : ptrs_(ptrs), idx_(idx) {}
+
+  DD_SPAN_API constexpr reference operator*() const noexcept {
+    return reference(ptrs_, static_cast<std::size_t>(idx_));
+  }
+  DD_SPAN_API constexpr reference operator[](difference_type n) const noexcept {
+    return reference(ptrs_, static_cast<std::size_t>(idx_ + n));
+  }
+
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 zip_iterator &operator++() noexcept {
+    ++idx_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 zip_iterator operator++(int) noexcept {
+    zip_iterator tmp = *this;
+    ++idx_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 zip_iterator &operator--() noexcept {
+    --idx_;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 zip_iterator operator--(int) noexcept {
+    zip_iterator tmp = *this;
+    --idx_;
+    return tmp;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 zip_iterator &operator+=(difference_type n) noexcept {
+    idx_ += n;
+    return *this;
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR14 zip_iterator &operator-=(difference_type n) noexcept {
+    idx_ -= n;
+    return *this;
+  }
+  DD_SPAN_API constexpr friend zip_iterator operator+(const zip_iterator &it, difference_type n) noexcept {
+    return zip_iterator(it.ptrs_, it.idx_ + n);
+  }
+  DD_SPAN_API constexpr friend zip_iterator operator+(difference_type n, const zip_iterator &it) noexcept {
+    return it + n;
+  }
+  DD_SPAN_API constexpr friend zip_iterator operator-(const zip_iterator &it, difference_type n) noexcept {
+    return zip_iterator(it.ptrs_, it.idx_ - n);
+  }
+  DD_SPAN_API constexpr friend difference_type operator-(const zip_iterator &lhs, const zip_iterator &rhs) noexcept {
+    return lhs.idx_ - rhs.idx_;
+  }
+
+  DD_SPAN_API constexpr friend bool operator==(const zip_iterator &lhs, const zip_iterator &rhs) noexcept {
+    return lhs.idx_ == rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator!=(const zip_iterator &lhs, const zip_iterator &rhs) noexcept {
+    return lhs.idx_ != rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator<(const zip_iterator &lhs, const zip_iterator &rhs) noexcept {
+    return lhs.idx_ < rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator>(const zip_iterator &lhs, const zip_iterator &rhs) noexcept {
+    return lhs.idx_ > rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator<=(const zip_iterator &lhs, const zip_iterator &rhs) noexcept {
+    return lhs.idx_ <= rhs.idx_;
+  }
+  DD_SPAN_API constexpr friend bool operator>=(const zip_iterator &lhs, const zip_iterator &rhs) noexcept {
+    return lhs.idx_ >= rhs.idx_;
+  }
+
+private:
+  zip_pointers_t<Ts...> ptrs_;
+  difference_type idx_ = 0;
+};
+
+} // namespace detail
+
+// zip_span class: several equally sized spans walked in lockstep, with a single size check at construction
+
+template <typename... ElementTypes> class zip_span {
+  static_assert(sizeof...(ElementTypes) != 0, "zip_span needs at least one member");
+  using pointers_type = detail::zip_pointers_t<ElementTypes...>;
+
+public:
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::tuple<typename std::remove_cv<ElementTypes>::type...>;
+  using reference = zip_reference<ElementTypes...>;
+  using iterator = detail::zip_iterator<ElementTypes...>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  template <std::size_t I> using member_type = span<detail::nth_type<I, ElementTypes...>>;
+  static constexpr size_type arity = sizeof...(ElementTypes);
+
+  // constructors
+  DD_SPAN_API constexpr zip_span() noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 explicit zip_span(span<ElementTypes>... spans)
+      : ptrs_(spans.data()...), size_(size_of_first(spans...)) {
+    DD_SPAN_EXPECT(same_sizes(size_, spans...));
+  }
+
+  DD_SPAN_API constexpr zip_span(const zip_span &other) noexcept = default;
+  DD_SPAN_API DD_SPAN_CONSTEXPR_ASSIGN zip_span &operator=(const zip_span &other) noexcept = default;
+  DD_SPAN_API ~zip_span() noexcept = default;
+
+  // subviews, applied to every member at once
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 zip_span first(size_type count) const {
+    DD_SPAN_EXPECT(count <= size());
+    return zip_span(ptrs_, count);
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 zip_span last(size_type count) const {
+    DD_SPAN_EXPECT(count <= size());
+    return zip_span(ptrs_.advanced(size() - count), count);
+  }
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 zip_span subspan(size_type off, size_type cnt = dynamic_extent) const {
+    DD_SPAN_EXPECT(off <= size() && (cnt == dynamic_extent || off + cnt <= size()));
+    return zip_span(ptrs_.advanced(off), cnt == dynamic_extent ? size() - off : cnt);
+  }
+
+  // observers
+  DD_SPAN_API constexpr size_type size() const noexcept { return size_; }
+  DD_SPAN_API DD_SPAN_NODISCARD constexpr bool empty() const noexcept { return size() == 0; }
+
+  // element access
+  DD_SPAN_API DD_SPAN_CONSTEXPR11 reference operator[](size_type idx) const {
+    DD_SPAN_EXPECT(idx < size());
+    return reference(ptrs_, idx);
+  }
+  // The I-th member as a plain span; all members share the same size
+  template <std::size_t I> DD_SPAN_API constexpr member_type<I> member() const noexcept {
+    return member_type<I>(detail::leaf_ptr<I>(ptrs_), size_);
+  }
+
+  // iterators
+  DD_SPAN_API constexpr iterator begin() const noexcept { return iterator(ptrs_, 0); }
+  DD_SPAN_API constexpr iterator end() const noexcept { return iterator(ptrs_, static_cast<difference_type>(size_)); }
+  DD_SPAN_API DD_SPAN_ARRAY_CONSTEXPR reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  DD_SPAN_API DD_SPAN_ARRAY_CONSTEXPR reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+private:
+  DD_SPAN_API constexpr zip_span(const pointers_type &ptrs, size_type count) noexcept : ptrs_(ptrs), size_(count) {}
+
+  template <typename S, typename... Ss> DD_SPAN_API static constexpr size_type size_of_first(S s, Ss...) noexcept {
+    return s.size();
+  }
+  template <typename... Ss> DD_SPAN_API static DD_SPAN_CONSTEXPR14 bool same_sizes(size_type n, Ss... spans) noexcept {
+    const bool equal[] = {(spans.size() == n)...};
+    bool ok = true;
+    for (bool e : equal) {
+      ok = ok && e;
+    }
+    return ok;
+  }
+
+  pointers_type ptrs_;
+  size_type size_ = 0;
+};
+
+#ifdef DD_SPAN_HAVE_DEDUCTION_GUIDES
+template <class... Ts, std::size_t... Es> DD_SPAN_API zip_span(span<Ts, Es>...) -> zip_span<Ts...>;
+#endif
+
+// free makers
+
+template <typename... ETs, std::size_t... Es>
+DD_SPAN_API DD_SPAN_CONSTEXPR11 zip_span<ETs...> make_zip_span(span<ETs, Es>... spans) {
+  return zip_span<ETs...>(spans...);
+}
+
+} // namespace DD_SPAN_NAMESPACE_NAME
+
+namespace std {
+
+template <typename... Ts>
+struct tuple_size<DD_SPAN_NAMESPACE_NAME::zip_reference<Ts...>> : public integral_constant<size_t, sizeof...(Ts)> {};
+template <size_t I, typename... Ts> struct tuple_element<I, DD_SPAN_NAMESPACE_NAME::zip_reference<Ts...>> {
+  using type = DD_SPAN_NAMESPACE_NAME::detail::nth_type<I, Ts...> &;
+};
+
+} // namespace std
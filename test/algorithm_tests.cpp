@@ -0,0 +1,225 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/algorithm.hpp"
+
+using dd::contract_violation_error;
+using dd::copy_hint;
+using dd::span;
+
+// Compile-time assertions
+static_assert(dd::detail::is_memcpy_copyable<const int, int>::value, "ints copy as bytes");
+static_assert(!dd::detail::is_memcpy_copyable<int, long>::value, "conversions are not byte copies");
+static_assert(!dd::detail::is_memcpy_copyable<const std::string, std::string>::value, "strings copy element-wise");
+static_assert(dd::detail::is_memcmp_equal<const unsigned, unsigned>::value, "integers compare as bytes");
+static_assert(!dd::detail::is_memcmp_equal<double, double>::value, "doubles do not compare as bytes");
+static_assert(dd::detail::is_memcmp_ordered<const unsigned char, unsigned char>::value, "bytes order as memcmp");
+static_assert(!dd::detail::is_memcmp_ordered<signed char, signed char>::value, "signed bytes do not");
+static_assert(!dd::detail::is_memcmp_ordered<std::uint32_t, std::uint32_t>::value, "wider integers do not");
+
+namespace {
+
+enum class color : std::uint8_t { red, green, blue };
+
+} // namespace
+
+TEST_CASE("copy writes the front of the destination", "[algorithm][copy]") {
+    std::vector<int> src(100);
+    std::iota(src.begin(), src.end(), 1);
+    std::vector<int> dst(120, 0);
+    const span<int> rest = dd::copy(span<const int>(src), span<int>(dst));
+    REQUIRE(rest.data() == dst.data() + 100);
+    REQUIRE(rest.size() == 20u);
+    REQUIRE(std::equal(src.begin(), src.end(), dst.begin()));
+    REQUIRE(dst[100] == 0);
+
+    REQUIRE(dd::copy(span<const int>(), span<int>(dst)).size() == 120u);
+    REQUIRE(dd::copy(span<const int>(), span<int>()).empty());
+}
+
+TEST_CASE("copy handles static extents and non-trivial elements", "[algorithm][copy]") {
+    std::array<double, 4> small = {{1.5, 2.5, 3.5, 4.5}};
+    std::array<double, 4> out{};
+    dd::copy(span<const double, 4>(small), span<double, 4>(out));
+    REQUIRE(out == small);
+
+    std::array<std::string, 3> words = {{"alpha", "beta", "a string too long for the small buffer"}};
+    std::array<std::string, 5> copied;
+    const auto rest = dd::copy(span<const std::string, 3>(words), span<std::string, 5>(copied));
+    REQUIRE(rest.size() == 2u);
+    REQUIRE(copied[2] == words[2]);
+    REQUIRE(copied[3].empty());
+
+    std::vector<std::string> many(40, "x");
+    std::vector<std::string> many_out(40);
+    dd::copy(span<const std::string>(many), span<std::string>(many_out));
+    REQUIRE(many_out == many);
+
+    std::array<int, 3> ints = {{-1, 2, -3}};
+    std::array<long, 3> longs{};
+    dd::copy(span<const int, 3>(ints), span<long, 3>(longs));
+    REQUIRE(longs[2] == -3L);
+}
+
+TEST_CASE("Streaming copy matches a plain copy at any size and alignment", "[algorithm][copy][streaming]") {
+    std::vector<unsigned char> src(5000);
+    for (std::size_t i = 0; i < src.size(); ++i) src[i] = static_cast<unsigned char>(i * 7 + 3);
+    for (std::size_t n : {0u, 1u, 15u, 63u, 64u, 79u, 200u, 4093u}) {
+        for (std::size_t misalign : {0u, 1u, 8u, 15u}) {
+            std::vector<unsigned char> dst(n + 32, 0xee);
+            const auto rest = dd::copy(span<const unsigned char>(src.data() + 3, n),
+                                       span<unsigned char>(dst.data() + misalign, n + 8), copy_hint::streaming);
+            REQUIRE(rest.size() == 8u);
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(dst[misalign + i] == src[3 + i]);
+            for (std::size_t i = 0; i < misalign; ++i) REQUIRE(dst[i] == 0xee);
+            for (std::size_t i = misalign + n; i < dst.size(); ++i) REQUIRE(dst[i] == 0xee);
+        }
+    }
+
+    std::vector<std::string> words(3, "word");
+    std::vector<std::string> out(3);
+    dd::copy(span<const std::string>(words), span<std::string>(out), copy_hint::streaming);
+    REQUIRE(out == words);
+    std::vector<float> floats(1000, 2.0f), floats_out(1000);
+    dd::copy(span<const float>(floats), span<float>(floats_out), copy_hint::none);
+    REQUIRE(floats_out == floats);
+}
+
+TEST_CASE("fill assigns every element", "[algorithm][fill]") {
+    std::vector<int> zeros(77, 5);
+    dd::fill(span<int>(zeros), 0);
+    REQUIRE(std::all_of(zeros.begin(), zeros.end(), [](int x) { return x == 0; }));
+
+    std::vector<std::uint32_t> pattern(33);
+    dd::fill(span<std::uint32_t>(pattern), 0x01020304u);
+    REQUIRE(std::all_of(pattern.begin(), pattern.end(), [](std::uint32_t x) { return x == 0x01020304u; }));
+    dd::fill(span<std::uint32_t>(pattern).subspan(1, 31), 0xffffffffu);
+    REQUIRE(pattern[0] == 0x01020304u);
+    REQUIRE(pattern[1] == 0xffffffffu);
+    REQUIRE(pattern[32] == 0x01020304u);
+
+    std::vector<double> doubles(10, 1.0);
+    dd::fill(span<double>(doubles), -0.0);
+    REQUIRE(std::signbit(doubles[9]));
+
+    std::array<std::string, 4> strings;
+    dd::fill(span<std::string, 4>(strings), std::string("same"));
+    REQUIRE(strings[3] == "same");
+    std::vector<std::string> more(20);
+    dd::fill(span<std::string>(more), std::string("more"));
+    REQUIRE(more[19] == "more");
+
+    dd::fill(span<int>(), 1);
+}
+
+TEST_CASE("equal compares sizes and elements", "[algorithm][equal]") {
+    std::vector<int> a(50), b(50);
+    std::iota(a.begin(), a.end(), 0);
+    std::iota(b.begin(), b.end(), 0);
+    REQUIRE(dd::equal(span<const int>(a), span<int>(b)));
+    b[49] = -1;
+    REQUIRE(!dd::equal(span<const int>(a), span<const int>(b)));
+    REQUIRE(!dd::equal(span<const int>(a), span<const int>(a).first(49)));
+    REQUIRE(dd::equal(span<const int>(), span<const int>()));
+
+    std::array<color, 3> c1 = {{color::red, color::green, color::blue}};
+    std::array<color, 3> c2 = c1;
+    REQUIRE(dd::equal(span<const color, 3>(c1), span<const color, 3>(c2)));
+    c2[0] = color::blue;
+    REQUIRE(!dd::equal(span<const color>(c1), span<const color>(c2)));
+
+    // Floating-point equality, not bitwise equality
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> z1(20, 0.0), z2(20, -0.0);
+    REQUIRE(dd::equal(span<const double>(z1), span<const double>(z2)));
+    z1[5] = z2[5] = nan;
+    REQUIRE(!dd::equal(span<const double>(z1), span<const double>(z2)));
+    std::array<double, 2> s1 = {{0.0, nan}}, s2 = {{-0.0, nan}};
+    REQUIRE(!dd::equal(span<const double, 2>(s1), span<const double, 2>(s2)));
+    REQUIRE(dd::equal(span<const double, 1>(s1.data(), 1), span<const double, 1>(s2.data(), 1)));
+
+    std::vector<int> ints = {1, 2, 3};
+    std::vector<long> longs = {1, 2, 3};
+    REQUIRE(dd::equal(span<const int>(ints), span<const long>(longs)));
+}
+
+TEST_CASE("lexicographical_compare orders like std", "[algorithm][compare]") {
+    const std::vector<std::vector<unsigned char>> bytes = {{}, {0}, {0, 0}, {0, 1}, {1}, {0x80}, {0xff, 0}};
+    for (const auto &x : bytes) {
+        for (const auto &y : bytes) {
+            REQUIRE(dd::lexicographical_compare(span<const unsigned char>(x), span<const unsigned char>(y)) ==
+                    std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
+        }
+    }
+    const std::vector<std::vector<int>> ints = {{}, {-1}, {-1, 5}, {0}, {1 << 20}, {-(1 << 20), 0}};
+    for (const auto &x : ints) {
+        for (const auto &y : ints) {
+            REQUIRE(dd::lexicographical_compare(span<const int>(x), span<const int>(y)) ==
+                    std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
+        }
+    }
+    std::array<std::string, 2> s1 = {{"a", "b"}}, s2 = {{"a", "c"}};
+    REQUIRE(dd::lexicographical_compare(span<const std::string, 2>(s1), span<const std::string, 2>(s2)));
+    REQUIRE(!dd::lexicographical_compare(span<const std::string, 2>(s2), span<const std::string, 2>(s1)));
+    REQUIRE(!dd::lexicographical_compare(span<const std::string>(s1), span<const std::string>(s1)));
+}
+
+TEST_CASE("static_for_each visits elements in order", "[algorithm][static]") {
+    std::array<int, 5> v = {{1, 2, 3, 4, 5}};
+    struct collect {
+        std::vector<int> seen;
+        void operator()(int x) { seen.push_back(x); }
+    };
+    const collect c = dd::static_for_each(span<const int, 5>(v), collect{});
+    REQUIRE(c.seen == std::vector<int>{1, 2, 3, 4, 5});
+
+    dd::static_for_each(span<int, 5>(v), [](int &x) { x *= 10; });
+    REQUIRE(v[4] == 50);
+    int calls = 0;
+    dd::static_for_each(span<int, 0>(), [&](int) { ++calls; });
+    REQUIRE(calls == 0);
+}
+
+TEST_CASE("static_transform maps one or two spans", "[algorithm][static]") {
+    std::array<float, 3> a = {{1.0f, 2.0f, 3.0f}};
+    std::array<float, 3> b = {{4.0f, 5.0f, 6.0f}};
+    std::array<double, 3> out{};
+    dd::static_transform(span<const float, 3>(a), span<double, 3>(out), [](float x) { return x * 0.5; });
+    REQUIRE(out[2] == 1.5);
+    dd::static_transform(span<const float, 3>(a), span<const float, 3>(b), span<double, 3>(out),
+                         [](float x, float y) { return double(x) * y; });
+    REQUIRE(out == (std::array<double, 3>{{4.0, 10.0, 18.0}}));
+
+    // In place
+    dd::static_transform(span<float, 3>(a), span<float, 3>(a), [](float x) { return -x; });
+    REQUIRE(a[0] == -1.0f);
+}
+
+TEST_CASE("static_reduce folds pairwise after init", "[algorithm][static]") {
+    std::array<int, 16> v{};
+    std::iota(v.begin(), v.end(), 1);
+    REQUIRE(dd::static_reduce(span<const int, 16>(v), 0) == 136);
+    REQUIRE(dd::static_reduce(span<const int, 16>(v), 100L) == 236L);
+    REQUIRE(dd::static_reduce(span<const int, 4>(v.data(), 4), 1, [](int x, int y) { return x * y; }) == 24);
+    REQUIRE(dd::static_reduce(span<const int, 1>(v.data(), 1), 5) == 6);
+    REQUIRE(dd::static_reduce(span<const int, 0>(), 7) == 7);
+
+    // Associative but not commutative: the order of the elements is kept
+    std::array<std::string, 5> words = {{"a", "b", "c", "d", "e"}};
+    REQUIRE(dd::static_reduce(span<const std::string, 5>(words), std::string(">")) == ">abcde");
+}
+
+TEST_CASE("Contract checking: algorithm", "[algorithm][contract]") {
+    std::vector<int> src(10), dst(9);
+    REQUIRE_THROWS_AS(dd::copy(span<const int>(src), span<int>(dst)), contract_violation_error);
+    REQUIRE_THROWS_AS(dd::copy(span<const int>(src), span<int>(dst), copy_hint::streaming), contract_violation_error);
+    REQUIRE_NOTHROW(dd::copy(span<const int>(src).first(9), span<int>(dst)));
+}
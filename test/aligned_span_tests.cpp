@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include <type_traits>
+#include <utility>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/aligned_span.hpp"
+
+using dd::aligned_span;
+using dd::contract_violation_error;
+using dd::dynamic_extent;
+using dd::span;
+
+// Compile-time assertions
+using fixed_span = aligned_span<float, 32, 64>;
+using dynamic_span = aligned_span<float, dynamic_extent, 64>;
+
+static_assert(sizeof(dynamic_span) == sizeof(span<float>), "aligned_span size mismatch");
+static_assert(std::is_trivially_copyable<fixed_span>::value, "aligned_span must be trivially copyable");
+static_assert(std::is_same<decltype(std::declval<fixed_span>().first<8>()), aligned_span<float, 8, 64>>::value,
+              "first<N> keeps alignment");
+static_assert(std::is_same<decltype(std::declval<fixed_span>().subspan<16>()), aligned_span<float, 16, 64>>::value,
+              "subspan<Offset> keeps alignment on full lines");
+static_assert(std::is_same<decltype(std::declval<fixed_span>().subspan<4, 8>()), aligned_span<float, 8, 16>>::value,
+              "subspan<Offset> lowers alignment on partial lines");
+static_assert(std::is_same<decltype(std::declval<fixed_span>().last<16>()), aligned_span<float, 16, 64>>::value,
+              "last<N> keeps alignment on static extents");
+static_assert(std::is_same<decltype(std::declval<dynamic_span>().last<16>()),
+                           aligned_span<float, 16, alignof(float)>>::value,
+              "last<N> drops alignment on dynamic extents");
+
+TEST_CASE("aligned_span construction and access", "[aligned_span][ctor]") {
+    alignas(64) float buf[32] = {};
+    for (int i = 0; i < 32; ++i) buf[i] = static_cast<float>(i);
+    aligned_span<float, dynamic_extent, 64> s(buf, 32);
+    REQUIRE(s.size() == 32);
+    REQUIRE(s.data() == buf);
+    REQUIRE(s[5] == 5.0f);
+    REQUIRE(s.front() == 0.0f);
+    REQUIRE(s.back() == 31.0f);
+    float sum = 0;
+    for (float v : s) sum += v;
+    REQUIRE(sum == 496.0f);
+
+    aligned_span<float, 32, 64> fixed(span<float, 32>{buf});
+    aligned_span<const float, dynamic_extent, 32> weaker = fixed;
+    REQUIRE(weaker.size() == 32);
+}
+
+TEST_CASE("aligned_span subviews", "[aligned_span][subspan]") {
+    alignas(64) int buf[64] = {};
+    aligned_span<int, 64, 64> s(span<int, 64>{buf});
+    auto f = s.first<16>();
+    REQUIRE(f.data() == buf);
+    auto ss = s.subspan<16, 16>();
+    static_assert(decltype(ss)::alignment == 64, "");
+    REQUIRE(ss.data() == buf + 16);
+    auto runtime = s.first(10);
+    static_assert(decltype(runtime)::alignment == 64, "");
+    REQUIRE(runtime.size() == 10);
+    span<int> tail = s.subspan(3);
+    REQUIRE(tail.data() == buf + 3);
+}
+
+TEST_CASE("aligned_span decays to span", "[aligned_span][conversion]") {
+    alignas(64) double buf[8] = {};
+    aligned_span<double, 8, 64> s(span<double, 8>{buf});
+    span<const double> dyn = s;
+    span<double, 8> fixed = s;
+    REQUIRE(dyn.data() == buf);
+    REQUIRE(fixed.size() == 8);
+    auto bytes = dd::as_bytes(s);
+    static_assert(std::is_same<decltype(bytes), aligned_span<const dd::byte, 64, 64>>::value, "");
+    REQUIRE(bytes.size() == sizeof(buf));
+}
+
+TEST_CASE("Contract checking: aligned_span", "[aligned_span][contract]") {
+    alignas(64) float buf[32] = {};
+    REQUIRE_THROWS_AS((aligned_span<float, dynamic_extent, 64>(buf + 1, 4)), contract_violation_error);
+    REQUIRE_THROWS_AS((dd::make_aligned_span<64>(span<float>(buf + 4, 4))), contract_violation_error);
+    REQUIRE_NOTHROW((dd::make_aligned_span<16>(span<float>(buf + 4, 4))));
+    aligned_span<float, dynamic_extent, 64> s(buf, 32);
+    REQUIRE_THROWS_AS(s[32], contract_violation_error);
+    REQUIRE_THROWS_AS(s.first(33), contract_violation_error);
+}
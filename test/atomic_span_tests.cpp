@@ -0,0 +1,214 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/atomic_span.hpp"
+
+using dd::atomic_ref;
+using dd::atomic_span;
+using dd::contract_violation_error;
+using dd::span;
+using dd::thread_pool;
+
+// Compile-time assertions
+static_assert(std::is_trivially_copyable<atomic_span<int>>::value, "atomic spans are cheap views");
+static_assert(std::is_same<atomic_span<double>::reference, atomic_ref<double>>::value, "elements are atomic refs");
+static_assert(!std::is_copy_assignable<atomic_ref<int>>::value, "atomic refs do not rebind");
+
+namespace {
+
+// Runs f(t) on threads threads at once
+template <typename F> void on_threads(std::size_t threads, F f) {
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0; t < threads; ++t) pool.emplace_back(f, t);
+    for (auto &th : pool) th.join();
+}
+
+std::vector<std::uint32_t> pattern_keys(std::size_t n, std::size_t bins) {
+    std::vector<std::uint32_t> keys(n);
+    for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<std::uint32_t>((i * 2654435761u) % bins);
+    return keys;
+}
+
+template <typename Count>
+std::vector<Count> reference_histogram(const std::vector<std::uint32_t> &keys, std::size_t bins) {
+    std::vector<Count> out(bins, Count());
+    for (auto k : keys) out[k] += 1;
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("atomic_ref operations", "[atomic][ref]") {
+    SECTION("integers") {
+        int x = 5;
+        const atomic_ref<int> r(x);
+        REQUIRE(r.load() == 5);
+        REQUIRE(r.fetch_add(3) == 5);
+        REQUIRE(r.fetch_sub(10) == 8);
+        REQUIRE(x == -2);
+        REQUIRE((r += 4) == 2);
+        REQUIRE((r -= 1) == 1);
+        r.store(7, std::memory_order_release);
+        REQUIRE(r.load(std::memory_order_acquire) == 7);
+        REQUIRE(r.exchange(9) == 7);
+        int expected = 1;
+        REQUIRE(!r.compare_exchange_strong(expected, 2));
+        REQUIRE(expected == 9);
+        REQUIRE(r.compare_exchange_strong(expected, 2));
+        REQUIRE(static_cast<int>(r) == 2);
+        REQUIRE(r.address() == &x);
+    }
+    SECTION("subtracting the most negative value wraps instead of overflowing") {
+        std::int64_t x = 0;
+        atomic_ref<std::int64_t>(x).fetch_sub(std::numeric_limits<std::int64_t>::min());
+        REQUIRE(x == std::numeric_limits<std::int64_t>::min());
+    }
+    SECTION("floating point") {
+        double d = 1.5;
+        const atomic_ref<double> r(d);
+        REQUIRE(r.fetch_add(2.0) == 1.5);
+        REQUIRE(r.fetch_sub(0.5) == 3.5);
+        REQUIRE(d == 3.0);
+        float f = 0;
+        const atomic_ref<float> rf(f);
+        rf = 2.5f;
+        REQUIRE(f == 2.5f);
+        float want = 2.5f;
+        while (!rf.compare_exchange_weak(want, 1.0f)) REQUIRE(want == 2.5f);
+        REQUIRE(f == 1.0f);
+    }
+    SECTION("concurrent additions are not lost") {
+        std::uint64_t count = 0;
+        double sum = 0;
+        on_threads(4, [&](std::size_t) {
+            for (int i = 0; i < 20000; ++i) {
+                atomic_ref<std::uint64_t>(count).fetch_add(1, std::memory_order_relaxed);
+                atomic_ref<double>(sum).fetch_add(0.5, std::memory_order_relaxed);
+            }
+        });
+        REQUIRE(count == 80000);
+        REQUIRE(sum == 40000.0);
+    }
+}
+
+TEST_CASE("atomic_span hands out atomic references", "[atomic][span]") {
+    std::vector<int> v(16, 0);
+    const auto a = dd::as_atomic(span<int>(v));
+    REQUIRE(a.size() == 16);
+    REQUIRE(!a.empty());
+    REQUIRE(a.data() == v.data());
+    REQUIRE(a.as_span().data() == v.data());
+    REQUIRE(a[3].address() == v.data() + 3);
+    REQUIRE(a.subspan(4, 2).data() == v.data() + 4);
+    REQUIRE(a.first(3).size() == 3);
+    REQUIRE(a.last(5).data() == v.data() + 11);
+
+    on_threads(4, [&](std::size_t t) {
+        for (int round = 0; round < 5000; ++round) a[(t + static_cast<std::size_t>(round)) % a.size()] += 1;
+    });
+    int total = 0;
+    for (int x : v) total += x;
+    REQUIRE(total == 20000);
+}
+
+TEST_CASE("histogram counts keys", "[atomic][histogram]") {
+    SECTION("serially, adding to existing counts") {
+        const std::vector<std::uint8_t> keys = {0, 3, 3, 1, 3};
+        std::vector<std::uint32_t> bins = {10, 0, 0, 0};
+        thread_pool pool(0);
+        dd::histogram(pool, span<const std::uint8_t>(keys), span<std::uint32_t>(bins));
+        REQUIRE(bins == (std::vector<std::uint32_t>{11, 1, 0, 3}));
+    }
+    SECTION("with private copies per task") {
+        thread_pool pool(3);
+        const auto keys = pattern_keys(200000, 64);
+        std::vector<std::uint64_t> bins(64, 0);
+        dd::histogram(pool, span<const std::uint32_t>(keys), span<std::uint64_t>(bins));
+        REQUIRE(bins == reference_histogram<std::uint64_t>(keys, 64));
+    }
+    SECTION("with atomics when there are more bins than keys per task") {
+        thread_pool pool(3);
+        const auto keys = pattern_keys(100000, 90001);
+        std::vector<std::uint32_t> bins(90001, 0);
+        dd::histogram(pool, span<const std::uint32_t>(keys), span<std::uint32_t>(bins));
+        REQUIRE(bins == reference_histogram<std::uint32_t>(keys, 90001));
+    }
+    SECTION("16-bit counts, which atomic_ref does not support") {
+        thread_pool pool(3);
+        for (std::size_t bins : {std::size_t(16), std::size_t(50000)}) {
+            INFO("bins " << bins);
+            // Private copies for few bins, shards of bins for many
+            const auto keys = pattern_keys(60000, bins);
+            std::vector<std::uint16_t> counts(bins, 0);
+            dd::histogram(pool, span<const std::uint32_t>(keys), span<std::uint16_t>(counts));
+            REQUIRE(counts == reference_histogram<std::uint16_t>(keys, bins));
+        }
+        const std::vector<std::uint8_t> small = {1, 1, 0};
+        std::vector<short> counts(2, 0);
+        dd::histogram(span<const std::uint8_t>(small), span<short>(counts));
+        REQUIRE(counts == (std::vector<short>{1, 2}));
+    }
+    SECTION("default pool") {
+        const auto keys = pattern_keys(50000, 10);
+        std::vector<int> bins(10, 0);
+        dd::histogram(span<const std::uint32_t>(keys), span<int>(bins));
+        REQUIRE(bins == reference_histogram<int>(keys, 10));
+    }
+}
+
+TEST_CASE("scatter_add accumulates values", "[atomic][scatter_add]") {
+    const std::size_t n = 150000;
+    for (std::size_t bins : {std::size_t(7), std::size_t(100000)}) {
+        const auto idx = pattern_keys(n, bins);
+        std::vector<double> values(n);
+        for (std::size_t i = 0; i < n; ++i) values[i] = static_cast<double>(i % 5) * 0.25;
+        std::vector<double> expected(bins, 1.0), out(bins, 1.0);
+        for (std::size_t i = 0; i < n; ++i) expected[idx[i]] += values[i];
+        thread_pool pool(2);
+        dd::scatter_add(pool, span<const std::uint32_t>(idx), span<const double>(values), span<double>(out));
+        // Quarters are exact in double, so the order of additions does not matter
+        REQUIRE(out == expected);
+
+        std::vector<std::int16_t> narrow(bins, 0), narrow_expected(bins, 0);
+        const std::vector<std::int8_t> deltas(n, -1);
+        for (std::size_t i = 0; i < n; ++i) {
+            narrow_expected[idx[i]] = static_cast<std::int16_t>(narrow_expected[idx[i]] - 1);
+        }
+        dd::scatter_add(pool, span<const std::uint32_t>(idx), span<const std::int8_t>(deltas),
+                        span<std::int16_t>(narrow));
+        REQUIRE(narrow == narrow_expected);
+    }
+}
+
+TEST_CASE("Contract checking: atomic_span", "[atomic][contract]") {
+    std::vector<std::int32_t> v(4);
+    const auto a = dd::as_atomic(span<std::int32_t>(v));
+    REQUIRE_THROWS_AS(a[4], contract_violation_error);
+
+    // The misaligned pointer is only checked, never dereferenced
+    alignas(8) unsigned char raw[16] = {};
+    REQUIRE_THROWS_AS(dd::as_atomic(span<std::int32_t>(reinterpret_cast<std::int32_t *>(raw + 1), 1)),
+                      contract_violation_error);
+
+    const std::vector<std::uint32_t> keys = {0, 1, 4};
+    std::vector<std::uint32_t> bins(4);
+    REQUIRE_THROWS_AS(dd::histogram(span<const std::uint32_t>(keys), span<std::uint32_t>(bins)),
+                      contract_violation_error);
+    const std::vector<double> values(2);
+    REQUIRE_THROWS_AS(dd::scatter_add(span<const std::uint32_t>(keys), span<const double>(values),
+                                      span<std::uint32_t>(bins)),
+                      contract_violation_error);
+
+    // Out-of-range keys are caught on the parallel paths as well
+    thread_pool pool(2);
+    std::vector<std::uint32_t> many(100000, 1);
+    many[77777] = 4;
+    REQUIRE_THROWS_AS(dd::histogram(pool, span<const std::uint32_t>(many), span<std::uint32_t>(bins)),
+                      contract_violation_error);
+}
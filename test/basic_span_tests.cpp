@@ -0,0 +1,118 @@
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/basic_span.hpp"
+
+using dd::basic_span;
+using dd::compact_span;
+using dd::contract_violation_error;
+using dd::dynamic_extent;
+using dd::span;
+
+// Compile-time assertions
+static_assert(std::is_same<compact_span<float>::size_type, std::uint32_t>::value, "compact_span uses 32-bit sizes");
+static_assert(std::is_same<compact_span<float>::difference_type, std::int32_t>::value, "signed counterpart");
+static_assert(sizeof(compact_span<float, 8>) == sizeof(float *), "static extent stores only the pointer");
+static_assert(sizeof(compact_span<float>) <= sizeof(span<float>), "never larger than span");
+static_assert(sizeof(basic_span<float, dynamic_extent, std::uint32_t>) == 8 || sizeof(float *) == 8,
+              "pointer and 32-bit size pack into 8 bytes on 32-bit targets");
+static_assert(std::is_trivially_copyable<compact_span<float>>::value, "basic_span must be trivially copyable");
+static_assert(!std::is_convertible<span<float>, compact_span<float>>::value, "narrowing from span is explicit");
+static_assert(std::is_convertible<compact_span<float>, span<const float>>::value, "widening to span is implicit");
+static_assert(std::is_same<decltype(std::declval<compact_span<int, 16>>().subspan<4>()), compact_span<int, 12>>::value,
+              "static subspan keeps the index type");
+static_assert(std::is_same<decltype(std::declval<compact_span<int>>().subspan(1, 2)), compact_span<int>>::value,
+              "runtime subspan keeps the index type");
+
+TEST_CASE("basic_span construction and access", "[basic_span][ctor]") {
+    std::vector<int> v(100);
+    std::iota(v.begin(), v.end(), 0);
+    compact_span<int> s(v);
+    REQUIRE(s.size() == 100u);
+    REQUIRE(s.size_bytes() == 400u);
+    REQUIRE(s.data() == v.data());
+    REQUIRE(s[42] == 42);
+    REQUIRE(s.front() == 0);
+    REQUIRE(s.back() == 99);
+    int sum = 0;
+    for (int x : s) sum += x;
+    REQUIRE(sum == 4950);
+
+    compact_span<const int> c = s;
+    REQUIRE(c.size() == 100u);
+    span<const int> wide = s;
+    REQUIRE(wide.size() == 100u);
+    REQUIRE(s.as_span().data() == v.data());
+
+    compact_span<int> from_span(span<int>(v).first(10));
+    REQUIRE(from_span.size() == 10u);
+    REQUIRE(dd::make_compact_span(span<int>(v)).size() == 100u);
+
+    int arr[4] = {1, 2, 3, 4};
+    compact_span<int, 4> fixed = arr;
+    REQUIRE(fixed.size() == 4u);
+    std::array<int, 3> a = {{5, 6, 7}};
+    compact_span<const int> from_array = a;
+    REQUIRE(from_array[2] == 7);
+
+    compact_span<int> empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.data() == nullptr);
+}
+
+TEST_CASE("basic_span subviews", "[basic_span][subspan]") {
+    int buf[16];
+    std::iota(buf, buf + 16, 0);
+    compact_span<int, 16> s = buf;
+    auto f = s.first<4>();
+    static_assert(decltype(f)::extent == 4, "");
+    REQUIRE(f[3] == 3);
+    auto l = s.last<4>();
+    REQUIRE(l.front() == 12);
+    auto sub = s.subspan<2, 3>();
+    REQUIRE(sub.size() == 3u);
+    REQUIRE(sub[0] == 2);
+
+    compact_span<int> d(s);
+    REQUIRE(d.first(5).back() == 4);
+    REQUIRE(d.last(5).front() == 11);
+    REQUIRE(d.subspan(10).size() == 6u);
+    REQUIRE(d.subspan(10, 2)[1] == 11);
+    REQUIRE(std::vector<int>(d.rbegin(), d.rbegin() + 2) == std::vector<int>{15, 14});
+}
+
+TEST_CASE("basic_span with signed and narrow index types", "[basic_span][index]") {
+    std::vector<float> v(300, 1.0f);
+    basic_span<float, dynamic_extent, std::int32_t> s(v);
+    REQUIRE(s.size() == 300);
+    float sum = 0;
+    for (std::int32_t i = 0; i < s.size(); ++i) sum += s[i];
+    REQUIRE(sum == 300.0f);
+
+    basic_span<float, dynamic_extent, std::uint16_t> narrow(v);
+    REQUIRE(narrow.subspan(100).size() == 200u);
+}
+
+TEST_CASE("Contract checking: basic_span", "[basic_span][contract]") {
+    std::vector<char> big(300);
+    REQUIRE_THROWS_AS((basic_span<char, dynamic_extent, std::uint8_t>(span<char>(big))), contract_violation_error);
+    REQUIRE_THROWS_AS((basic_span<char, dynamic_extent, std::int8_t>(big.data(), 128)), contract_violation_error);
+    REQUIRE_NOTHROW((basic_span<char, dynamic_extent, std::uint8_t>(big.data(), 255)));
+
+    compact_span<char> s(big);
+    REQUIRE_THROWS_AS(s[300], contract_violation_error);
+    REQUIRE_THROWS_AS(s.first(301), contract_violation_error);
+    REQUIRE_THROWS_AS(s.subspan(200, 101), contract_violation_error);
+    REQUIRE_THROWS_AS(s.subspan<301>(), contract_violation_error);
+
+    basic_span<char, dynamic_extent, std::int32_t> signed_span(big);
+    REQUIRE_THROWS_AS(signed_span[-1], contract_violation_error);
+    REQUIRE_THROWS_AS(signed_span.first(-1), contract_violation_error);
+    REQUIRE_THROWS_AS((compact_span<char, 4>(big.data(), 3)), contract_violation_error);
+}
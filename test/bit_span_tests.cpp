@@ -0,0 +1,262 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/bit_span.hpp"
+#include "simd_test_helpers.hpp"
+
+using dd::bit_span;
+using dd::contract_violation_error;
+using dd::simd_isa;
+using dd::span;
+
+// Compile-time assertions
+static_assert(std::is_same<bit_span<>::word_type, std::uint64_t>::value, "default words are 64-bit");
+static_assert(std::is_convertible<bit_span<std::uint32_t>, bit_span<const std::uint32_t>>::value,
+              "mutable bits convert to const bits");
+static_assert(!std::is_convertible<bit_span<const std::uint32_t>, bit_span<std::uint32_t>>::value,
+              "const bits do not convert to mutable bits");
+static_assert(std::is_same<bit_span<const std::uint64_t>::reference, bool>::value, "const bits read as bool");
+static_assert(std::is_same<std::iterator_traits<bit_span<>::iterator>::iterator_category,
+                           std::random_access_iterator_tag>::value,
+              "bit iterators are random access");
+static_assert(bit_span<std::uint8_t>::word_bits == 8, "word_bits follows the word type");
+
+namespace {
+
+// Reference model: one bool per bit
+template <typename Word> std::vector<bool> unpack(bit_span<const Word> s) {
+    std::vector<bool> out;
+    for (std::size_t i = 0; i < s.size(); ++i) out.push_back(s.test(i));
+    return out;
+}
+
+std::vector<std::uint64_t> random_words(std::size_t n, std::uint32_t seed, int density) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::uint64_t> w(n);
+    for (auto &x : w) {
+        x = rng();
+        for (int k = 1; k < density; ++k) x &= rng();
+    }
+    return w;
+}
+
+} // namespace
+
+TEST_CASE("bit_span reads and writes single bits", "[bit_span][access]") {
+    std::vector<std::uint8_t> words(4, 0);
+    bit_span<std::uint8_t> bits(words.data(), 20, 3);
+    REQUIRE(bits.size() == 20u);
+    REQUIRE(bits.offset() == 3u);
+    REQUIRE(bits.words().size() == 3u);
+
+    bits.set(0);
+    bits[6] = true;
+    bits.set(19, true);
+    REQUIRE(words[0] == 0x08);
+    REQUIRE(words[1] == 0x02);
+    REQUIRE(words[2] == 0x40);
+    REQUIRE(bits.test(6));
+    REQUIRE(bits[6]);
+    REQUIRE(!bits[7]);
+
+    bits.flip(6);
+    bits[1] = bits[0];
+    bits.reset(0);
+    REQUIRE(words[0] == 0x10);
+    REQUIRE(words[1] == 0x00);
+
+    bit_span<const std::uint8_t> view = bits;
+    REQUIRE(view[1]);
+    REQUIRE(view.data() == words.data());
+}
+
+TEST_CASE("bit_span normalizes large offsets and builds from word spans", "[bit_span][construct]") {
+    std::vector<std::uint32_t> words(3, 0);
+    bit_span<std::uint32_t> bits(words.data(), 10, 70);
+    REQUIRE(bits.data() == words.data() + 2);
+    REQUIRE(bits.offset() == 6u);
+
+    bit_span<std::uint32_t> all{span<std::uint32_t>(words)};
+    REQUIRE(all.size() == 96u);
+    REQUIRE(all.offset() == 0u);
+    all.set(95);
+    REQUIRE(words[2] == 0x80000000u);
+
+    bit_span<> empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.begin() == empty.end());
+    REQUIRE(empty.count() == 0u);
+    REQUIRE(empty.find_first_set() == 0u);
+    REQUIRE(empty.all());
+    REQUIRE(empty.none());
+}
+
+TEST_CASE("bit_span subviews start at bit offsets", "[bit_span][subview]") {
+    std::vector<std::uint64_t> words = {0xf0f0f0f0f0f0f0f0ull, 0x0123456789abcdefull};
+    bit_span<const std::uint64_t> bits{span<const std::uint64_t>(words)};
+    const auto model = unpack(bits);
+    for (std::size_t off : {0u, 1u, 4u, 63u, 64u, 65u, 100u}) {
+        const auto sub = bits.subspan(off);
+        REQUIRE(sub.size() == 128u - off);
+        REQUIRE(unpack(sub) == std::vector<bool>(model.begin() + off, model.end()));
+    }
+    const auto mid = bits.subspan(60, 10);
+    REQUIRE(mid.offset() == 60u);
+    REQUIRE(unpack(mid) == std::vector<bool>(model.begin() + 60, model.begin() + 70));
+    REQUIRE(unpack(bits.first(5)) == std::vector<bool>(model.begin(), model.begin() + 5));
+    REQUIRE(unpack(bits.last(5)) == std::vector<bool>(model.end() - 5, model.end()));
+    REQUIRE(unpack(bits.subspan(3).subspan(70)) == std::vector<bool>(model.begin() + 73, model.end()));
+}
+
+TEST_CASE("bit_span iterators walk the bits", "[bit_span][iterator]") {
+    std::vector<std::uint16_t> words(2, 0);
+    bit_span<std::uint16_t> bits(words.data(), 24, 5);
+    std::fill(bits.begin() + 2, bits.begin() + 7, true);
+    REQUIRE(std::count(bits.begin(), bits.end(), true) == 5);
+    REQUIRE(std::find(bits.begin(), bits.end(), true) - bits.begin() == 2);
+    REQUIRE(*std::prev(bits.rend()) == false);
+
+    auto it = bits.begin();
+    it += 6;
+    REQUIRE(*it);
+    REQUIRE(it[1] == false);
+    *it = false;
+    REQUIRE(!bits[6]);
+    REQUIRE(it - bits.begin() == 6);
+    REQUIRE(bits.begin() < it);
+
+    std::size_t seen = 0;
+    for (bool b : bit_span<const std::uint16_t>(bits)) seen += b ? 1 : 0;
+    REQUIRE(seen == 4u);
+}
+
+TEST_CASE("bit_span fill keeps neighbouring bits", "[bit_span][fill]") {
+    std::vector<std::uint64_t> words(4, 0);
+    bit_span<> bits(words.data(), 150, 30);
+    bits.fill(true);
+    REQUIRE(words[0] == ~((std::uint64_t(1) << 30) - 1));
+    REQUIRE(words[1] == ~std::uint64_t(0));
+    REQUIRE(words[2] == (std::uint64_t(1) << 52) - 1);
+    REQUIRE(words[3] == 0u);
+    bits.subspan(1, 148).fill(false);
+    REQUIRE(bit_span<>(words.data(), 256).count() == 2u);
+    REQUIRE(bits.test(0));
+    REQUIRE(bits.test(149));
+}
+
+TEST_CASE("bit_span count, find and any/all match a bool model", "[bit_span][query][simd]") {
+    for (int density : {1, 4, 12}) {
+        const auto words = random_words(67, 7u + density, density);
+        bit_span<const std::uint64_t> all{span<const std::uint64_t>(words)};
+        const auto model = unpack(all);
+        for (std::size_t off : {0u, 1u, 37u, 64u, 200u}) {
+            for (std::size_t len : {0u, 1u, 63u, 64u, 130u, 1000u, 4000u}) {
+                if (off + len > all.size()) continue;
+                const auto sub = all.subspan(off, len);
+                const auto first = model.begin() + off;
+                const auto count = static_cast<std::size_t>(std::count(first, first + len, true));
+                const auto set = static_cast<std::size_t>(std::find(first, first + len, true) - first);
+                const auto unset = static_cast<std::size_t>(std::find(first, first + len, false) - first);
+                for (simd_isa isa : supported_isas()) {
+                    INFO(dd::simd_isa_name(isa) << " density=" << density << " off=" << off << " len=" << len);
+                    REQUIRE(sub.count(isa) == count);
+                    REQUIRE(sub.find_first_set(isa) == set);
+                    REQUIRE(sub.find_first_unset(isa) == unset);
+                    REQUIRE(sub.any(isa) == (count != 0));
+                    REQUIRE(sub.none(isa) == (count == 0));
+                    REQUIRE(sub.all(isa) == (count == len));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("bit_span finds bits past long empty or full runs", "[bit_span][query][simd]") {
+    std::vector<std::uint32_t> words(300, 0);
+    bit_span<std::uint32_t> bits(words.data(), 9000, 7);
+    for (simd_isa isa : supported_isas()) {
+        INFO(dd::simd_isa_name(isa));
+        REQUIRE(bits.find_first_set(isa) == 9000u);
+        bits.set(8123);
+        REQUIRE(bits.find_first_set(isa) == 8123u);
+        REQUIRE(bits.count(isa) == 1u);
+        bits.fill(true);
+        REQUIRE(bits.all(isa));
+        bits.reset(5000);
+        REQUIRE(bits.find_first_unset(isa) == 5000u);
+        REQUIRE(bits.count(isa) == 8999u);
+        bits.fill(false);
+    }
+}
+
+TEST_CASE("Bitwise operations combine views at any offsets", "[bit_span][bitwise][simd]") {
+    const auto wa = random_words(40, 1, 1);
+    const auto wb = random_words(40, 2, 1);
+    bit_span<const std::uint64_t> a{span<const std::uint64_t>(wa)};
+    bit_span<const std::uint64_t> b{span<const std::uint64_t>(wb)};
+    const auto ma = unpack(a);
+    const auto mb = unpack(b);
+
+    struct offsets {
+        std::size_t dst, a, b;
+    };
+    for (offsets o : {offsets{0, 0, 0}, offsets{5, 5, 5}, offsets{3, 0, 9}, offsets{64, 1, 127}}) {
+        for (std::size_t len : {0u, 1u, 60u, 64u, 1000u, 2300u}) {
+            for (simd_isa isa : supported_isas()) {
+                INFO(dd::simd_isa_name(isa) << " dst=" << o.dst << " a=" << o.a << " b=" << o.b << " len=" << len);
+                std::vector<std::uint64_t> wd(40, 0x5555555555555555ull);
+                const std::vector<std::uint64_t> before = wd;
+                bit_span<> dst(wd.data(), len, o.dst);
+                const auto sa = a.subspan(o.a, len);
+                const auto sb = b.subspan(o.b, len);
+
+                dd::bit_and(dst, sa, sb, isa);
+                for (std::size_t i = 0; i < len; ++i) REQUIRE(dst[i] == (ma[o.a + i] && mb[o.b + i]));
+                dd::bit_or(dst, sa, sb, isa);
+                for (std::size_t i = 0; i < len; ++i) REQUIRE(dst[i] == (ma[o.a + i] || mb[o.b + i]));
+                dd::bit_andnot(dst, sa, sb, isa);
+                for (std::size_t i = 0; i < len; ++i) REQUIRE(dst[i] == (ma[o.a + i] && !mb[o.b + i]));
+                dd::bit_xor(dst, sa, sb, isa);
+                for (std::size_t i = 0; i < len; ++i) REQUIRE(dst[i] == (ma[o.a + i] != mb[o.b + i]));
+
+                // Bits around the destination are untouched
+                bit_span<> whole{span<std::uint64_t>(wd)};
+                bit_span<const std::uint64_t> old{span<const std::uint64_t>(before)};
+                for (std::size_t i = 0; i < o.dst; ++i) REQUIRE(whole[i] == old[i]);
+                for (std::size_t i = o.dst + len; i < whole.size(); ++i) REQUIRE(whole[i] == old[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Bitwise operations work in place", "[bit_span][bitwise]") {
+    std::vector<std::uint8_t> x = {0xff, 0x0f, 0xf0};
+    const std::vector<std::uint8_t> y = {0x0f, 0xff, 0x00};
+    bit_span<std::uint8_t> bx{span<std::uint8_t>(x)};
+    dd::bit_and(bx, bx, bit_span<const std::uint8_t>{span<const std::uint8_t>(y)});
+    REQUIRE(x == std::vector<std::uint8_t>{0x0f, 0x0f, 0x00});
+}
+
+TEST_CASE("Contract checking: bit_span", "[bit_span][contract]") {
+    std::vector<std::uint64_t> words(2, 0);
+    bit_span<> bits(words.data(), 100);
+    REQUIRE_THROWS_AS(bits[100], contract_violation_error);
+    REQUIRE_THROWS_AS(bits.test(100), contract_violation_error);
+    REQUIRE_THROWS_AS(bits.set(100), contract_violation_error);
+    REQUIRE_THROWS_AS(bits.flip(100), contract_violation_error);
+    REQUIRE_THROWS_AS(bits.first(101), contract_violation_error);
+    REQUIRE_THROWS_AS(bits.last(101), contract_violation_error);
+    REQUIRE_THROWS_AS(bits.subspan(101), contract_violation_error);
+    REQUIRE_THROWS_AS(bits.subspan(50, 51), contract_violation_error);
+    REQUIRE_NOTHROW(bits.subspan(100));
+
+    std::vector<std::uint64_t> other(2, 0);
+    bit_span<const std::uint64_t> small(other.data(), 99);
+    REQUIRE_THROWS_AS(dd::bit_or(bits, small, bits), contract_violation_error);
+}
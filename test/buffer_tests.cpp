@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/buffer.hpp"
+
+using dd::aligned_span;
+using dd::buffer;
+using dd::buffer_hint;
+using dd::contract_violation_error;
+using dd::dynamic_extent;
+using dd::span;
+
+// Compile-time assertions
+static_assert(buffer<float>::alignment == 64, "buffers are cache-line aligned by default");
+static_assert(buffer<double, 4096>::alignment == 4096, "alignment is configurable");
+static_assert(!std::is_copy_constructible<buffer<float>>::value, "buffer is move-only");
+static_assert(std::is_nothrow_move_constructible<buffer<float>>::value, "buffer is nothrow movable");
+static_assert(std::is_convertible<buffer<float> &, span<float>>::value, "buffer converts to span");
+static_assert(std::is_convertible<const buffer<float> &, span<const float>>::value, "const buffer gives const spans");
+static_assert(!std::is_convertible<const buffer<float> &, span<float>>::value, "const buffer is not writable");
+static_assert(std::is_convertible<buffer<float> &, aligned_span<float, dynamic_extent, 64>>::value,
+              "buffer converts to aligned_span");
+static_assert(std::is_convertible<buffer<float> &, aligned_span<const float, dynamic_extent, 16>>::value,
+              "weaker alignments are fine");
+static_assert(!std::is_convertible<buffer<float> &, aligned_span<float, dynamic_extent, 128>>::value,
+              "stronger alignments are not");
+
+namespace {
+
+// Counts live instances to check construction and destruction
+struct tracked {
+    static int live;
+    int value = 7;
+    tracked() { ++live; }
+    tracked(const tracked &other) : value(other.value) { ++live; }
+    ~tracked() { --live; }
+};
+int tracked::live = 0;
+
+void scale(span<float> s, float k) {
+    for (float &x : s) x *= k;
+}
+
+} // namespace
+
+TEST_CASE("buffer construction and access", "[buffer][ctor]") {
+    buffer<float> b(1000);
+    REQUIRE(b.size() == 1000u);
+    REQUIRE(b.size_bytes() == 4000u);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b.data()) % 64 == 0);
+    std::iota(b.begin(), b.end(), 0.0f);
+    REQUIRE(b[10] == 10.0f);
+    REQUIRE(b.front() == 0.0f);
+    REQUIRE(b.back() == 999.0f);
+
+    buffer<int> filled(5, 3);
+    REQUIRE(std::accumulate(filled.begin(), filled.end(), 0) == 15);
+
+    buffer<double, 4096> page(3);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(page.data()) % 4096 == 0);
+
+    buffer<float> empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.data() == nullptr);
+    buffer<float> zero(0);
+    REQUIRE(zero.empty());
+}
+
+TEST_CASE("buffer huge-page hint", "[buffer][hint]") {
+    buffer<float> b(1000, buffer_hint::huge_pages);
+    REQUIRE(b.hint() == buffer_hint::huge_pages);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b.data()) % (std::size_t(2) << 20) == 0);
+    b[999] = 1.0f;
+    b.resize(2000);
+    REQUIRE(b.hint() == buffer_hint::huge_pages);
+    REQUIRE(b[999] == 1.0f);
+}
+
+TEST_CASE("buffer converts to spans", "[buffer][span]") {
+    buffer<float> b(8, 1.0f);
+    scale(b, 2.0f);
+    REQUIRE(b[7] == 2.0f);
+
+    span<float> s = b;
+    REQUIRE(s.data() == b.data());
+    auto made = dd::make_span(b);
+    static_assert(std::is_same<decltype(made), span<float>>::value, "make_span treats buffer as a container");
+    const buffer<float> &cb = b;
+    auto cmade = dd::make_span(cb);
+    static_assert(std::is_same<decltype(cmade), span<const float>>::value, "");
+    REQUIRE(cmade.size() == 8u);
+
+    aligned_span<float, dynamic_extent, 64> a = b;
+    REQUIRE(a.data() == b.data());
+    aligned_span<const float, dynamic_extent, 32> ca = cb;
+    REQUIRE(ca.size() == 8u);
+
+    span<float, 8> fixed = b.as_span<8>();
+    REQUIRE(fixed[0] == 2.0f);
+    REQUIRE(cb.as_span().size() == 8u);
+}
+
+TEST_CASE("buffer resize and move", "[buffer][resize]") {
+    buffer<int> b(4);
+    std::iota(b.begin(), b.end(), 1);
+    b.resize(10);
+    REQUIRE(b.size() == 10u);
+    REQUIRE(b[3] == 4);
+    b.resize(2);
+    REQUIRE(b.size() == 2u);
+    REQUIRE(b[1] == 2);
+
+    buffer<int> moved(std::move(b));
+    REQUIRE(moved.size() == 2u);
+    REQUIRE(b.empty());
+    b = std::move(moved);
+    REQUIRE(b[0] == 1);
+}
+
+TEST_CASE("buffer constructs and destroys non-trivial elements", "[buffer][lifetime]") {
+    {
+        buffer<tracked> b(3);
+        REQUIRE(tracked::live == 3);
+        REQUIRE(b[2].value == 7);
+        b.resize(5);
+        REQUIRE(tracked::live == 5);
+        b.resize(1);
+        REQUIRE(tracked::live == 1);
+    }
+    REQUIRE(tracked::live == 0);
+
+    buffer<std::string> strings(2, std::string("span"));
+    REQUIRE(strings[1] == "span");
+}
+
+TEST_CASE("Contract checking: buffer", "[buffer][contract]") {
+    buffer<float> b(4);
+    const buffer<float> &cb = b;
+    REQUIRE_THROWS_AS(b[4], contract_violation_error);
+    REQUIRE_THROWS_AS(cb[4], contract_violation_error);
+    REQUIRE_THROWS_AS(b.as_span<3>(), contract_violation_error);
+    buffer<float> empty;
+    REQUIRE_THROWS_AS(empty.front(), contract_violation_error);
+    REQUIRE_THROWS_AS(empty.back(), contract_violation_error);
+}
@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/byte_io.hpp"
+#include "simd_test_helpers.hpp"
+
+using dd::byte;
+using dd::byte_reader;
+using dd::byte_writer;
+using dd::contract_violation_error;
+using dd::endian;
+using dd::simd_isa;
+using dd::span;
+
+namespace {
+
+std::vector<byte> bytes_of(std::initializer_list<unsigned char> values) {
+    std::vector<byte> v(values.size());
+    std::memcpy(v.data(), values.begin(), values.size());
+    return v;
+}
+
+} // namespace
+
+TEST_CASE("byte_reader loads fields in both byte orders", "[byte_io][reader]") {
+    const auto buf = bytes_of({0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09});
+    byte_reader r{span<const byte>(buf)};
+    REQUIRE(r.size() == 9u);
+    REQUIRE(r.read<std::uint8_t>() == 0x01);
+    REQUIRE(r.peek<std::uint32_t>() == 0x05040302u);
+    REQUIRE(r.read<std::uint32_t, endian::big>() == 0x02030405u);
+    REQUIRE(r.read<std::uint16_t>() == 0x0706);
+    REQUIRE(r.position() == 7u);
+    REQUIRE(r.remaining() == 2u);
+    std::uint32_t too_big = 0;
+    REQUIRE(!r.try_read(too_big));
+    REQUIRE(r.position() == 7u);
+    std::uint16_t last = 0;
+    REQUIRE(r.try_read<std::uint16_t, endian::big>(last));
+    REQUIRE(last == 0x0809);
+    REQUIRE(r.empty());
+
+    r.seek(1);
+    REQUIRE(r.read_bytes(2).size() == 2u);
+    r.skip(1);
+    REQUIRE(r.rest().size() == 5u);
+}
+
+TEST_CASE("byte_writer round-trips through byte_reader", "[byte_io][writer]") {
+    std::vector<byte> buf(64);
+    byte_writer w{span<byte>(buf)};
+    w.write(std::uint8_t(7));
+    w.write<endian::big>(std::int32_t(-5));
+    w.write(3.5);
+    w.write<endian::big>(1.25f);
+    const std::uint16_t arr[3] = {1, 2, 0xabcd};
+    w.write_n<endian::big>(span<const std::uint16_t>(arr));
+    w.write_bytes(dd::as_bytes(span<const std::uint16_t>(arr)));
+    REQUIRE(w.position() == 1u + 4u + 8u + 4u + 6u + 6u);
+    REQUIRE(w.written().size() == w.position());
+    REQUIRE(!w.try_write(std::uint64_t(0)) == (w.remaining() < 8));
+
+    byte_reader r{span<const byte>(w.written())};
+    REQUIRE(r.read<std::uint8_t>() == 7);
+    REQUIRE(r.read<std::int32_t, endian::big>() == -5);
+    REQUIRE(r.read<double>() == 3.5);
+    REQUIRE(r.read<float, endian::big>() == 1.25f);
+    std::uint16_t back[3];
+    r.read_n_into<std::uint16_t, endian::big>(span<std::uint16_t>(back));
+    REQUIRE(std::equal(back, back + 3, arr));
+    std::uint16_t native[3];
+    r.read_n_into(span<std::uint16_t>(native));
+    REQUIRE(native[2] == 0xabcd);
+}
+
+TEST_CASE("byte_reader views aligned arrays in place", "[byte_io][read_n]") {
+    alignas(8) std::uint32_t values[4] = {10, 20, 30, 40};
+    byte_reader r(dd::as_bytes(span<const std::uint32_t>(values)));
+    REQUIRE(r.aligned_for<std::uint32_t>());
+    span<const std::uint32_t> s = r.read_n<std::uint32_t>(3);
+    REQUIRE(s.data() == values);
+    REQUIRE(s[2] == 30u);
+    r.seek(1);
+    REQUIRE(!r.aligned_for<std::uint32_t>());
+}
+
+TEST_CASE("LEB128 varints", "[byte_io][varint]") {
+    REQUIRE(dd::varint_size(0) == 1u);
+    REQUIRE(dd::varint_size(127) == 1u);
+    REQUIRE(dd::varint_size(128) == 2u);
+    REQUIRE(dd::varint_size(~std::uint64_t(0)) == 10u);
+
+    const auto buf = bytes_of({0xe5, 0x8e, 0x26, 0x00, 0x7f, 0x80, 0x01});
+    byte_reader r{span<const byte>(buf)};
+    REQUIRE(r.read_varint() == 624485u);
+    REQUIRE(r.read_varint() == 0u);
+    REQUIRE(r.read_varint() == 127u);
+    REQUIRE(r.read_varint() == 128u);
+    std::uint64_t v = 0;
+    REQUIRE(!r.try_read_varint(v));
+
+    const auto truncated = bytes_of({0x80, 0x80});
+    byte_reader t{span<const byte>(truncated)};
+    REQUIRE(!t.try_read_varint(v));
+    REQUIRE(t.position() == 0u);
+}
+
+TEST_CASE("Batched varint decode matches the encoder", "[byte_io][varint][simd]") {
+    std::mt19937_64 rng(42);
+    for (int shape = 0; shape < 4; ++shape) {
+        std::vector<std::uint64_t> values(3000);
+        for (auto &x : values) {
+            const std::uint64_t bits = rng();
+            x = shape == 0 ? bits % 128 : shape == 1 ? bits % 300 : shape == 2 ? bits >> (bits % 64) : bits;
+        }
+        std::vector<byte> buf(values.size() * 10);
+        byte_writer w{span<byte>(buf)};
+        for (std::uint64_t x : values) w.write_varint(x);
+        const span<const byte> encoded = w.written();
+
+        for (simd_isa isa : supported_isas()) {
+            INFO(dd::simd_isa_name(isa) << " shape=" << shape);
+            std::vector<std::uint64_t> out(values.size() + 3);
+            const auto all = dd::decode_varints(encoded, span<std::uint64_t>(out), isa);
+            REQUIRE(all.count == values.size());
+            REQUIRE(all.bytes == encoded.size());
+            REQUIRE(std::equal(values.begin(), values.end(), out.begin()));
+
+            // A short output stops the decoder after exactly that many values
+            byte_reader r(encoded);
+            REQUIRE(r.read_varints(span<std::uint64_t>(out.data(), 1001), isa) == 1001u);
+            REQUIRE(r.read_varint() == values[1001]);
+
+            // A truncated tail is left unread
+            const auto partial = dd::decode_varints(encoded.first(encoded.size() - 1), span<std::uint64_t>(out), isa);
+            REQUIRE(partial.count == values.size() - 1);
+            REQUIRE(partial.bytes == encoded.size() - dd::varint_size(values.back()));
+        }
+    }
+}
+
+TEST_CASE("Batched varint decode stops at overlong varints", "[byte_io][varint][simd]") {
+    std::vector<byte> buf(200, byte(0x01));
+    std::fill(buf.begin() + 100, buf.begin() + 111, byte(0x80));
+    for (simd_isa isa : supported_isas()) {
+        INFO(dd::simd_isa_name(isa));
+        std::vector<std::uint64_t> out(200);
+        const auto r = dd::decode_varints(span<const byte>(buf), span<std::uint64_t>(out), isa);
+        REQUIRE(r.count == 100u);
+        REQUIRE(r.bytes == 100u);
+    }
+}
+
+TEST_CASE("Contract checking: byte_io", "[byte_io][contract]") {
+    const auto buf = bytes_of({0x01, 0x02, 0x03, 0x80});
+    byte_reader r{span<const byte>(buf)};
+    REQUIRE_THROWS_AS(r.read<std::uint64_t>(), contract_violation_error);
+    REQUIRE_THROWS_AS(r.peek<std::uint64_t>(), contract_violation_error);
+    REQUIRE_THROWS_AS(r.read_bytes(5), contract_violation_error);
+    REQUIRE_THROWS_AS(r.seek(5), contract_violation_error);
+    REQUIRE_THROWS_AS(r.skip(5), contract_violation_error);
+    REQUIRE_THROWS_AS(r.read_n<std::uint8_t>(5), contract_violation_error);
+    r.seek(3);
+    REQUIRE_THROWS_AS(r.read_varint(), contract_violation_error);
+
+    std::vector<byte> out(2);
+    byte_writer w{span<byte>(out)};
+    REQUIRE_THROWS_AS(w.write(std::uint32_t(1)), contract_violation_error);
+    REQUIRE_THROWS_AS(w.write_varint(1u << 14), contract_violation_error);
+    REQUIRE_NOTHROW(w.write_varint(1u << 13));
+}
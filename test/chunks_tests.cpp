@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/chunks.hpp"
+
+using dd::contract_violation_error;
+using dd::dynamic_extent;
+using dd::span;
+
+// Compile-time assertions
+static_assert(std::is_same<decltype(dd::chunks<4>(span<int>()))::value_type, span<int, 4>>::value,
+              "full chunks must have a static extent");
+static_assert(std::is_same<decltype(dd::chunks<4>(span<int, 10>(nullptr, 10)).tail()), span<int, 2>>::value,
+              "tail of a static span must have a static extent");
+static_assert(std::is_same<decltype(dd::chunks<4>(span<int>()).tail()), span<int>>::value,
+              "tail of a dynamic span must be dynamic");
+
+TEST_CASE("Static chunks", "[chunks][static]") {
+    std::vector<int> v(10);
+    std::iota(v.begin(), v.end(), 0);
+    auto c = dd::chunks<4>(span<int>(v));
+    REQUIRE(c.size() == 2);
+    REQUIRE(c[0].data() == v.data());
+    REQUIRE(c[1][0] == 4);
+    REQUIRE(c.tail().size() == 2);
+    REQUIRE(c.tail()[1] == 9);
+
+    int sum = 0;
+    for (span<int, 4> block : c)
+        for (int x : block) sum += x;
+    for (int x : c.tail()) sum += x;
+    REQUIRE(sum == 45);
+
+    std::array<int, 8> a{};
+    auto exact = dd::chunks<4>(span<int, 8>(a));
+    REQUIRE(exact.size() == 2);
+    REQUIRE(exact.tail().empty());
+    REQUIRE(dd::chunks<4>(span<int>(v).first(3)).empty());
+}
+
+TEST_CASE("Dynamic chunks", "[chunks][dynamic]") {
+    std::vector<int> v(10);
+    std::iota(v.begin(), v.end(), 0);
+    auto c = dd::chunks(span<int>(v), 3);
+    REQUIRE(c.size() == 4);
+    REQUIRE(c.chunk_size() == 3);
+    REQUIRE(c[0].size() == 3);
+    REQUIRE(c[3].size() == 1);
+    REQUIRE(c[3][0] == 9);
+    std::size_t total = 0;
+    for (auto chunk : c) total += chunk.size();
+    REQUIRE(total == v.size());
+    REQUIRE(c.end() - c.begin() == 4);
+    REQUIRE(dd::chunks(span<int>(), 3).empty());
+}
+
+TEST_CASE("Balanced tiles", "[chunks][tiles]") {
+    std::vector<int> v(10);
+    std::iota(v.begin(), v.end(), 0);
+    auto t = dd::tiles(span<int>(v), 4);
+    REQUIRE(t.size() == 4);
+    REQUIRE(t[0].size() == 3);
+    REQUIRE(t[1].size() == 3);
+    REQUIRE(t[2].size() == 2);
+    REQUIRE(t[3].size() == 2);
+    REQUIRE(t[2][0] == 6);
+    REQUIRE(t[3].data() + t[3].size() == v.data() + v.size());
+
+    auto more_tiles_than_elements = dd::tiles(span<int>(v).first(2), 3);
+    REQUIRE(more_tiles_than_elements[0].size() == 1);
+    REQUIRE(more_tiles_than_elements[2].empty());
+}
+
+TEST_CASE("Contract checking: chunks", "[chunks][contract]") {
+    std::vector<int> v(10);
+    REQUIRE_THROWS_AS(dd::chunks(span<int>(v), 0), contract_violation_error);
+    REQUIRE_THROWS_AS(dd::tiles(span<int>(v), 0), contract_violation_error);
+    REQUIRE_THROWS_AS(dd::chunks<4>(span<int>(v))[2], contract_violation_error);
+    REQUIRE_THROWS_AS(dd::chunks(span<int>(v), 4)[3], contract_violation_error);
+    REQUIRE_THROWS_AS(dd::tiles(span<int>(v), 2)[2], contract_violation_error);
+}
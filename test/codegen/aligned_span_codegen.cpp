@@ -0,0 +1,14 @@
+// Compiled to assembly by the AlignedSpanCodegen test: the aligned loop must use aligned vector moves only.
+#include "dd/aligned_span.hpp"
+
+extern "C" void dd_codegen_scale_span(dd::span<float> s, float a) {
+  for (float &v : s) {
+    v *= a;
+  }
+}
+
+extern "C" void dd_codegen_scale_aligned_span(dd::aligned_span<float, dd::dynamic_extent, 64> s, float a) {
+  for (float &v : s) {
+    v *= a;
+  }
+}
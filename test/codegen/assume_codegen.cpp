@@ -0,0 +1,8 @@
+// Compiled to assembly by the AssumeContractCodegen test, once with DD_SPAN_NO_CONTRACT_CHECKING and once with
+// DD_SPAN_ASSUME_ON_CONTRACT_VIOLATION: only the latter lets the optimizer drop the redundant bounds check.
+#include "dd/span.hpp"
+
+extern "C" float dd_codegen_redundant_check(dd::span<const float> s, std::size_t i) {
+  const float v = s[i];
+  return i < s.size() ? v : 0.0f;
+}
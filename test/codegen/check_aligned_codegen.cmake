@@ -0,0 +1,20 @@
+# Usage: cmake -DCXX=<compiler> -DSOURCE=<file> -DINCLUDE_DIR=<dir> -DOUTPUT=<file.s> -P check_aligned_codegen.cmake
+execute_process(
+        COMMAND ${CXX} -std=c++17 -O3 -DNDEBUG -I${INCLUDE_DIR} -S ${SOURCE} -o ${OUTPUT}
+        RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to compile ${SOURCE}")
+endif()
+
+file(READ ${OUTPUT} asm)
+string(REGEX MATCH "dd_codegen_scale_aligned_span:.*" aligned_body "${asm}")
+string(FIND "${aligned_body}" ".cfi_endproc" end)
+string(SUBSTRING "${aligned_body}" 0 ${end} aligned_body)
+
+if(NOT aligned_body MATCHES "movaps[^\n]*\\(")
+    message(FATAL_ERROR "Expected aligned vector loads/stores in dd_codegen_scale_aligned_span:\n${aligned_body}")
+endif()
+if(aligned_body MATCHES "movups[^\n]*\\(")
+    message(FATAL_ERROR "Unexpected unaligned vector loads/stores in dd_codegen_scale_aligned_span:\n${aligned_body}")
+endif()
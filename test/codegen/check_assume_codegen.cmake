@@ -0,0 +1,25 @@
+# Usage: cmake -DCXX=<compiler> -DSOURCE=<file> -DINCLUDE_DIR=<dir> -DOUTPUT=<prefix> -P check_assume_codegen.cmake
+function(compile_body mode out_var)
+    execute_process(
+            COMMAND ${CXX} -std=c++17 -O2 -D${mode} -I${INCLUDE_DIR} -S ${SOURCE} -o ${OUTPUT}.${mode}.s
+            RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Failed to compile ${SOURCE} with ${mode}")
+    endif()
+    file(READ ${OUTPUT}.${mode}.s asm)
+    string(REGEX MATCH "dd_codegen_redundant_check:.*" body "${asm}")
+    string(FIND "${body}" ".cfi_endproc" end)
+    string(SUBSTRING "${body}" 0 ${end} body)
+    set(${out_var} "${body}" PARENT_SCOPE)
+endfunction()
+
+compile_body(DD_SPAN_NO_CONTRACT_CHECKING unchecked_body)
+compile_body(DD_SPAN_ASSUME_ON_CONTRACT_VIOLATION assumed_body)
+
+if(NOT unchecked_body MATCHES "\tcmp")
+    message(FATAL_ERROR "Expected the bounds check without contract assumptions:\n${unchecked_body}")
+endif()
+if(assumed_body MATCHES "\tcmp")
+    message(FATAL_ERROR "Expected the bounds check to be folded into the contract assumption:\n${assumed_body}")
+endif()
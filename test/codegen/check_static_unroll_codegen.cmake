@@ -0,0 +1,32 @@
+# Usage: cmake -DCXX=<compiler> -DSOURCE=<file> -DINCLUDE_DIR=<dir> -DOUTPUT=<file.s>
+#        -P check_static_unroll_codegen.cmake
+execute_process(
+        COMMAND ${CXX} -std=c++17 -O1 -DNDEBUG -I${INCLUDE_DIR} -S ${SOURCE} -o ${OUTPUT}
+        RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Failed to compile ${SOURCE}")
+endif()
+
+file(READ ${OUTPUT} asm)
+function(function_body name out_var)
+    string(REGEX MATCH "${name}:.*" body "${asm}")
+    string(FIND "${body}" ".cfi_endproc" end)
+    string(SUBSTRING "${body}" 0 ${end} body)
+    set(${out_var} "${body}" PARENT_SCOPE)
+endfunction()
+
+function_body(dd_codegen_loop_reduce loop_body)
+function_body(dd_codegen_static_reduce reduce_body)
+function_body(dd_codegen_static_transform transform_body)
+
+# The plain loop shows that -O1 does not unroll on its own; otherwise this test checks nothing
+if(NOT loop_body MATCHES "\tj[a-z]+\t")
+    message(FATAL_ERROR "Expected the plain loop to keep its branch at -O1:\n${loop_body}")
+endif()
+if(reduce_body MATCHES "\tj[a-z]+\t")
+    message(FATAL_ERROR "Expected straight-line code in dd_codegen_static_reduce:\n${reduce_body}")
+endif()
+if(transform_body MATCHES "\tj[a-z]+\t")
+    message(FATAL_ERROR "Expected straight-line code in dd_codegen_static_transform:\n${transform_body}")
+endif()
@@ -0,0 +1,18 @@
+// Compiled to assembly at -O1 by the StaticUnrollCodegen test: the static algorithms must expand into straight-line
+// code where the equivalent loop stays a loop.
+#include "dd/algorithm.hpp"
+
+extern "C" double dd_codegen_loop_reduce(dd::span<const double, 16> s) {
+  double acc = 0;
+  for (double x : s) {
+    acc += x;
+  }
+  return acc;
+}
+
+extern "C" double dd_codegen_static_reduce(dd::span<const double, 16> s) { return dd::static_reduce(s, 0.0); }
+
+extern "C" void dd_codegen_static_transform(dd::span<const float, 8> a, dd::span<const float, 8> b,
+                                            dd::span<float, 8> out) {
+  dd::static_transform(a, b, out, [](float x, float y) { return x * y + 1.0f; });
+}
@@ -0,0 +1,196 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/hash.hpp"
+#include "simd_test_helpers.hpp"
+
+using dd::contract_violation_error;
+using dd::hasher;
+using dd::simd_isa;
+using dd::span;
+
+// Compile-time assertions
+static_assert(std::is_same<decltype(dd::hash_bytes(span<const dd::byte>())), std::uint64_t>::value,
+              "hash_bytes returns 64 bits");
+static_assert(std::is_default_constructible<dd::span_hash<int>>::value, "span_hash is default constructible");
+
+namespace {
+
+std::vector<unsigned char> random_bytes(std::size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<unsigned char> out(n);
+    for (auto &b : out) b = static_cast<unsigned char>(rng());
+    return out;
+}
+
+std::uint64_t hash_of(const std::vector<unsigned char> &v, std::uint64_t seed = 0,
+                      simd_isa isa = dd::best_simd_isa()) {
+    return dd::hash_bytes(dd::as_bytes(span<const unsigned char>(v)), seed, isa);
+}
+
+// Every length class of the short path and the block boundaries of the long one
+const std::size_t lengths[] = {0,   1,   2,   3,   4,    5,    8,    9,    15,   16,   17,   31,   32,   33,
+                               63,  64,  65,  96,  97,   127,  128,  129,  191,  192,  255,  256,  1023, 1024,
+                               1025, 1087, 1088, 2047, 2048, 2049, 4096, 5000, 16384, 100003};
+
+} // namespace
+
+TEST_CASE("Hash values are fixed", "[hash][stability]") {
+    // Pinned so that stored hashes stay valid; a change here is a format change
+    std::vector<unsigned char> counting(2000);
+    for (std::size_t i = 0; i < counting.size(); ++i) counting[i] = static_cast<unsigned char>(i * 7 + 1);
+    const std::size_t sizes[] = {0, 3, 8, 16, 100, 128, 129, 1024, 1025, 2000};
+    std::vector<std::uint64_t> got;
+    for (std::size_t n : sizes) {
+        got.push_back(dd::hash_bytes(dd::as_bytes(span<const unsigned char>(counting.data(), n))));
+    }
+    const std::vector<std::uint64_t> expected = {0xbcfa0660453149b6ull, 0x1a8fadec9319707eull, 0x9453e1274d693462ull,
+                                                 0xd1be6c6b3cd388f1ull, 0x146a8ed6738e7bddull, 0xb69fa781e9dc6ec1ull,
+                                                 0xc009f7078e06acf5ull, 0x1be811fa3861292bull, 0x234550bd5f729423ull,
+                                                 0xfc93e2657dfd40aeull};
+    REQUIRE(got == expected);
+}
+
+TEST_CASE("Every instruction set gives the same hash", "[hash][simd]") {
+    for (std::size_t n : lengths) {
+        INFO("length " << n);
+        const auto data = random_bytes(n, static_cast<unsigned>(n));
+        const std::uint64_t reference = hash_of(data, 42, simd_isa::scalar);
+        for (simd_isa isa : supported_isas()) {
+            INFO(dd::simd_isa_name(isa));
+            REQUIRE(hash_of(data, 42, isa) == reference);
+        }
+    }
+}
+
+TEST_CASE("Unaligned input hashes like aligned input", "[hash][alignment]") {
+    const auto data = random_bytes(3000, 7);
+    for (std::size_t offset = 1; offset < 8; ++offset) {
+        std::vector<unsigned char> shifted(offset, 0);
+        shifted.insert(shifted.end(), data.begin(), data.end());
+        for (simd_isa isa : supported_isas()) {
+            INFO(dd::simd_isa_name(isa));
+            REQUIRE(dd::hash_bytes(dd::as_bytes(span<const unsigned char>(shifted).subspan(offset)), 0, isa) ==
+                    hash_of(data));
+        }
+    }
+}
+
+TEST_CASE("Streaming in pieces matches one-shot hashing", "[hash][hasher]") {
+    std::mt19937 rng(3);
+    for (std::size_t n : lengths) {
+        INFO("length " << n);
+        const auto data = random_bytes(n, static_cast<unsigned>(n) + 1);
+        const std::uint64_t expected = hash_of(data, 9);
+        for (simd_isa isa : supported_isas()) {
+            INFO(dd::simd_isa_name(isa));
+            hasher whole(9, isa);
+            whole.update(span<const unsigned char>(data));
+            REQUIRE(whole.digest() == expected);
+
+            // Random piece sizes, including empty ones and pieces larger than a block
+            hasher pieces(9, isa);
+            std::size_t pos = 0;
+            while (pos < n) {
+                const std::size_t want = rng() % 3 != 0 ? rng() % 70 : rng() % 3000;
+                const std::size_t piece = std::min(n - pos, want);
+                pieces.update(span<const unsigned char>(data.data() + pos, piece));
+                pos += piece;
+            }
+            REQUIRE(pieces.digest() == expected);
+
+            hasher bytewise(9, isa);
+            for (std::size_t i = 0; i < std::min<std::size_t>(n, 5000); ++i) {
+                bytewise.update(span<const unsigned char>(data.data() + i, 1));
+            }
+            if (n <= 5000) {
+                REQUIRE(bytewise.digest() == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("digest leaves the state unchanged and reset starts over", "[hash][hasher]") {
+    const auto data = random_bytes(3000, 11);
+    hasher h(5);
+    h.update(span<const unsigned char>(data).first(1500));
+    const std::uint64_t partial = h.digest();
+    REQUIRE(partial == hash_of(std::vector<unsigned char>(data.begin(), data.begin() + 1500), 5));
+    REQUIRE(h.digest() == partial);
+    h.update(span<const unsigned char>(data).subspan(1500));
+    REQUIRE(h.digest() == hash_of(data, 5));
+
+    h.reset();
+    REQUIRE(h.digest() == hash_of({}, 5));
+    h.update(span<const unsigned char>(data).first(10));
+    REQUIRE(h.digest() == hash_of(std::vector<unsigned char>(data.begin(), data.begin() + 10), 5));
+}
+
+TEST_CASE("Seeds, lengths and single bits change the hash", "[hash][quality]") {
+    for (std::size_t n : {std::size_t(1), std::size_t(7), std::size_t(16), std::size_t(100), std::size_t(128),
+                          std::size_t(129), std::size_t(1500)}) {
+        INFO("length " << n);
+        auto data = random_bytes(n, 1);
+        std::set<std::uint64_t> seen;
+        seen.insert(hash_of(data));
+        REQUIRE(seen.insert(hash_of(data, 1)).second);
+        REQUIRE(seen.insert(hash_of(data, ~std::uint64_t(0))).second);
+        for (std::size_t bit = 0; bit < n * 8; bit += (n > 16 ? 13 : 1)) {
+            data[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+            REQUIRE(seen.insert(hash_of(data)).second);
+            data[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+        }
+    }
+
+    // Zero-filled inputs of different lengths must not collide
+    std::set<std::uint64_t> by_length;
+    for (std::size_t n = 0; n <= 2100; ++n) {
+        REQUIRE(by_length.insert(hash_of(std::vector<unsigned char>(n, 0))).second);
+    }
+}
+
+TEST_CASE("span_hash hashes the element bytes", "[hash][span_hash]") {
+    const std::vector<std::uint32_t> v = {1, 2, 3, 4};
+    dd::span_hash<std::uint32_t> h;
+    REQUIRE(h(span<const std::uint32_t>(v)) == dd::hash_bytes(dd::as_bytes(span<const std::uint32_t>(v))));
+    REQUIRE(h(span<const std::uint32_t, 4>(v.data(), 4)) == h(span<const std::uint32_t>(v)));
+    std::vector<std::uint32_t> w = v;
+    REQUIRE(h(span<std::uint32_t>(w)) == h(span<const std::uint32_t>(v)));
+
+    dd::span_hash<std::uint32_t> seeded{7};
+    REQUIRE(seeded(span<const std::uint32_t>(v)) != h(span<const std::uint32_t>(v)));
+
+    hasher streaming;
+    streaming.update(span<const std::uint32_t>(v).first(1));
+    streaming.update(span<const std::uint32_t>(v).last(3));
+    REQUIRE(streaming.digest() == h(span<const std::uint32_t>(v)));
+}
+
+TEST_CASE("span_hash works as an unordered container hasher", "[hash][span_hash]") {
+    const std::string words[] = {"alpha", "beta", "gamma", "alpha", "delta", "beta"};
+    std::unordered_set<span<const char>, dd::span_hash<char>, bool (*)(span<const char>, span<const char>)> set(
+        8, dd::span_hash<char>(), [](span<const char> a, span<const char> b) {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+        });
+    for (const std::string &w : words) set.insert(span<const char>(w.data(), w.size()));
+    REQUIRE(set.size() == 4);
+    REQUIRE(set.count(span<const char>("gamma", 5)) == 1);
+    REQUIRE(set.count(span<const char>("omega", 5)) == 0);
+}
+
+TEST_CASE("Contract checking: hash", "[hash][contract]") {
+    for (simd_isa isa : {simd_isa::sse2, simd_isa::avx2, simd_isa::avx512, simd_isa::neon}) {
+        if (!dd::simd_supported(isa)) {
+            REQUIRE_THROWS_AS(dd::hash_bytes(span<const dd::byte>(), 0, isa), contract_violation_error);
+            REQUIRE_THROWS_AS(hasher(0, isa), contract_violation_error);
+        }
+    }
+}
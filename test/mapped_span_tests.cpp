@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/mapped_span.hpp"
+
+using dd::contract_violation_error;
+using dd::map_access;
+using dd::map_advice;
+using dd::mapped_file;
+using dd::mapped_span;
+using dd::span;
+
+// Compile-time assertions
+static_assert(!std::is_copy_constructible<mapped_file>::value, "mappings are not copyable");
+static_assert(std::is_nothrow_move_constructible<mapped_file>::value, "mappings are movable");
+static_assert(std::is_nothrow_move_constructible<mapped_span<const float>>::value, "mapped_span is movable");
+static_assert(std::is_convertible<const mapped_span<const float> &, span<const float>>::value,
+              "mapped_span converts to span");
+static_assert(std::is_same<decltype(std::declval<mapped_span<int>>().subspan(1, 2)), span<int>>::value,
+              "subviews are plain spans");
+
+namespace {
+
+// A temporary file holding the given bytes, removed on destruction
+class temp_file {
+public:
+    explicit temp_file(const void *data, std::size_t size) {
+        char name[] = "/tmp/dd_mapped_span_XXXXXX";
+        const int fd = ::mkstemp(name);
+        REQUIRE(fd >= 0);
+        path_ = name;
+        REQUIRE(::write(fd, data, size) == static_cast<ssize_t>(size));
+        ::close(fd);
+    }
+    ~temp_file() { std::remove(path_.c_str()); }
+    const std::string &path() const { return path_; }
+
+private:
+    std::string path_;
+};
+
+std::vector<std::uint32_t> iota_vector(std::size_t n) {
+    std::vector<std::uint32_t> v(n);
+    std::iota(v.begin(), v.end(), 0u);
+    return v;
+}
+
+} // namespace
+
+TEST_CASE("mapped_span maps a whole file", "[mapped_span][read]") {
+    const auto v = iota_vector(5000);
+    temp_file f(v.data(), v.size() * sizeof(std::uint32_t));
+
+    mapped_span<const std::uint32_t> m(f.path());
+    REQUIRE(m.size() == v.size());
+    REQUIRE(m.size_bytes() == v.size() * sizeof(std::uint32_t));
+    REQUIRE(std::equal(m.begin(), m.end(), v.begin()));
+    REQUIRE(m[4321] == 4321u);
+    REQUIRE(!m.file().writable());
+
+    span<const std::uint32_t> s = m;
+    REQUIRE(s.data() == m.data());
+    REQUIRE(m.subspan(100, 3)[2] == 102u);
+    REQUIRE(m.first(2).back() == 1u);
+    REQUIRE(m.last(1)[0] == 4999u);
+
+    REQUIRE(!m.advise(map_advice::sequential));
+    REQUIRE(!m.advise(map_advice::willneed, 1000, 1000));
+    REQUIRE(!m.advise(map_advice::normal));
+}
+
+TEST_CASE("mapped_span maps sub-ranges", "[mapped_span][range]") {
+    // Offsets that are not page multiples exercise the slack handling
+    const auto v = iota_vector(10000);
+    temp_file f(v.data(), v.size() * sizeof(std::uint32_t));
+
+    mapped_span<const std::uint32_t> tail(f.path(), 1234);
+    REQUIRE(tail.size() == 10000u - 1234u);
+    REQUIRE(tail[0] == 1234u);
+
+    mapped_span<const std::uint32_t> window(f.path(), 4097, 10);
+    REQUIRE(window.size() == 10u);
+    REQUIRE(window[9] == 4106u);
+
+    mapped_span<const std::uint32_t> none(f.path(), 10000, 0);
+    REQUIRE(none.empty());
+
+    // A byte-level mapping that skips a header
+    mapped_span<const std::uint32_t> after_header(mapped_file(f.path(), map_access::read_only, 16));
+    REQUIRE(after_header[0] == 4u);
+}
+
+TEST_CASE("mapped_span writes through read_write mappings", "[mapped_span][write]") {
+    const auto v = iota_vector(1024);
+    temp_file f(v.data(), v.size() * sizeof(std::uint32_t));
+    {
+        mapped_span<std::uint32_t> m(f.path());
+        REQUIRE(m.file().access() == map_access::read_write);
+        m[7] = 77;
+        REQUIRE(!m.flush());
+    }
+    {
+        mapped_file cow(f.path(), map_access::copy_on_write);
+        cow.writable_bytes()[0] = 0xff;
+    }
+    mapped_span<const std::uint32_t> m(f.path());
+    REQUIRE(m[7] == 77u);
+    REQUIRE(m[0] == 0u);
+}
+
+TEST_CASE("mapped_file ownership", "[mapped_span][move]") {
+    const auto v = iota_vector(256);
+    temp_file f(v.data(), v.size() * sizeof(std::uint32_t));
+    mapped_file a(f.path());
+    const unsigned char *p = a.data();
+    mapped_file b(std::move(a));
+    REQUIRE(a.data() == nullptr);
+    REQUIRE(a.empty());
+    REQUIRE(b.data() == p);
+    a = std::move(b);
+    REQUIRE(a.size() == 1024u);
+    REQUIRE(a.bytes()[4] == 1);
+}
+
+TEST_CASE("mapped_span reports errors", "[mapped_span][errors]") {
+    const auto v = iota_vector(10);
+    temp_file f(v.data(), v.size() * sizeof(std::uint32_t));
+    std::error_code ec;
+
+    mapped_span<const std::uint32_t> missing("/nonexistent/dd_mapped_span", 0, dd::dynamic_extent, ec);
+    REQUIRE(ec == std::errc::no_such_file_or_directory);
+    REQUIRE(missing.empty());
+
+    // Beyond the end of the file
+    mapped_span<const std::uint32_t> past(f.path(), 5, 6, ec);
+    REQUIRE(ec == std::errc::invalid_argument);
+
+    // 40 bytes do not hold a whole number of 16-byte elements
+    struct quad {
+        std::uint32_t x[4];
+    };
+    mapped_span<const quad> ragged(f.path(), 0, dd::dynamic_extent, ec);
+    REQUIRE(ec == std::errc::invalid_argument);
+
+    // Misaligned start
+    mapped_span<const std::uint32_t> misaligned(mapped_file(f.path(), map_access::read_only, 2), ec);
+    REQUIRE(ec == std::errc::invalid_argument);
+
+    // Writable element type over a read-only mapping
+    mapped_span<std::uint32_t> readonly(mapped_file(f.path()), ec);
+    REQUIRE(ec == std::errc::invalid_argument);
+
+    REQUIRE_THROWS_AS(mapped_span<const std::uint32_t>(f.path(), 11), std::system_error);
+}
+
+TEST_CASE("Contract checking: mapped_span", "[mapped_span][contract]") {
+    const auto v = iota_vector(10);
+    temp_file f(v.data(), v.size() * sizeof(std::uint32_t));
+    mapped_span<const std::uint32_t> m(f.path());
+    REQUIRE_THROWS_AS(m[10], contract_violation_error);
+    REQUIRE_THROWS_AS(m.subspan(11), contract_violation_error);
+    REQUIRE_THROWS_AS(m.advise(map_advice::normal, 11), contract_violation_error);
+    REQUIRE_THROWS_AS(m.file().writable_bytes(), contract_violation_error);
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/mdspan.hpp"
+
+using dd::contract_violation_error;
+using dd::dextents;
+using dd::dynamic_extent;
+using dd::extents;
+using dd::layout_left;
+using dd::layout_right;
+using dd::layout_stride;
+using dd::mdspan;
+using dd::span;
+
+// Compile-time assertions
+static_assert(extents<std::size_t, 3, dynamic_extent, 4>::rank() == 3, "rank mismatch");
+static_assert(extents<std::size_t, 3, dynamic_extent, 4>::rank_dynamic() == 1, "rank_dynamic mismatch");
+static_assert(extents<std::size_t, 3, dynamic_extent, 4>::static_extent(2) == 4, "static_extent mismatch");
+static_assert(std::is_same<dextents<int, 2>, extents<int, dynamic_extent, dynamic_extent>>::value,
+              "dextents mismatch");
+static_assert(std::is_empty<extents<std::size_t, 2, 3>>::value, "static extents must be empty");
+static_assert(sizeof(extents<std::size_t, 2, dynamic_extent, 3>) == sizeof(std::size_t),
+              "only dynamic extents take storage");
+static_assert(sizeof(mdspan<float, extents<std::size_t, 4, 4>>) == sizeof(float *),
+              "static mdspan must be a bare pointer");
+static_assert(layout_right::mapping<extents<std::size_t, 2, 3, 4>>{}(1, 2, 3) == 23, "layout_right offset");
+static_assert(layout_left::mapping<extents<std::size_t, 2, 3, 4>>{}(1, 2, 3) == 23, "layout_left offset");
+static_assert(layout_right::mapping<extents<std::size_t, 2, 3, 4>>{}.stride(0) == 12, "layout_right stride");
+static_assert(layout_left::mapping<extents<std::size_t, 2, 3, 4>>{}.stride(2) == 6, "layout_left stride");
+
+TEST_CASE("Extents construction", "[mdspan][extents]") {
+    extents<std::size_t, 2, dynamic_extent, dynamic_extent> dyn_only(3, 4);
+    REQUIRE(dyn_only.extent(0) == 2);
+    REQUIRE(dyn_only.extent(1) == 3);
+    REQUIRE(dyn_only.extent(2) == 4);
+
+    extents<std::size_t, 2, dynamic_extent, dynamic_extent> all(2, 3, 4);
+    REQUIRE(all == dyn_only);
+
+    extents<int, dynamic_extent, 5> from_array(std::array<int, 1>{{7}});
+    REQUIRE(from_array.extent(0) == 7);
+    REQUIRE(from_array.extent(1) == 5);
+
+    dextents<std::size_t, 2> d(2, 3);
+    REQUIRE(d == extents<std::size_t, 2, 3>{});
+    REQUIRE(d != extents<std::size_t, 3, 2>{});
+}
+
+TEST_CASE("layout_right indexing", "[mdspan][layout]") {
+    std::vector<int> v(24);
+    std::iota(v.begin(), v.end(), 0);
+    mdspan<int, extents<std::size_t, 2, 3, 4>> m(v.data());
+    REQUIRE(m.rank() == 3);
+    REQUIRE(m.size() == 24);
+    REQUIRE(m.extent(1) == 3);
+    REQUIRE(m(0, 0, 0) == 0);
+    REQUIRE(m(0, 1, 2) == 6);
+    REQUIRE(m(1, 2, 3) == 23);
+    REQUIRE(m.stride(0) == 12);
+    REQUIRE(m.stride(1) == 4);
+    REQUIRE(m.stride(2) == 1);
+    REQUIRE(m.is_exhaustive());
+    REQUIRE(m(std::array<int, 3>{{1, 0, 1}}) == 13);
+
+    m(1, 1, 1) = -1;
+    REQUIRE(v[17] == -1);
+}
+
+TEST_CASE("layout_left indexing", "[mdspan][layout]") {
+    std::vector<int> v(12);
+    std::iota(v.begin(), v.end(), 0);
+    mdspan<int, dextents<std::size_t, 2>, layout_left> m(v.data(), 3, 4);
+    REQUIRE(m(0, 0) == 0);
+    REQUIRE(m(1, 0) == 1);
+    REQUIRE(m(0, 1) == 3);
+    REQUIRE(m(2, 3) == 11);
+    REQUIRE(m.stride(0) == 1);
+    REQUIRE(m.stride(1) == 3);
+}
+
+TEST_CASE("layout_stride indexing", "[mdspan][layout]") {
+    std::vector<int> v(32);
+    std::iota(v.begin(), v.end(), 0);
+    // A 3x2 window with leading dimension 8, every other column
+    layout_stride::mapping<dextents<std::size_t, 2>> map(dextents<std::size_t, 2>(3, 2), std::array<int, 2>{{8, 2}});
+    REQUIRE(map.required_span_size() == 19);
+    REQUIRE(!map.is_exhaustive());
+    mdspan<int, dextents<std::size_t, 2>, layout_stride> m(v.data(), map);
+    REQUIRE(m(0, 1) == 2);
+    REQUIRE(m(2, 1) == 18);
+
+    layout_stride::mapping<extents<std::size_t, 2, 3>> from_right(layout_right::mapping<extents<std::size_t, 2, 3>>{});
+    REQUIRE(from_right.stride(0) == 3);
+    REQUIRE(from_right.stride(1) == 1);
+    REQUIRE(from_right.is_exhaustive());
+}
+
+TEST_CASE("mdspan over span", "[mdspan][span]") {
+    std::vector<float> v(12, 1.0f);
+    span<float> s(v);
+    mdspan<float, extents<std::size_t, dynamic_extent, 4>> m(s, 3);
+    REQUIRE(m.extent(0) == 3);
+    REQUIRE(m.data_handle() == v.data());
+    m(2, 3) = 5.0f;
+    REQUIRE(v[11] == 5.0f);
+
+    mdspan<const float, extents<std::size_t, dynamic_extent, 4>> cm = m;
+    REQUIRE(cm(2, 3) == 5.0f);
+}
+
+#ifdef DD_SPAN_HAVE_DEDUCTION_GUIDES
+TEST_CASE("mdspan deduction", "[mdspan][deduction]") {
+    int arr[6] = {0, 1, 2, 3, 4, 5};
+    auto m = mdspan(arr, 2, 3);
+    static_assert(std::is_same_v<decltype(m), mdspan<int, dextents<std::size_t, 2>>>);
+    REQUIRE(m(1, 2) == 5);
+}
+#endif
+
+TEST_CASE("Contract checking: mdspan", "[mdspan][contract]") {
+    std::vector<int> v(12);
+    mdspan<int, dextents<std::size_t, 2>> m(v.data(), 3, 4);
+    REQUIRE_THROWS_AS(m(3, 0), contract_violation_error);
+    REQUIRE_THROWS_AS(m(0, 4), contract_violation_error);
+    REQUIRE_THROWS_AS(m(-1, 0), contract_violation_error);
+    REQUIRE_THROWS_AS((extents<std::size_t, 2, dynamic_extent>(3, 4)), contract_violation_error);
+    REQUIRE_THROWS_AS((mdspan<int, dextents<std::size_t, 2>>(span<int>(v), 4, 4)), contract_violation_error);
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/parallel.hpp"
+
+using dd::contract_violation_error;
+using dd::span;
+using dd::thread_pool;
+
+TEST_CASE("thread_pool runs every task once", "[parallel][pool]") {
+    thread_pool pool(3);
+    REQUIRE(pool.concurrency() == 4);
+    std::vector<std::atomic<int>> hits(1000);
+    pool.run(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+    for (auto &h : hits) REQUIRE(h.load() == 1);
+
+    thread_pool inline_pool(0);
+    int count = 0;
+    inline_pool.run(10, [&](std::size_t) { ++count; });
+    REQUIRE(count == 10);
+}
+
+TEST_CASE("thread_pool nested runs and exceptions", "[parallel][pool]") {
+    thread_pool pool(2);
+    std::atomic<int> total{0};
+    pool.run(8, [&](std::size_t) { pool.run(8, [&](std::size_t) { total.fetch_add(1); }); });
+    REQUIRE(total.load() == 64);
+    REQUIRE_THROWS_AS(pool.run(16,
+                               [](std::size_t i) {
+                                   if (i == 7) throw std::runtime_error("task failed");
+                               }),
+                      std::runtime_error);
+}
+
+TEST_CASE("parallel_for and parallel_transform", "[parallel][for]") {
+    thread_pool pool(3);
+    std::vector<int> v(100000);
+    std::iota(v.begin(), v.end(), 0);
+    dd::parallel_for(pool, span<int>(v), [](int &x) { x *= 2; });
+    for (std::size_t i = 0; i < v.size(); ++i) REQUIRE(v[i] == int(2 * i));
+
+    std::vector<double> out(v.size());
+    dd::parallel_transform(pool, span<const int>(v), span<double>(out), [](int x) { return x + 0.5; });
+    REQUIRE(out.front() == 0.5);
+    REQUIRE(out.back() == 2.0 * (v.size() - 1) + 0.5);
+
+    dd::parallel_for(span<int>(), [](int &) {});
+}
+
+TEST_CASE("parallel_reduce", "[parallel][reduce]") {
+    thread_pool pool(3);
+    std::vector<long long> v(123457);
+    std::iota(v.begin(), v.end(), 1);
+    const long long n = static_cast<long long>(v.size());
+    REQUIRE(dd::parallel_reduce(pool, span<const long long>(v), 0LL, std::plus<long long>()) == n * (n + 1) / 2);
+    REQUIRE(dd::parallel_reduce(span<const long long>(v), 10LL) == n * (n + 1) / 2 + 10);
+    REQUIRE(dd::parallel_reduce(pool, span<const long long>(v), 0LL,
+                                [](long long a, long long b) { return a > b ? a : b; }) == n);
+    REQUIRE(dd::parallel_reduce(pool, span<const long long>(), 7LL, std::plus<long long>()) == 7);
+}
+
+TEST_CASE("parallel_inclusive_scan", "[parallel][scan]") {
+    thread_pool pool(3);
+    std::vector<int> v(50001, 1);
+    std::vector<int> out(v.size());
+    dd::parallel_inclusive_scan(pool, span<const int>(v), span<int>(out), std::plus<int>());
+    for (std::size_t i = 0; i < out.size(); ++i) REQUIRE(out[i] == int(i + 1));
+
+    std::vector<int> expected(v.size());
+    std::iota(v.begin(), v.end(), 0);
+    std::partial_sum(v.begin(), v.end(), expected.begin());
+    dd::parallel_inclusive_scan(span<int>(v), span<int>(v)); // in place
+    REQUIRE(v == expected);
+}
+
+TEST_CASE("Contract checking: parallel algorithms", "[parallel][contract]") {
+    std::vector<int> a(10), b(11);
+    REQUIRE_THROWS_AS(dd::parallel_transform(span<int>(a), span<int>(b), [](int x) { return x; }),
+                      contract_violation_error);
+    REQUIRE_THROWS_AS(dd::parallel_inclusive_scan(span<int>(a), span<int>(b)), contract_violation_error);
+}
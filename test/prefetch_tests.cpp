@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/prefetch.hpp"
+
+using dd::contract_violation_error;
+using dd::prefetch_access;
+using dd::prefetch_locality;
+using dd::span;
+
+// Compile-time assertions
+static_assert(std::is_same<decltype(dd::streaming(std::declval<span<const int>>())),
+                           dd::prefetched_view<const int, prefetch_access::read, prefetch_locality::none>>::value,
+              "streaming prefetches non-temporally");
+static_assert(std::is_same<std::iterator_traits<dd::prefetched_view<float>::iterator>::iterator_category,
+                           std::forward_iterator_tag>::value,
+              "prefetching iterators are forward iterators");
+static_assert(std::is_same<decltype(*dd::prefetched(std::declval<span<float>>()).begin()), float &>::value,
+              "prefetched views of mutable spans are mutable");
+
+TEST_CASE("prefetched visits every element in order", "[prefetch][sequential]") {
+    std::vector<std::uint32_t> v(1000);
+    std::iota(v.begin(), v.end(), 0u);
+    for (std::size_t distance : {0u, 1u, 15u, 16u, 100u, 999u, 1000u, 5000u}) {
+        const auto view = dd::prefetched(span<const std::uint32_t>(v), distance);
+        REQUIRE(view.size() == v.size());
+        REQUIRE(view.distance() == distance);
+        REQUIRE(std::equal(view.begin(), view.end(), v.begin(), v.end()));
+    }
+    REQUIRE(dd::prefetched(span<const std::uint32_t>(v)).distance() == DD_SPAN_PREFETCH_DISTANCE_BYTES / 4);
+
+    std::uint64_t sum = 0;
+    for (std::uint32_t x : dd::streaming(span<const std::uint32_t>(v))) sum += x;
+    REQUIRE(sum == 999u * 1000u / 2);
+}
+
+TEST_CASE("prefetched views write through", "[prefetch][sequential]") {
+    struct wide {
+        double values[20];
+    };
+    std::vector<wide> v(50);
+    for (wide &w : dd::prefetched<prefetch_access::write, prefetch_locality::low>(span<wide>(v), 3)) {
+        w.values[19] = 2.0;
+    }
+    REQUIRE(std::all_of(v.begin(), v.end(), [](const wide &w) { return w.values[19] == 2.0; }));
+
+    auto it = dd::prefetched(span<wide>(v)).begin();
+    it->values[0] = 1.0;
+    auto prev = it++;
+    REQUIRE(prev->values[0] == 1.0);
+    REQUIRE(&*it == &v[1]);
+
+    const auto empty = dd::streaming(span<int>());
+    REQUIRE(empty.empty());
+    REQUIRE(empty.begin() == empty.end());
+}
+
+TEST_CASE("for_each over a prefetched view visits every element once", "[prefetch][for_each]") {
+    for (std::size_t n : {0u, 1u, 63u, 64u, 65u, 1000u}) {
+        std::vector<std::uint8_t> bytes(n, 1);
+        for (std::size_t distance : {0u, 7u, 512u, 100000u}) {
+            dd::for_each(dd::prefetched<prefetch_access::write>(span<std::uint8_t>(bytes), distance),
+                         [](std::uint8_t &b) { b = static_cast<std::uint8_t>(b + 1); });
+        }
+        REQUIRE(std::all_of(bytes.begin(), bytes.end(), [](std::uint8_t b) { return b == 5; }));
+    }
+
+    std::vector<double> big(333);
+    std::iota(big.begin(), big.end(), 0.0);
+    std::vector<double> seen;
+    dd::for_each(dd::streaming(span<const double>(big), 3), [&](double x) { seen.push_back(x); });
+    REQUIRE(seen == big);
+}
+
+TEST_CASE("gathered visits values through indices", "[prefetch][gather]") {
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+    std::vector<std::uint32_t> idx = {5, 99, 0, 42, 42, 7};
+    for (std::size_t distance : {0u, 1u, 2u, 16u}) {
+        const auto view = dd::gathered(span<const int>(values), span<const std::uint32_t>(idx), distance);
+        REQUIRE(view.size() == idx.size());
+        std::vector<int> seen(view.begin(), view.end());
+        REQUIRE(seen == std::vector<int>{5, 99, 0, 42, 42, 7});
+    }
+
+    for (int &x : dd::gathered(span<int>(values), span<std::uint32_t>(idx))) x += 1000;
+    REQUIRE(values[42] == 2042);
+    REQUIRE(values[5] == 1005);
+    REQUIRE(values[6] == 6);
+
+    auto it = dd::gathered(span<int>(values), span<const std::uint32_t>(idx)).begin();
+    ++it;
+    REQUIRE(it.index() == idx.data() + 1);
+}
+
+TEST_CASE("Contract checking: prefetch", "[prefetch][contract]") {
+    std::vector<int> values(10, 1);
+    // Out-of-range indices ahead of the cursor are skipped by the prefetch, not dereferenced
+    std::vector<std::size_t> idx = {1, 2, 1000000, 3};
+    auto view = dd::gathered(span<const int>(values), span<const std::size_t>(idx), 2);
+    auto it = view.begin();
+    REQUIRE(*it == 1);
+    ++it;
+    REQUIRE(*it == 1);
+    ++it;
+    REQUIRE_THROWS_AS(*it, contract_violation_error);
+}
@@ -0,0 +1,231 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/queue.hpp"
+
+using dd::contract_violation_error;
+using dd::mpmc_queue;
+using dd::spsc_queue;
+
+// Compile-time assertions
+static_assert(std::is_base_of<dd::ring_segments<int>, spsc_queue<int>::reservation>::value,
+              "reservations are ring segments");
+static_assert(!std::is_copy_constructible<spsc_queue<int>>::value, "queues are not copyable");
+static_assert(!std::is_copy_constructible<mpmc_queue<int>>::value, "queues are not copyable");
+
+namespace {
+
+template <typename T> std::vector<T> flatten(const dd::queue_reservation<T> &r) {
+    std::vector<T> out(r.first.begin(), r.first.end());
+    out.insert(out.end(), r.second.begin(), r.second.end());
+    return out;
+}
+
+template <typename T> void fill(const dd::queue_reservation<T> &r, T &next) {
+    for (T &x : r.first) x = next++;
+    for (T &x : r.second) x = next++;
+}
+
+} // namespace
+
+TEST_CASE("spsc_queue reservations wrap into two spans", "[queue][spsc]") {
+    spsc_queue<int> q(5);
+    REQUIRE(q.capacity() == 5);
+    int next = 0;
+    auto w = q.reserve(3);
+    REQUIRE(w.size() == 3);
+    REQUIRE(w.second.empty());
+    fill(w, next);
+    q.commit(w);
+    REQUIRE(q.size_approx() == 3);
+
+    auto r = q.peek(10);
+    REQUIRE(flatten(r) == std::vector<int>{0, 1, 2});
+    q.release(2);
+    REQUIRE(q.size_approx() == 1);
+
+    // Four free slots: two before the end of the storage, two after the wrap
+    w = q.reserve(10);
+    REQUIRE(w.first.size() == 2);
+    REQUIRE(w.second.size() == 2);
+    REQUIRE(w.second.data() == w.first.data() - 3);
+    fill(w, next);
+    q.commit(3);
+    REQUIRE(flatten(q.peek(10)) == std::vector<int>{2, 3, 4, 5});
+    REQUIRE(q.reserve(10).size() == 1);
+    q.commit(1);
+    REQUIRE(q.reserve(1).empty());
+    REQUIRE(flatten(q.peek(10)) == std::vector<int>{2, 3, 4, 5, 6});
+}
+
+TEST_CASE("spsc_queue try_push and try_pop", "[queue][spsc]") {
+    spsc_queue<int> q(2);
+    int out = 0;
+    REQUIRE_FALSE(q.try_pop(out));
+    REQUIRE(q.try_push(1));
+    REQUIRE(q.try_push(2));
+    REQUIRE_FALSE(q.try_push(3));
+    REQUIRE(q.try_pop(out));
+    REQUIRE(out == 1);
+    REQUIRE(q.try_push(3));
+    REQUIRE(q.try_pop(out));
+    REQUIRE(out == 2);
+    REQUIRE(q.try_pop(out));
+    REQUIRE(out == 3);
+    REQUIRE(q.size_approx() == 0);
+}
+
+TEST_CASE("spsc_queue moves batches between threads in order", "[queue][spsc][threads]") {
+    constexpr std::uint32_t total = 200000;
+    spsc_queue<std::uint32_t> q(1000);
+    std::thread producer([&] {
+        std::uint32_t next = 0;
+        while (next < total) {
+            const auto w = q.reserve(std::min<std::uint32_t>(64, total - next));
+            if (w.empty()) {
+                std::this_thread::yield();
+                continue;
+            }
+            fill(w, next);
+            q.commit(w);
+        }
+    });
+    std::uint32_t expected = 0;
+    bool in_order = true;
+    while (expected < total) {
+        const auto r = q.peek(100);
+        if (r.empty()) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (std::uint32_t x : flatten(r)) in_order = in_order && x == expected++;
+        q.release(r);
+    }
+    producer.join();
+    REQUIRE(in_order);
+    REQUIRE(q.size_approx() == 0);
+}
+
+TEST_CASE("mpmc_queue rounds the capacity and wraps reservations", "[queue][mpmc]") {
+    mpmc_queue<int> q(6);
+    REQUIRE(q.capacity() == 8);
+    int next = 0;
+    auto w = q.reserve(6);
+    fill(w, next);
+    q.commit(w);
+    auto r = q.peek(5);
+    REQUIRE(flatten(r) == std::vector<int>{0, 1, 2, 3, 4});
+    q.release(r);
+
+    w = q.reserve(20);
+    REQUIRE(w.size() == 7);
+    REQUIRE(w.first.size() == 2);
+    REQUIRE(w.second.size() == 5);
+    REQUIRE(w.position == 6);
+    fill(w, next);
+    REQUIRE(q.reserve(1).empty());
+    // Filled but not committed slots are not visible yet
+    r = q.peek(20);
+    REQUIRE(flatten(r) == std::vector<int>{5});
+    q.commit(w);
+    q.release(r);
+    REQUIRE(flatten(q.peek(20)) == std::vector<int>{6, 7, 8, 9, 10, 11, 12});
+}
+
+TEST_CASE("mpmc_queue try_push and try_pop", "[queue][mpmc]") {
+    mpmc_queue<int> q(2);
+    int out = 0;
+    REQUIRE_FALSE(q.try_pop(out));
+    REQUIRE(q.try_push(1));
+    REQUIRE(q.try_push(2));
+    REQUIRE_FALSE(q.try_push(3));
+    REQUIRE(q.try_pop(out));
+    REQUIRE(out == 1);
+    REQUIRE(q.try_push(3));
+    REQUIRE(q.size_approx() == 2);
+}
+
+TEST_CASE("mpmc_queue delivers every element exactly once", "[queue][mpmc][threads]") {
+    constexpr std::uint32_t per_producer = 50000;
+    constexpr std::uint32_t producers = 3;
+    constexpr std::uint32_t consumers = 3;
+    mpmc_queue<std::uint32_t> q(256);
+    std::vector<std::thread> threads;
+    for (std::uint32_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&q, p] {
+            std::uint32_t next = p * per_producer;
+            const std::uint32_t end = next + per_producer;
+            while (next < end) {
+                // Alternate single elements and batches
+                const auto w = next % 2 == 0 ? q.reserve(std::min<std::uint32_t>(17, end - next)) : q.reserve(1);
+                if (w.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                fill(w, next);
+                q.commit(w);
+            }
+        });
+    }
+    std::vector<std::vector<std::uint32_t>> received(consumers);
+    std::atomic<std::uint32_t> remaining{producers * per_producer};
+    for (std::uint32_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            while (remaining.load() != 0) {
+                const auto r = q.peek(c + 1 == consumers ? 1 : 32);
+                if (r.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto batch = flatten(r);
+                q.release(r);
+                received[c].insert(received[c].end(), batch.begin(), batch.end());
+                remaining.fetch_sub(static_cast<std::uint32_t>(batch.size()));
+            }
+        });
+    }
+    for (auto &t : threads) t.join();
+
+    std::vector<std::uint32_t> all;
+    for (std::uint32_t c = 0; c < consumers; ++c) {
+        // Each producer's elements reach any one consumer in the order they were produced
+        std::vector<std::uint32_t> last(producers, 0);
+        bool ordered = true;
+        for (std::uint32_t x : received[c]) {
+            ordered = ordered && x + 1 > last[x / per_producer];
+            last[x / per_producer] = x + 1;
+        }
+        REQUIRE(ordered);
+        all.insert(all.end(), received[c].begin(), received[c].end());
+    }
+    std::sort(all.begin(), all.end());
+    REQUIRE(all.size() == producers * per_producer);
+    bool exact = true;
+    for (std::uint32_t i = 0; i < all.size(); ++i) exact = exact && all[i] == i;
+    REQUIRE(exact);
+    REQUIRE(q.size_approx() == 0);
+}
+
+TEST_CASE("Contract checking: queue", "[queue][contract]") {
+    REQUIRE_THROWS_AS(spsc_queue<int>(0), contract_violation_error);
+    REQUIRE_THROWS_AS(mpmc_queue<int>(0), contract_violation_error);
+    spsc_queue<int> q(4);
+    q.reserve(2);
+    REQUIRE_THROWS_AS(q.commit(3), contract_violation_error);
+    q.commit(2);
+    REQUIRE_THROWS_AS(q.commit(1), contract_violation_error);
+    q.peek(1);
+    REQUIRE_THROWS_AS(q.release(2), contract_violation_error);
+
+    mpmc_queue<int> m(4);
+    const auto w = m.reserve(2);
+    m.commit(w);
+    REQUIRE_THROWS_AS(m.commit(w), contract_violation_error);
+}
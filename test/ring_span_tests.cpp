@@ -0,0 +1,181 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/ring_span.hpp"
+
+using dd::contract_violation_error;
+using dd::ring_span;
+using dd::span;
+
+// Compile-time assertions
+static_assert(std::is_same<ring_span<int>::reference, int &>::value, "ring elements are mutable");
+static_assert(std::is_same<std::iterator_traits<ring_span<int>::iterator>::iterator_category,
+                           std::random_access_iterator_tag>::value,
+              "ring iterators are random access");
+static_assert(std::is_same<ring_span<int>::segments_type, dd::ring_segments<int>>::value, "segments are spans");
+
+namespace {
+
+// The logical contents, through operator[]
+template <typename Ring> std::vector<int> contents(const Ring &r) {
+    std::vector<int> out;
+    for (std::size_t i = 0; i < r.size(); ++i) out.push_back(r[i]);
+    return out;
+}
+
+template <typename T> std::vector<int> flatten(const dd::ring_segments<T> &seg) {
+    std::vector<int> out(seg.first.begin(), seg.first.end());
+    out.insert(out.end(), seg.second.begin(), seg.second.end());
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("push_back and pop_front wrap around the storage", "[ring_span][fifo]") {
+    std::array<int, 4> storage{};
+    ring_span<int> r{span<int>(storage)};
+    REQUIRE(r.capacity() == 4);
+    REQUIRE(r.empty());
+    for (int i = 0; i < 4; ++i) r.push_back(i);
+    REQUIRE(r.full());
+    REQUIRE(r.front() == 0);
+    REQUIRE(r.back() == 3);
+    r.pop_front();
+    r.pop_front();
+    r.push_back(4);
+    r.push_back(5);
+    REQUIRE(r.head() == 2);
+    REQUIRE(contents(r) == std::vector<int>{2, 3, 4, 5});
+    REQUIRE(storage == std::array<int, 4>{4, 5, 2, 3});
+    REQUIRE(std::vector<int>(r.begin(), r.end()) == std::vector<int>{2, 3, 4, 5});
+    REQUIRE(r.end() - r.begin() == 4);
+    REQUIRE(r.begin()[3] == 5);
+    r[1] = 30;
+    REQUIRE(storage[3] == 30);
+    r.clear();
+    REQUIRE(r.empty());
+    REQUIRE(r.head() == 0);
+}
+
+TEST_CASE("Views can start at any head and size", "[ring_span][construct]") {
+    std::vector<int> storage = {10, 11, 12, 13, 14};
+    ring_span<int> r(span<int>(storage), 3, 4);
+    REQUIRE(contents(r) == std::vector<int>{13, 14, 10, 11});
+    REQUIRE(flatten(r.readable_segments()) == std::vector<int>{13, 14, 10, 11});
+    REQUIRE(r.readable_segments().first.size() == 2);
+    REQUIRE(r.writable_segments().size() == 1);
+    REQUIRE(r.writable_segments().first.data() == storage.data() + 2);
+
+    // A copy keeps its own head and size
+    ring_span<int> copy = r;
+    copy.pop_front();
+    REQUIRE(r.size() == 4);
+    REQUIRE(copy.size() == 3);
+}
+
+TEST_CASE("Segments split at the end of the storage", "[ring_span][segments]") {
+    for (std::size_t capacity : {std::size_t(1), std::size_t(5), std::size_t(8)}) {
+        std::vector<int> storage(capacity);
+        for (std::size_t head = 0; head < capacity; ++head) {
+            for (std::size_t size = 0; size <= capacity; ++size) {
+                INFO("capacity " << capacity << " head " << head << " size " << size);
+                ring_span<int> r(span<int>(storage), head, size);
+                const auto used = r.readable_segments();
+                const auto free = r.writable_segments();
+                REQUIRE(used.size() == size);
+                REQUIRE(free.size() == capacity - size);
+                REQUIRE((used.second.empty() || used.second.data() == storage.data()));
+                REQUIRE((free.second.empty() || free.second.data() == storage.data()));
+                REQUIRE(used.first.data() == storage.data() + head);
+                // Used and free slots tile the storage exactly once
+                std::vector<int> hits(capacity, 0);
+                for (auto s : {used.first, used.second, free.first, free.second}) {
+                    for (int &x : s) ++hits[static_cast<std::size_t>(&x - storage.data())];
+                }
+                REQUIRE(hits == std::vector<int>(capacity, 1));
+            }
+        }
+    }
+}
+
+TEST_CASE("commit and consume move the ends after direct segment access", "[ring_span][segments]") {
+    std::array<int, 6> storage{};
+    ring_span<int> r(span<int>(storage), 4, 0);
+    auto free = r.writable_segments();
+    REQUIRE(free.first.size() == 2);
+    REQUIRE(free.second.size() == 4);
+    free.first[0] = 1;
+    free.first[1] = 2;
+    free.second[0] = 3;
+    r.commit(3);
+    REQUIRE(contents(r) == std::vector<int>{1, 2, 3});
+    r.consume(2);
+    REQUIRE(contents(r) == std::vector<int>{3});
+    REQUIRE(r.head() == 0);
+    r.consume(0);
+    REQUIRE(r.size() == 1);
+}
+
+TEST_CASE("Bulk write and read match a deque", "[ring_span][bulk]") {
+    std::mt19937 rng(5);
+    for (std::size_t capacity : {std::size_t(7), std::size_t(16)}) {
+        std::vector<int> storage(capacity);
+        ring_span<int> r{span<int>(storage)};
+        std::deque<int> model;
+        int next = 0;
+        for (int step = 0; step < 500; ++step) {
+            if (rng() % 2 == 0) {
+                std::vector<int> in(rng() % (capacity + 3));
+                for (int &x : in) x = next++;
+                const std::size_t n = r.write(span<const int>(in));
+                REQUIRE(n == std::min(in.size(), capacity - model.size()));
+                model.insert(model.end(), in.begin(), in.begin() + static_cast<std::ptrdiff_t>(n));
+                next -= static_cast<int>(in.size() - n);
+            } else {
+                std::vector<int> out(rng() % (capacity + 3), -1);
+                const std::size_t n = r.read(span<int>(out));
+                REQUIRE(n == std::min(out.size(), model.size()));
+                REQUIRE(std::vector<int>(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(n)) ==
+                        std::vector<int>(model.begin(), model.begin() + static_cast<std::ptrdiff_t>(n)));
+                model.erase(model.begin(), model.begin() + static_cast<std::ptrdiff_t>(n));
+            }
+            REQUIRE(contents(r) == std::vector<int>(model.begin(), model.end()));
+        }
+    }
+}
+
+TEST_CASE("Static extents keep the capacity in the type", "[ring_span][static]") {
+    std::array<int, 8> storage{};
+    ring_span<int, 8> r{span<int, 8>(storage)};
+    static_assert(sizeof(ring_span<int, 8>) < sizeof(ring_span<int>), "static rings do not store a capacity");
+    for (int i = 0; i < 20; ++i) {
+        if (r.full()) r.pop_front();
+        r.push_back(i);
+    }
+    REQUIRE(contents(r) == std::vector<int>{12, 13, 14, 15, 16, 17, 18, 19});
+    REQUIRE(r.head() == 4);
+}
+
+TEST_CASE("Contract checking: ring_span", "[ring_span][contract]") {
+    std::array<int, 3> storage{};
+    REQUIRE_THROWS_AS(ring_span<int>(span<int>(storage), 3, 0), contract_violation_error);
+    REQUIRE_THROWS_AS(ring_span<int>(span<int>(storage), 0, 4), contract_violation_error);
+    ring_span<int> r{span<int>(storage)};
+    REQUIRE_THROWS_AS(r.front(), contract_violation_error);
+    REQUIRE_THROWS_AS(r.back(), contract_violation_error);
+    REQUIRE_THROWS_AS(r.pop_front(), contract_violation_error);
+    REQUIRE_THROWS_AS(r.consume(1), contract_violation_error);
+    r.push_back(1);
+    REQUIRE_THROWS_AS(r[1], contract_violation_error);
+    REQUIRE_THROWS_AS(r.commit(3), contract_violation_error);
+    r.commit(2);
+    REQUIRE_THROWS_AS(r.push_back(4), contract_violation_error);
+}
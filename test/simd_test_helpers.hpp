@@ -0,0 +1,17 @@
+#pragma once
+
+// Helpers shared by the tests of the instruction-set dispatched kernels
+
+#include <vector>
+
+#include "dd/simd.hpp"
+
+// Every instruction set this CPU can run, so that each kernel is checked against the scalar one
+inline std::vector<dd::simd_isa> supported_isas() {
+    std::vector<dd::simd_isa> isas;
+    for (dd::simd_isa isa :
+         {dd::simd_isa::scalar, dd::simd_isa::sse2, dd::simd_isa::avx2, dd::simd_isa::avx512, dd::simd_isa::neon}) {
+        if (dd::simd_supported(isa)) isas.push_back(isa);
+    }
+    return isas;
+}
@@ -0,0 +1,114 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/simd.hpp"
+#include "simd_test_helpers.hpp"
+
+using dd::contract_violation_error;
+using dd::simd_isa;
+using dd::span;
+
+namespace {
+
+// Small integral values keep floating-point sums exact regardless of the summation order
+template <typename T> std::vector<T> make_data(std::size_t n) {
+    std::vector<T> v(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<T>(static_cast<int>((i * 37 + 11) % 23) - 7);
+    return v;
+}
+
+template <typename T> void check_kernels() {
+    for (std::size_t n : {0u, 1u, 3u, 7u, 15u, 16u, 17u, 31u, 64u, 65u, 127u, 200u, 1000u, 4099u}) {
+        // Unaligned start as well
+        for (std::size_t offset : {0u, 1u}) {
+            std::vector<T> storage = make_data<T>(n + offset);
+            std::vector<T> other = make_data<T>(n + offset);
+            std::reverse(other.begin(), other.end());
+            span<const T> s = span<const T>(storage).subspan(offset);
+            span<const T> o = span<const T>(other).subspan(offset);
+
+            T expected_sum = T();
+            T expected_dot = T();
+            for (std::size_t i = 0; i < n; ++i) {
+                expected_sum = static_cast<T>(expected_sum + s[i]);
+                expected_dot = static_cast<T>(expected_dot + s[i] * o[i]);
+            }
+            const std::size_t expected_count = static_cast<std::size_t>(std::count(s.begin(), s.end(), T(3)));
+            const std::size_t expected_if =
+                static_cast<std::size_t>(std::count_if(s.begin(), s.end(), [](T x) { return x > T(2); }));
+
+            for (simd_isa isa : supported_isas()) {
+                INFO(dd::simd_isa_name(isa) << " n=" << n << " offset=" << offset);
+                REQUIRE(dd::sum(s, isa) == expected_sum);
+                REQUIRE(dd::dot(s, o, isa) == expected_dot);
+                REQUIRE(dd::count(s, T(3), isa) == expected_count);
+                REQUIRE(dd::count_if(s, [](T x) { return x > T(2); }, isa) == expected_if);
+                REQUIRE(dd::find(s, T(3), isa) == std::find(s.begin(), s.end(), T(3)));
+                REQUIRE(dd::find(s, T(99), isa) == s.end());
+                if (n != 0) {
+                    const auto mm = std::minmax_element(s.begin(), s.end());
+                    REQUIRE(dd::minmax(s, isa) == std::make_pair(*mm.first, *mm.second));
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("simd_isa detection", "[simd][isa]") {
+    REQUIRE(dd::simd_supported(simd_isa::scalar));
+    REQUIRE(dd::simd_supported(dd::best_simd_isa()));
+    REQUIRE(std::string(dd::simd_isa_name(simd_isa::avx2)) == "avx2");
+}
+
+TEST_CASE("simd kernels match the scalar results", "[simd][kernels]") {
+    check_kernels<float>();
+    check_kernels<double>();
+    check_kernels<std::int32_t>();
+    check_kernels<std::uint32_t>();
+    check_kernels<std::int64_t>();
+    check_kernels<std::int16_t>();
+    check_kernels<std::int8_t>();
+    check_kernels<std::uint8_t>();
+}
+
+TEST_CASE("simd kernels on mutable and static spans", "[simd][spans]") {
+    std::vector<float> v(100);
+    std::iota(v.begin(), v.end(), 1.0f);
+    span<float> s(v);
+    REQUIRE(dd::sum(s) == 5050.0f);
+    auto it = dd::find(s, 42.0f);
+    REQUIRE(it == s.begin() + 41);
+    *it = -1.0f;
+    REQUIRE(dd::minmax(s) == std::make_pair(-1.0f, 100.0f));
+
+    int arr[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    span<int, 8> fixed(arr);
+    REQUIRE(dd::sum(fixed) == 36);
+    REQUIRE(dd::dot(fixed, span<const int, 8>(arr)) == 204);
+    REQUIRE(dd::count_if(fixed, [](int x) { return x % 2 == 0; }) == 4);
+
+    // Many matches in narrow lanes exercise the counter flushes
+    std::vector<std::int8_t> bytes(100000, 5);
+    REQUIRE(dd::count(span<const std::int8_t>(bytes), std::int8_t(5)) == bytes.size());
+
+    long double ld[3] = {1.0L, 2.0L, 3.0L};
+    REQUIRE(dd::sum(span<long double>(ld)) == 6.0L);
+}
+
+TEST_CASE("Contract checking: simd", "[simd][contract]") {
+    std::vector<float> a(4), b(5);
+    REQUIRE_THROWS_AS(dd::dot(span<const float>(a), span<const float>(b)), contract_violation_error);
+    REQUIRE_THROWS_AS(dd::minmax(span<const float>()), contract_violation_error);
+    for (simd_isa isa : {simd_isa::sse2, simd_isa::avx2, simd_isa::avx512, simd_isa::neon}) {
+        if (!dd::simd_supported(isa)) {
+            REQUIRE_THROWS_AS(dd::sum(span<const float>(a), isa), contract_violation_error);
+        }
+    }
+}
@@ -0,0 +1,270 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/sort.hpp"
+
+using dd::contract_violation_error;
+using dd::merge;
+using dd::radix_sort;
+using dd::radix_sort_by_key;
+using dd::span;
+using dd::thread_pool;
+
+// Compile-time assertions
+static_assert(dd::detail::is_radix_key<std::uint32_t>::value, "unsigned integers are radix keys");
+static_assert(dd::detail::is_radix_key<double>::value, "floating-point values are radix keys");
+static_assert(!dd::detail::is_radix_key<bool>::value, "bool is not a radix key");
+
+namespace {
+
+// Large enough to take the multithreaded path
+constexpr std::size_t parallel_size = dd::radix_sort_parallel_min + 12345;
+
+template <typename K> std::vector<K> random_keys(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<K> v(n);
+    for (auto &x : v) x = static_cast<K>(rng());
+    return v;
+}
+
+template <typename K> std::vector<K> sorted_copy(std::vector<K> v) {
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+template <typename K> void sort_keys(std::vector<K> &keys) {
+    std::vector<K> scratch(keys.size());
+    radix_sort(span<K>(keys), span<K>(scratch));
+}
+
+// Sorts keys with their original indices and checks the keys, the permutation and stability
+template <typename K> void check_by_key(thread_pool &pool, std::vector<K> keys) {
+    const std::vector<K> original = keys;
+    std::vector<std::uint32_t> index(keys.size());
+    for (std::size_t i = 0; i < index.size(); ++i) index[i] = static_cast<std::uint32_t>(i);
+    std::vector<K> key_scratch(keys.size());
+    std::vector<std::uint32_t> index_scratch(keys.size());
+    radix_sort_by_key(pool, span<K>(keys), span<std::uint32_t>(index), span<K>(key_scratch),
+                      span<std::uint32_t>(index_scratch));
+    REQUIRE(keys == sorted_copy(original));
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(original[index[i]] == keys[i]);
+        if (i > 0 && keys[i] == keys[i - 1]) REQUIRE(index[i - 1] < index[i]);
+    }
+}
+
+} // namespace
+
+TEST_CASE("radix_sort sorts integer keys", "[sort][radix]") {
+    SECTION("unsigned") {
+        auto keys = random_keys<std::uint32_t>(5000, 1);
+        const auto expected = sorted_copy(keys);
+        sort_keys(keys);
+        REQUIRE(keys == expected);
+    }
+    SECTION("64-bit unsigned") {
+        auto keys = random_keys<std::uint64_t>(5000, 2);
+        const auto expected = sorted_copy(keys);
+        sort_keys(keys);
+        REQUIRE(keys == expected);
+    }
+    SECTION("signed, including the extremes") {
+        auto keys = random_keys<std::int32_t>(5000, 3);
+        keys.push_back(std::numeric_limits<std::int32_t>::min());
+        keys.push_back(std::numeric_limits<std::int32_t>::max());
+        keys.push_back(0);
+        keys.push_back(-1);
+        const auto expected = sorted_copy(keys);
+        sort_keys(keys);
+        REQUIRE(keys == expected);
+    }
+    SECTION("narrow types") {
+        std::vector<std::int8_t> keys = {5, -3, 127, -128, 0, -1, 1, 5};
+        const auto expected = sorted_copy(keys);
+        sort_keys(keys);
+        REQUIRE(keys == expected);
+        std::vector<std::uint16_t> wide = {65535, 0, 256, 255, 1, 256};
+        const auto wide_expected = sorted_copy(wide);
+        sort_keys(wide);
+        REQUIRE(wide == wide_expected);
+    }
+    SECTION("keys that only use their low byte") {
+        std::vector<std::uint64_t> keys(1000);
+        for (std::size_t i = 0; i < keys.size(); ++i) keys[i] = (i * 37) % 251;
+        const auto expected = sorted_copy(keys);
+        sort_keys(keys);
+        REQUIRE(keys == expected);
+    }
+}
+
+TEST_CASE("radix_sort orders floating-point keys by sign and magnitude", "[sort][radix][float]") {
+    SECTION("float") {
+        std::vector<float> keys = {3.5f, -2.0f, 0.0f, -0.0f, 1e-30f, -1e30f, std::numeric_limits<float>::infinity(),
+                                   -std::numeric_limits<float>::infinity(), 2.0f, -2.0f};
+        sort_keys(keys);
+        REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+        // -0.0 sorts before +0.0
+        const auto zero = std::find(keys.begin(), keys.end(), 0.0f);
+        REQUIRE(std::signbit(*zero));
+        REQUIRE(!std::signbit(*(zero + 1)));
+        REQUIRE(keys.front() == -std::numeric_limits<float>::infinity());
+        REQUIRE(keys.back() == std::numeric_limits<float>::infinity());
+    }
+    SECTION("double") {
+        std::mt19937_64 rng(4);
+        std::normal_distribution<double> dist(0.0, 1e6);
+        std::vector<double> keys(5000);
+        for (auto &x : keys) x = dist(rng);
+        const auto expected = sorted_copy(keys);
+        sort_keys(keys);
+        REQUIRE(keys == expected);
+    }
+    SECTION("NaNs go to the end their sign bit points to") {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        std::vector<double> keys = {1.0, nan, -1.0, -nan, 0.0};
+        sort_keys(keys);
+        REQUIRE(std::isnan(keys.front()));
+        REQUIRE(std::signbit(keys.front()));
+        REQUIRE(std::isnan(keys.back()));
+        REQUIRE(!std::signbit(keys.back()));
+        REQUIRE(keys[1] == -1.0);
+        REQUIRE(keys[2] == 0.0);
+        REQUIRE(keys[3] == 1.0);
+    }
+}
+
+TEST_CASE("radix_sort handles trivial inputs", "[sort][radix]") {
+    std::vector<int> empty;
+    sort_keys(empty);
+    REQUIRE(empty.empty());
+
+    std::vector<int> one = {42};
+    sort_keys(one);
+    REQUIRE(one == std::vector<int>{42});
+
+    std::vector<std::uint32_t> same(100, 7u);
+    sort_keys(same);
+    REQUIRE(same == std::vector<std::uint32_t>(100, 7u));
+
+    // Scratch may be larger than the keys
+    std::vector<std::uint32_t> keys = {3, 1, 2};
+    std::vector<std::uint32_t> scratch(10);
+    radix_sort(span<std::uint32_t>(keys), span<std::uint32_t>(scratch));
+    REQUIRE(keys == (std::vector<std::uint32_t>{1, 2, 3}));
+}
+
+TEST_CASE("radix_sort_by_key is stable", "[sort][radix][by_key]") {
+    thread_pool pool(0);
+    SECTION("few distinct keys") {
+        std::vector<std::uint32_t> keys(3000);
+        for (std::size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<std::uint32_t>((i * 7919) % 13);
+        check_by_key(pool, keys);
+    }
+    SECTION("signed keys") {
+        auto keys = random_keys<std::int64_t>(3000, 5);
+        for (auto &k : keys) k %= 50;
+        check_by_key(pool, keys);
+    }
+    SECTION("float keys") {
+        std::vector<float> keys(3000);
+        for (std::size_t i = 0; i < keys.size(); ++i) keys[i] = static_cast<float>(static_cast<int>(i % 17) - 8) / 4;
+        check_by_key(pool, keys);
+    }
+    SECTION("non-trivial values") {
+        std::vector<int> keys = {2, 1, 2, 0};
+        std::vector<std::string> values = {"a", "b", "c", "d"};
+        std::vector<int> key_scratch(4);
+        std::vector<std::string> value_scratch(4);
+        radix_sort_by_key(span<int>(keys), span<std::string>(values), span<int>(key_scratch),
+                          span<std::string>(value_scratch));
+        REQUIRE(keys == (std::vector<int>{0, 1, 2, 2}));
+        REQUIRE(values == (std::vector<std::string>{"d", "b", "a", "c"}));
+    }
+}
+
+TEST_CASE("radix_sort runs tiles in parallel", "[sort][radix][parallel]") {
+    thread_pool pool(3);
+    SECTION("keys only") {
+        auto keys = random_keys<std::uint64_t>(parallel_size, 6);
+        const auto expected = sorted_copy(keys);
+        std::vector<std::uint64_t> scratch(keys.size());
+        radix_sort(pool, span<std::uint64_t>(keys), span<std::uint64_t>(scratch));
+        REQUIRE(keys == expected);
+    }
+    SECTION("floats") {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+        std::vector<float> keys(parallel_size);
+        for (auto &x : keys) x = dist(rng);
+        const auto expected = sorted_copy(keys);
+        std::vector<float> scratch(keys.size());
+        radix_sort(pool, span<float>(keys), span<float>(scratch));
+        REQUIRE(keys == expected);
+    }
+    SECTION("by key, stable across tiles") {
+        auto keys = random_keys<std::uint32_t>(parallel_size, 8);
+        for (auto &k : keys) k %= 1000;
+        check_by_key(pool, keys);
+    }
+}
+
+TEST_CASE("merge combines sorted spans", "[sort][merge]") {
+    const std::vector<int> a = {1, 3, 5, 7};
+    const std::vector<int> b = {2, 3, 4, 8, 9};
+    std::vector<int> out(12, -1);
+    const span<int> rest = merge(span<const int>(a), span<const int>(b), span<int>(out));
+    REQUIRE(rest.data() == out.data() + 9);
+    REQUIRE(rest.size() == 3);
+    REQUIRE(std::vector<int>(out.begin(), out.begin() + 9) == (std::vector<int>{1, 2, 3, 3, 4, 5, 7, 8, 9}));
+
+    SECTION("stable: ties take from the first span") {
+        struct item {
+            int key;
+            char tag;
+        };
+        const std::vector<item> x = {{1, 'a'}, {2, 'a'}};
+        const std::vector<item> y = {{1, 'b'}, {2, 'b'}};
+        std::vector<item> merged(4);
+        merge(span<const item>(x), span<const item>(y), span<item>(merged),
+              [](const item &l, const item &r) { return l.key < r.key; });
+        REQUIRE(merged[0].tag == 'a');
+        REQUIRE(merged[1].tag == 'b');
+        REQUIRE(merged[2].tag == 'a');
+        REQUIRE(merged[3].tag == 'b');
+    }
+    SECTION("one side empty") {
+        std::vector<int> only(4);
+        merge(span<const int>(), span<const int>(b.data(), 4), span<int>(only));
+        REQUIRE(only == (std::vector<int>{2, 3, 4, 8}));
+    }
+    SECTION("merging radix-sorted halves") {
+        auto keys = random_keys<std::uint32_t>(2000, 9);
+        std::vector<std::uint32_t> scratch(1000);
+        radix_sort(span<std::uint32_t>(keys.data(), 1000), span<std::uint32_t>(scratch));
+        radix_sort(span<std::uint32_t>(keys.data() + 1000, 1000), span<std::uint32_t>(scratch));
+        std::vector<std::uint32_t> merged(2000);
+        merge(span<const std::uint32_t>(keys.data(), 1000), span<const std::uint32_t>(keys.data() + 1000, 1000),
+              span<std::uint32_t>(merged));
+        REQUIRE(merged == sorted_copy(keys));
+    }
+}
+
+TEST_CASE("Contract checking: sort", "[sort][contract]") {
+    std::vector<int> keys(8), small(4), values(8), short_values(7);
+    REQUIRE_THROWS_AS(radix_sort(span<int>(keys), span<int>(small)), contract_violation_error);
+    REQUIRE_THROWS_AS(radix_sort_by_key(span<int>(keys), span<int>(short_values), span<int>(keys), span<int>(values)),
+                      contract_violation_error);
+    REQUIRE_THROWS_AS(radix_sort_by_key(span<int>(keys), span<int>(values), span<int>(small), span<int>(values)),
+                      contract_violation_error);
+    REQUIRE_THROWS_AS(merge(span<const int>(keys), span<const int>(values), span<int>(small)),
+                      contract_violation_error);
+}
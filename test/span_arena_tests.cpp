@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/span_arena.hpp"
+
+using dd::arena_scope;
+using dd::contract_violation_error;
+using dd::span;
+using dd::span_arena;
+
+// Compile-time assertions
+static_assert(!std::is_copy_constructible<span_arena>::value, "arenas are not copyable");
+static_assert(std::is_nothrow_move_constructible<span_arena>::value, "arenas are movable");
+static_assert(std::is_same<decltype(std::declval<span_arena &>().allocate<float>(4)), span<float>>::value,
+              "runtime sizes give dynamic spans");
+static_assert(std::is_same<decltype(std::declval<span_arena &>().allocate<float, 4>()), span<float, 4>>::value,
+              "static sizes give static spans");
+
+namespace {
+
+bool aligned_to(const void *p, std::size_t align) { return reinterpret_cast<std::uintptr_t>(p) % align == 0; }
+
+} // namespace
+
+TEST_CASE("span_arena allocation", "[span_arena][allocate]") {
+    span_arena arena(4096);
+    REQUIRE(arena.capacity() == 4096u);
+    REQUIRE(arena.used() == 0u);
+
+    span<float> a = arena.allocate<float>(10);
+    REQUIRE(a.size() == 10u);
+    REQUIRE(aligned_to(a.data(), alignof(float)));
+    for (std::size_t i = 0; i < a.size(); ++i) a[i] = static_cast<float>(i);
+
+    span<double> b = arena.allocate<double>(3, 64);
+    REQUIRE(aligned_to(b.data(), 64));
+    REQUIRE(reinterpret_cast<const unsigned char *>(b.data()) >= reinterpret_cast<const unsigned char *>(a.end()));
+
+    span<std::int32_t, 8> c = arena.allocate<std::int32_t, 8>();
+    span<char, 5> d = arena.allocate<char, 5, 32>();
+    REQUIRE(aligned_to(d.data(), 32));
+    c[7] = 7;
+    REQUIRE(a[9] == 9.0f);
+    REQUIRE(arena.used() + arena.remaining() == arena.capacity());
+
+    span<int> empty = arena.allocate<int>(0);
+    REQUIRE(empty.empty());
+
+    arena.reset();
+    REQUIRE(arena.used() == 0u);
+    REQUIRE(arena.allocate<float>(10).data() == a.data());
+}
+
+TEST_CASE("span_arena exhaustion", "[span_arena][capacity]") {
+    alignas(16) unsigned char buf[64];
+    span_arena arena{span<unsigned char>(buf)};
+    REQUIRE(arena.capacity() == 64u);
+    REQUIRE(arena.try_allocate<std::uint32_t>(16).size() == 16u);
+    REQUIRE(arena.remaining() == 0u);
+    span<char> none = arena.try_allocate<char>(1);
+    REQUIRE(none.data() == nullptr);
+    REQUIRE(none.empty());
+    REQUIRE(arena.try_allocate<char>(dd::dynamic_extent).data() == nullptr);
+    arena.reset();
+    REQUIRE(arena.try_allocate<unsigned char>(1).data() == buf);
+
+    // Zero elements always succeed, even from an arena without storage
+    span_arena empty;
+    REQUIRE(empty.allocate<int>(0).empty());
+    REQUIRE(empty.allocate<int, 0>().empty());
+    REQUIRE(arena.allocate<int>(0).empty());
+}
+
+TEST_CASE("span_arena markers and scopes", "[span_arena][scope]") {
+    span_arena arena(1024);
+    arena.allocate<int>(4);
+    const auto m = arena.mark();
+    arena.allocate<int>(100);
+    arena.rollback(m);
+    REQUIRE(arena.used() == m.offset);
+
+    {
+        arena_scope scope(arena);
+        arena.allocate<double>(10);
+        {
+            arena_scope inner(arena);
+            arena.allocate<double>(10);
+            REQUIRE(arena.used() > m.offset + 80);
+        }
+        REQUIRE(arena.used() >= m.offset + 80);
+        REQUIRE(arena.used() < m.offset + 160);
+    }
+    REQUIRE(arena.used() == m.offset);
+
+    {
+        arena_scope scope(arena);
+        arena.reset();
+    }
+    REQUIRE(arena.used() == 0u);
+
+    span_arena moved(std::move(arena));
+    REQUIRE(moved.capacity() == 1024u);
+    REQUIRE(arena.capacity() == 0u);
+}
+
+TEST_CASE("thread_span_arena is per thread", "[span_arena][thread]") {
+    span_arena *main_arena = &dd::thread_span_arena();
+    REQUIRE(main_arena->capacity() == DD_SPAN_THREAD_ARENA_BYTES);
+    span_arena *other = nullptr;
+    std::thread t([&] { other = &dd::thread_span_arena(); });
+    t.join();
+    REQUIRE(other != main_arena);
+
+    arena_scope scope(dd::thread_span_arena());
+    REQUIRE(dd::thread_span_arena().allocate<float>(256).size() == 256u);
+}
+
+TEST_CASE("Contract checking: span_arena", "[span_arena][contract]") {
+    span_arena arena(64);
+    REQUIRE_THROWS_AS(arena.allocate<char>(65), contract_violation_error);
+    REQUIRE_THROWS_AS((arena.allocate<char, 65>()), contract_violation_error);
+    REQUIRE_THROWS_AS(arena.allocate<float>(1, 2), contract_violation_error);
+    REQUIRE_THROWS_AS(arena.allocate<float>(1, 24), contract_violation_error);
+    const auto m = arena.mark();
+    arena.reset();
+    REQUIRE_THROWS_AS(arena.rollback(dd::arena_marker{1}), contract_violation_error);
+    REQUIRE_NOTHROW(arena.rollback(m));
+}
@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/span_list.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using dd::contract_violation_error;
+using dd::span;
+using dd::span_list;
+
+// Compile-time assertions
+static_assert(std::is_same<span_list<>::segment_type, span<const dd::byte>>::value, "byte lists by default");
+static_assert(std::is_copy_constructible<span_list<int>>::value, "span lists are copyable");
+
+namespace {
+
+std::vector<int> elements(const span_list<const int> &l) {
+    std::vector<int> out;
+    for (span<const int> s : l) out.insert(out.end(), s.begin(), s.end());
+    return out;
+}
+
+std::vector<int> iota_vector(std::size_t n, int first = 0) {
+    std::vector<int> v(n);
+    std::iota(v.begin(), v.end(), first);
+    return v;
+}
+
+} // namespace
+
+TEST_CASE("span_list keeps segments in order and skips empty ones", "[span_list][build]") {
+    const auto a = iota_vector(3), b = iota_vector(2, 10);
+    span_list<const int, 2> l;
+    REQUIRE(l.empty());
+    l.push_back(span<const int>(a));
+    l.push_back(span<const int>());
+    l.push_back(span<const int>(b));
+    REQUIRE(l.segment_count() == 2);
+    REQUIRE(l.size() == 5);
+    REQUIRE(l.size_bytes() == 5 * sizeof(int));
+    REQUIRE(l[3] == 10);
+    REQUIRE(l.segment(1).data() == b.data());
+
+    // Beyond the inline capacity the segments move to the heap, in order
+    const auto c = iota_vector(4, 20);
+    l.push_back(span<const int>(c));
+    l.push_back(span<const int>(a).first(1));
+    REQUIRE(l.segment_count() == 4);
+    REQUIRE(l.segments()[2].data() == c.data());
+    span_list<const int, 2> copy = l;
+    l.clear();
+    REQUIRE(l.segment_count() == 0);
+    REQUIRE(copy.size() == 10);
+    REQUIRE(copy[9] == 0);
+}
+
+TEST_CASE("subspan cuts across segment boundaries", "[span_list][subspan]") {
+    const auto a = iota_vector(4), b = iota_vector(3, 4), c = iota_vector(5, 7);
+    const span_list<const int> l{span<const int>(a), span<const int>(b), span<const int>(c)};
+    const std::vector<int> all = iota_vector(12);
+    for (std::size_t off = 0; off <= 12; ++off) {
+        for (std::size_t n = 0; off + n <= 12; ++n) {
+            const span_list<const int> part = l.subspan(off, n);
+            REQUIRE(part.size() == n);
+            REQUIRE(elements(part) == std::vector<int>(all.begin() + off, all.begin() + off + n));
+        }
+    }
+    REQUIRE(l.subspan(3, 5).segment_count() == 3);
+    REQUIRE(l.subspan(3, 5).segment(0).data() == a.data() + 3);
+    REQUIRE(elements(l.subspan(5)) == iota_vector(7, 5));
+    REQUIRE(elements(l.first(2)) == iota_vector(2));
+    REQUIRE(elements(l.last(6)) == iota_vector(6, 6));
+}
+
+TEST_CASE("copy_to gathers the segments", "[span_list][copy]") {
+    const auto a = iota_vector(4), b = iota_vector(3, 4);
+    const span_list<const int> l{span<const int>(a), span<const int>(b)};
+    std::vector<int> out(9, -1);
+    const span<int> rest = l.copy_to(span<int>(out));
+    REQUIRE(rest.size() == 2);
+    REQUIRE(rest.data() == out.data() + 7);
+    REQUIRE(out == std::vector<int>{0, 1, 2, 3, 4, 5, 6, -1, -1});
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+TEST_CASE("to_iovecs describes the segments in bytes", "[span_list][iovec]") {
+    const auto a = iota_vector(4), b = iota_vector(3);
+    const span_list<const int> l{span<const int>(a), span<const int>(b)};
+    struct iovec iov[4];
+    REQUIRE(l.to_iovecs(span<struct iovec>(iov, 4)) == 2);
+    REQUIRE(iov[0].iov_base == a.data());
+    REQUIRE(iov[0].iov_len == 4 * sizeof(int));
+    REQUIRE(iov[1].iov_len == 3 * sizeof(int));
+    REQUIRE(l.to_iovecs(span<struct iovec>(iov, 1), 1) == 1);
+    REQUIRE(iov[0].iov_base == b.data());
+}
+
+TEST_CASE("writev_all and readv_all move a message through a pipe", "[span_list][io]") {
+    // Larger than a pipe buffer and with more segments than one writev takes, so both sides see partial transfers
+    std::vector<unsigned char> source(300000);
+    for (std::size_t i = 0; i < source.size(); ++i) source[i] = static_cast<unsigned char>(i * 31 + 7);
+    span_list<> out;
+    for (std::size_t pos = 0; pos < source.size();) {
+        const std::size_t n = std::min<std::size_t>(source.size() - pos, 1 + (pos * 7) % 3000);
+        out.push_back(dd::as_bytes(span<const unsigned char>(source.data() + pos, n)));
+        pos += n;
+    }
+    REQUIRE(out.segment_count() > 64);
+
+    std::vector<unsigned char> received(source.size() + 10, 0);
+    span_list<dd::byte> in;
+    in.push_back(dd::as_writable_bytes(span<unsigned char>(received).first(5)));
+    in.push_back(dd::as_writable_bytes(span<unsigned char>(received).subspan(5)));
+
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    std::size_t written = 0;
+    std::thread writer([&] {
+        written = dd::writev_all(fds[1], out);
+        ::close(fds[1]);
+    });
+    const std::size_t read = dd::readv_all(fds[0], in);
+    writer.join();
+    ::close(fds[0]);
+    REQUIRE(written == source.size());
+    REQUIRE(read == source.size());
+    REQUIRE(std::equal(source.begin(), source.end(), received.begin()));
+}
+
+TEST_CASE("preadv_all reads from a file offset", "[span_list][io]") {
+    char name[] = "/tmp/dd_span_list_XXXXXX";
+    const int fd = ::mkstemp(name);
+    REQUIRE(fd >= 0);
+    const std::string text = "0123456789abcdefghij";
+    const span_list<const char> pieces{span<const char>(text.data(), 10), span<const char>(text.data() + 10, 10)};
+    REQUIRE(dd::writev_all(fd, pieces) == 20);
+
+    char head[3], tail[4];
+    const span_list<char> dst{span<char>(head, 3), span<char>(tail, 4)};
+    REQUIRE(dd::preadv_all(fd, dst, 8) == 7);
+    REQUIRE(std::string(head, 3) == "89a");
+    REQUIRE(std::string(tail, 4) == "bcde");
+    // Past the end of the file only the remaining bytes arrive
+    REQUIRE(dd::preadv_all(fd, dst, 16) == 4);
+    ::close(fd);
+    std::remove(name);
+}
+
+TEST_CASE("Vectored I/O reports errors", "[span_list][io]") {
+    const std::string text = "abc";
+    const span_list<const char> l{span<const char>(text.data(), text.size())};
+    std::error_code ec;
+    REQUIRE(dd::writev_all(-1, l, ec) == 0);
+    REQUIRE(ec == std::errc::bad_file_descriptor);
+    REQUIRE_THROWS_AS(dd::writev_all(-1, l), std::system_error);
+}
+
+#endif
+
+TEST_CASE("Contract checking: span_list", "[span_list][contract]") {
+    const auto a = iota_vector(4);
+    const span_list<const int> l{span<const int>(a)};
+    REQUIRE_THROWS_AS(l[4], contract_violation_error);
+    REQUIRE_THROWS_AS(l.segment(1), contract_violation_error);
+    REQUIRE_THROWS_AS(l.subspan(5), contract_violation_error);
+    REQUIRE_THROWS_AS(l.subspan(2, 3), contract_violation_error);
+    REQUIRE_THROWS_AS(l.last(5), contract_violation_error);
+    std::vector<int> small(3);
+    REQUIRE_THROWS_AS(l.copy_to(span<int>(small)), contract_violation_error);
+}
@@ -0,0 +1,227 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/sparse.hpp"
+
+using dd::contract_violation_error;
+using dd::coo_view;
+using dd::csr_view;
+using dd::span;
+using dd::thread_pool;
+
+// Compile-time assertions
+static_assert(std::is_trivially_copyable<csr_view<double>>::value, "csr views can be passed to kernels");
+static_assert(std::is_trivially_copyable<coo_view<float, std::int64_t>>::value, "coo views can be passed to kernels");
+static_assert(std::is_convertible<csr_view<double>, csr_view<const double>>::value, "adding const is implicit");
+static_assert(!std::is_convertible<csr_view<const double>, csr_view<double>>::value, "removing const is not");
+
+namespace {
+
+// [ 1 0 2 ]
+// [ 0 0 0 ]
+// [ 3 4 5 ]
+// [ 0 6 0 ]
+struct small_matrix {
+    std::vector<int> row_ptr = {0, 2, 2, 5, 6};
+    std::vector<int> col_idx = {0, 2, 0, 1, 2, 1};
+    std::vector<double> values = {1, 2, 3, 4, 5, 6};
+
+    csr_view<double> view() { return csr_view<double>(4, 3, row_ptr, col_idx, span<double>(values)); }
+};
+
+// Random matrix with a few very dense rows among short ones
+struct skewed_matrix {
+    std::size_t rows, cols;
+    std::vector<std::int32_t> row_ptr, col_idx;
+    std::vector<double> values;
+    std::vector<double> dense; // rows x cols, row-major
+
+    skewed_matrix(std::size_t r, std::size_t c, std::uint64_t seed) : rows(r), cols(c), dense(r * c, 0.0) {
+        std::mt19937_64 rng(seed);
+        row_ptr.push_back(0);
+        for (std::size_t i = 0; i < rows; ++i) {
+            const std::size_t len = i % 97 == 0 ? cols / 2 : rng() % 5;
+            for (std::size_t n = 0; n < len; ++n) {
+                const std::size_t j = rng() % cols;
+                const double v = static_cast<double>(rng() % 19) - 9;
+                col_idx.push_back(static_cast<std::int32_t>(j));
+                values.push_back(v);
+                dense[i * cols + j] += v;
+            }
+            row_ptr.push_back(static_cast<std::int32_t>(col_idx.size()));
+        }
+    }
+
+    csr_view<const double> view() const { return csr_view<const double>(rows, cols, row_ptr, col_idx, values); }
+
+    std::vector<double> times(const std::vector<double> &x) const {
+        std::vector<double> y(rows, 0.0);
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t j = 0; j < cols; ++j) y[i] += dense[i * cols + j] * x[j];
+        }
+        return y;
+    }
+};
+
+std::vector<double> ramp(std::size_t n) {
+    std::vector<double> v(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<double>(i % 7) - 3;
+    return v;
+}
+
+} // namespace
+
+TEST_CASE("csr_view exposes its structure", "[sparse][csr]") {
+    small_matrix m;
+    const auto a = m.view();
+    REQUIRE(a.rows() == 4);
+    REQUIRE(a.cols() == 3);
+    REQUIRE(a.nnz() == 6);
+    REQUIRE(a.size() == 4);
+    REQUIRE(a.row_ptr().data() == m.row_ptr.data());
+    REQUIRE(a.col_idx().data() == m.col_idx.data());
+    REQUIRE(a.values().data() == m.values.data());
+
+    SECTION("rows are sub-spans of the column and value arrays") {
+        const auto r2 = a.row(2);
+        REQUIRE(r2.size() == 3);
+        REQUIRE(r2.columns.data() == m.col_idx.data() + 2);
+        REQUIRE(r2.values.data() == m.values.data() + 2);
+        REQUIRE(a.row(1).empty());
+        REQUIRE(a.row_nnz(3) == 1);
+        REQUIRE(a[3].values[0] == 6);
+    }
+    SECTION("values can be written through a mutable view") {
+        a.row(0).values[1] = 20;
+        REQUIRE(m.values[1] == 20);
+    }
+    SECTION("iteration visits every row in order") {
+        std::size_t r = 0, total = 0;
+        for (auto row : a) {
+            REQUIRE(row.size() == a.row_nnz(r));
+            total += row.size();
+            ++r;
+        }
+        REQUIRE(r == 4);
+        REQUIRE(total == a.nnz());
+        REQUIRE(a.end() - a.begin() == 4);
+    }
+    SECTION("converts to a read-only view") {
+        const csr_view<const double> c = a;
+        REQUIRE(c.values().data() == m.values.data());
+        REQUIRE(c.nnz() == 6);
+    }
+    SECTION("an empty matrix has no rows") {
+        const std::vector<int> ptr = {0};
+        const csr_view<const float> e(0, 5, ptr, span<const int>(), span<const float>());
+        REQUIRE(e.empty());
+        REQUIRE(e.begin() == e.end());
+    }
+}
+
+TEST_CASE("spmv multiplies by a dense vector", "[sparse][spmv]") {
+    small_matrix m;
+    const std::vector<double> x = {1, 10, 100};
+    std::vector<double> y(4, -1);
+    dd::spmv(m.view(), span<const double>(x), span<double>(y));
+    REQUIRE(y == (std::vector<double>{201, 0, 543, 60}));
+
+    SECTION("skewed rows on several threads") {
+        thread_pool pool(3);
+        const skewed_matrix s(5000, 400, 1);
+        const auto xs = ramp(s.cols);
+        std::vector<double> ys(s.rows);
+        dd::spmv(pool, s.view(), span<const double>(xs), span<double>(ys));
+        REQUIRE(ys == s.times(xs));
+    }
+    SECTION("rows that are all empty") {
+        const std::vector<int> ptr(6, 0);
+        const csr_view<const double> z(5, 3, ptr, span<const int>(), span<const double>());
+        std::vector<double> yz(5, 7);
+        dd::spmv(z, span<const double>(x), span<double>(yz));
+        REQUIRE(yz == std::vector<double>(5, 0));
+    }
+}
+
+TEST_CASE("spmm multiplies by a dense matrix", "[sparse][spmm]") {
+    using matrix = dd::mdspan<double, dd::dextents<std::size_t, 2>>;
+    using const_matrix = dd::mdspan<const double, dd::dextents<std::size_t, 2>>;
+    thread_pool pool(2);
+    const skewed_matrix s(3000, 64, 2);
+    constexpr std::size_t k = 5;
+    std::vector<double> b(s.cols * k), c(s.rows * k, -1);
+    for (std::size_t i = 0; i < b.size(); ++i) b[i] = static_cast<double>(i % 11) - 5;
+    dd::spmm(pool, s.view(), const_matrix(b.data(), s.cols, k), matrix(c.data(), s.rows, k));
+    for (std::size_t j = 0; j < k; ++j) {
+        std::vector<double> column(s.cols);
+        for (std::size_t i = 0; i < s.cols; ++i) column[i] = b[i * k + j];
+        const auto expected = s.times(column);
+        for (std::size_t i = 0; i < s.rows; ++i) REQUIRE(c[i * k + j] == expected[i]);
+    }
+}
+
+TEST_CASE("coo_view and conversion to CSR", "[sparse][coo]") {
+    // The small matrix, entries shuffled, with (2, 2) split into two duplicates
+    const std::vector<int> rows = {2, 0, 3, 2, 0, 2, 2};
+    const std::vector<int> cols = {2, 2, 1, 0, 0, 1, 2};
+    const std::vector<double> vals = {4, 2, 6, 3, 1, 4, 1};
+    const coo_view<const double> a(4, 3, rows, cols, vals);
+    REQUIRE(a.rows() == 4);
+    REQUIRE(a.cols() == 3);
+    REQUIRE(a.nnz() == 7);
+    REQUIRE(a.row_idx().data() == rows.data());
+
+    const std::vector<double> x = {1, 10, 100};
+    std::vector<double> y(4, -1);
+    dd::spmv(a, span<const double>(x), span<double>(y));
+    REQUIRE(y == (std::vector<double>{201, 0, 543, 60}));
+
+    std::vector<int> row_ptr(5), col_idx(7);
+    std::vector<double> values(7);
+    const auto csr = dd::csr_from_coo(a, span<int>(row_ptr), span<int>(col_idx), span<double>(values));
+    REQUIRE(row_ptr == (std::vector<int>{0, 2, 2, 6, 7}));
+    // Entries keep their order within a row
+    REQUIRE(col_idx == (std::vector<int>{2, 0, 2, 0, 1, 2, 1}));
+    REQUIRE(values == (std::vector<double>{2, 1, 4, 3, 4, 1, 6}));
+    std::vector<double> yc(4);
+    dd::spmv(csr, span<const double>(x), span<double>(yc));
+    REQUIRE(yc == y);
+}
+
+TEST_CASE("Contract checking: sparse", "[sparse][contract]") {
+    small_matrix m;
+    auto make = [&](std::size_t rows, std::size_t cols) {
+        return csr_view<double>(rows, cols, m.row_ptr, m.col_idx, span<double>(m.values));
+    };
+    REQUIRE_NOTHROW(make(4, 3));
+    // row_ptr size does not match the row count
+    REQUIRE_THROWS_AS(make(3, 3), contract_violation_error);
+    // a column index is out of range
+    REQUIRE_THROWS_AS(make(4, 2), contract_violation_error);
+    // row_ptr decreases
+    m.row_ptr[1] = 3;
+    REQUIRE_THROWS_AS(make(4, 3), contract_violation_error);
+    m.row_ptr[1] = 2;
+    // row_ptr does not end at nnz
+    REQUIRE_THROWS_AS(csr_view<double>(4, 3, m.row_ptr, m.col_idx, span<double>(m.values.data(), 5)),
+                      contract_violation_error);
+    // negative index
+    m.col_idx[0] = -1;
+    REQUIRE_THROWS_AS(make(4, 3), contract_violation_error);
+    m.col_idx[0] = 0;
+
+    const auto a = make(4, 3);
+    REQUIRE_THROWS_AS(a.row(4), contract_violation_error);
+    std::vector<double> x(2), y(4);
+    REQUIRE_THROWS_AS(dd::spmv(a, span<const double>(x), span<double>(y)), contract_violation_error);
+
+    const std::vector<int> r = {0, 5}, c = {0, 0};
+    const std::vector<double> v = {1, 1};
+    REQUIRE_THROWS_AS(coo_view<const double>(4, 3, r, c, v), contract_violation_error);
+    REQUIRE_THROWS_AS(coo_view<const double>(6, 3, r, c, span<const double>(v.data(), 1)), contract_violation_error);
+}
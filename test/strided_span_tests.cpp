@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/strided_span.hpp"
+
+using dd::contract_violation_error;
+using dd::dynamic_extent;
+using dd::span;
+using dd::strided_span;
+
+namespace {
+struct particle {
+    float x, y, z;
+    int id;
+};
+} // namespace
+
+// Compile-time assertions
+static_assert(sizeof(strided_span<float, dynamic_extent, 16>) == sizeof(span<float>),
+              "static stride must take no storage");
+static_assert(sizeof(strided_span<float, 4, 16>) == sizeof(float *), "static extent and stride must be a bare pointer");
+static_assert(std::is_same<std::iterator_traits<strided_span<int>::iterator>::iterator_category,
+                           std::random_access_iterator_tag>::value,
+              "strided iterators must be random access");
+
+TEST_CASE("member_span over array of structs", "[strided_span][member]") {
+    std::vector<particle> ps(5);
+    for (int i = 0; i < 5; ++i) ps[i] = {float(i), float(10 * i), float(100 * i), i};
+    auto ys = dd::member_span(span<particle>(ps), &particle::y);
+    static_assert(std::is_same<decltype(ys), strided_span<float, dynamic_extent, sizeof(particle)>>::value, "");
+    REQUIRE(ys.size() == 5);
+    REQUIRE(ys.stride() == sizeof(particle));
+    REQUIRE(ys[3] == 30.0f);
+    REQUIRE(ys.front() == 0.0f);
+    REQUIRE(ys.back() == 40.0f);
+    ys[2] = -1.0f;
+    REQUIRE(ps[2].y == -1.0f);
+
+    const std::vector<particle> &cps = ps;
+    auto ids = dd::member_span(span<const particle>(cps), &particle::id);
+    static_assert(std::is_same<decltype(ids)::element_type, const int>::value, "");
+    REQUIRE(std::accumulate(ids.begin(), ids.end(), 0) == 10);
+    REQUIRE(dd::member_span(span<particle>(), &particle::x).empty());
+}
+
+TEST_CASE("stride_span columns of a row-major matrix", "[strided_span][stride]") {
+    std::vector<int> m(12); // 3 x 4
+    std::iota(m.begin(), m.end(), 0);
+    span<int> rows(m);
+    auto col1 = dd::stride_span(rows.subspan(1), 4);
+    REQUIRE(col1.size() == 3);
+    REQUIRE(col1[0] == 1);
+    REQUIRE(col1[1] == 5);
+    REQUIRE(col1[2] == 9);
+
+    std::array<int, 12> a{};
+    std::iota(a.begin(), a.end(), 0);
+    auto every3 = dd::stride_span<3>(span<int, 12>(a));
+    static_assert(std::is_same<decltype(every3), strided_span<int, 4, 3 * sizeof(int)>>::value, "");
+    REQUIRE(std::vector<int>(every3.begin(), every3.end()) == std::vector<int>{0, 3, 6, 9});
+}
+
+TEST_CASE("strided_span subviews keep the stride", "[strided_span][subspan]") {
+    int arr[10];
+    std::iota(arr, arr + 10, 0);
+    strided_span<int> s(arr, 5, 2 * sizeof(int)); // 0 2 4 6 8
+    auto f = s.first<2>();
+    static_assert(std::is_same<decltype(f), strided_span<int, 2>>::value, "");
+    REQUIRE(f[1] == 2);
+    auto l = s.last(2);
+    REQUIRE(l[0] == 6);
+    REQUIRE(l.stride() == s.stride());
+    auto sub = s.subspan<1, 3>();
+    REQUIRE(sub.size() == 3);
+    REQUIRE(sub[2] == 6);
+    REQUIRE(s.subspan(4)[0] == 8);
+}
+
+TEST_CASE("strided_span iterators", "[strided_span][iter]") {
+    int arr[9];
+    std::iota(arr, arr + 9, 0);
+    strided_span<int, dynamic_extent, 3 * sizeof(int)> s(arr, 3); // 0 3 6
+    REQUIRE(s.end() - s.begin() == 3);
+    REQUIRE(s.begin()[2] == 6);
+    REQUIRE(*(s.end() - 1) == 6);
+    REQUIRE(std::vector<int>(s.rbegin(), s.rend()) == std::vector<int>{6, 3, 0});
+    std::sort(s.begin(), s.end(), [](int a, int b) { return a > b; });
+    REQUIRE(arr[0] == 6);
+    REQUIRE(arr[6] == 0);
+
+    strided_span<const int> cs = s;
+    REQUIRE(cs.stride() == 3 * sizeof(int));
+    strided_span<const int> from_span = span<int>(arr, 9);
+    REQUIRE(from_span.stride() == sizeof(int));
+    REQUIRE(from_span[4] == 4);
+}
+
+TEST_CASE("Contract checking: strided_span", "[strided_span][contract]") {
+    int arr[8] = {};
+    strided_span<int> s(arr, 4, 2 * sizeof(int));
+    REQUIRE_THROWS_AS(s[4], contract_violation_error);
+    REQUIRE_THROWS_AS(s.first(5), contract_violation_error);
+    REQUIRE_THROWS_AS(s.subspan(2, 3), contract_violation_error);
+    REQUIRE_THROWS_AS((strided_span<int>(arr, 4, 3)), contract_violation_error);
+    REQUIRE_THROWS_AS((strided_span<int, 3>(arr, 4, sizeof(int))), contract_violation_error);
+    REQUIRE_THROWS_AS(dd::stride_span(span<int>(arr), 0), contract_violation_error);
+    strided_span<int> e;
+    REQUIRE_THROWS_AS(e.front(), contract_violation_error);
+}
@@ -0,0 +1,83 @@
+#include <catch2/catch_test_macros.hpp>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#define DD_SPAN_THROW_ON_CONTRACT_VIOLATION
+#include "dd/zip_span.hpp"
+
+using dd::contract_violation_error;
+using dd::span;
+using dd::zip_span;
+
+// Compile-time assertions
+static_assert(std::tuple_size<dd::zip_reference<int, const float>>::value == 2, "tuple_size mismatch");
+static_assert(std::is_same<std::tuple_element<1, dd::zip_reference<int, const float>>::type, const float &>::value,
+              "tuple_element mismatch");
+static_assert(sizeof(zip_span<float, float, float>) == 3 * sizeof(float *) + sizeof(std::size_t),
+              "zip_span must be one pointer per member plus a single size");
+
+TEST_CASE("zip_span construction and indexing", "[zip_span][ctor]") {
+    std::vector<float> x{1, 2, 3, 4};
+    std::vector<float> y{10, 20, 30, 40};
+    std::vector<int> id{7, 8, 9, 10};
+    zip_span<float, float, const int> z(x, y, id);
+    REQUIRE(z.size() == 4);
+    REQUIRE(!z.empty());
+    REQUIRE(dd::get<0>(z[1]) == 2);
+    REQUIRE(z[2].get<1>() == 30);
+    REQUIRE(dd::get<2>(z[3]) == 10);
+    dd::get<1>(z[0]) = -5;
+    REQUIRE(y[0] == -5);
+    REQUIRE(z.member<2>().data() == id.data());
+    std::tuple<float, float, int> copy = z[3];
+    REQUIRE(std::get<2>(copy) == 10);
+}
+
+TEST_CASE("zip_span lockstep iteration", "[zip_span][iter]") {
+    std::vector<double> a(8), b(8), c(8, 0.0);
+    std::iota(a.begin(), a.end(), 0.0);
+    std::iota(b.begin(), b.end(), 100.0);
+    auto z = dd::make_zip_span(span<const double>(a), span<const double>(b), span<double>(c));
+    for (auto &&[ai, bi, ci] : z) ci = ai + bi;
+    for (std::size_t i = 0; i < c.size(); ++i) REQUIRE(c[i] == a[i] + b[i]);
+    REQUIRE(z.end() - z.begin() == 8);
+    REQUIRE(dd::get<0>(*z.rbegin()) == 7.0);
+}
+
+TEST_CASE("zip_span subviews", "[zip_span][subspan]") {
+    int a[6] = {0, 1, 2, 3, 4, 5};
+    int b[6] = {5, 4, 3, 2, 1, 0};
+    zip_span<int, int> z(a, b);
+    auto f = z.first(2);
+    REQUIRE(f.size() == 2);
+    REQUIRE(dd::get<1>(f[1]) == 4);
+    auto l = z.last(2);
+    REQUIRE(dd::get<0>(l[0]) == 4);
+    auto s = z.subspan(1, 3);
+    REQUIRE(s.size() == 3);
+    REQUIRE(dd::get<0>(s[0]) == 1);
+    REQUIRE(dd::get<1>(s[2]) == 2);
+    REQUIRE(z.subspan(6).empty());
+}
+
+#ifdef DD_SPAN_HAVE_DEDUCTION_GUIDES
+TEST_CASE("zip_span deduction", "[zip_span][deduction]") {
+    float x[3] = {};
+    const int id[3] = {};
+    auto z = zip_span(span<float>(x), span<const int, 3>(id));
+    static_assert(std::is_same_v<decltype(z), zip_span<float, const int>>);
+    REQUIRE(z.size() == 3);
+}
+#endif
+
+TEST_CASE("Contract checking: zip_span", "[zip_span][contract]") {
+    std::vector<int> a(4), b(5);
+    REQUIRE_THROWS_AS((zip_span<int, int>(a, b)), contract_violation_error);
+    zip_span<int, int> z(a, span<int>(b).first(4));
+    REQUIRE_THROWS_AS(z[4], contract_violation_error);
+    REQUIRE_THROWS_AS(z.first(5), contract_violation_error);
+    REQUIRE_THROWS_AS(z.last(5), contract_violation_error);
+    REQUIRE_THROWS_AS(z.subspan(3, 2), contract_violation_error);
+}